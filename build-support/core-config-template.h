@@ -6,6 +6,7 @@
 #cmakedefine INT64X64_USE_128
 #cmakedefine INT64X64_USE_DOUBLE
 #cmakedefine INT64X64_USE_CAIRO
+#cmakedefine NS3_TIME_RESOLUTION @NS3_TIME_RESOLUTION@
 #cmakedefine01 HAVE_STDINT_H
 #cmakedefine01 HAVE_INTTYPES_H
 #cmakedefine HAVE_SYS_INT_TYPES_H
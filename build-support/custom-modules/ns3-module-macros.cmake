@@ -93,6 +93,34 @@ function(build_lib)
 
   add_library(ns3::${lib${BLIB_LIBNAME}} ALIAS ${lib${BLIB_LIBNAME}})
 
+  # Compile out the logs above the level of this module
+  set(log_level ${NS3_LOG_LEVEL})
+  set(log_level_define)
+  if(DEFINED NS3_LOG_LEVEL_${BLIB_LIBNAME})
+    set(log_level ${NS3_LOG_LEVEL_${BLIB_LIBNAME}})
+  endif()
+  if(NOT "${log_level}" STREQUAL "")
+    string(TOUPPER ${log_level} log_level)
+    set(valid_log_levels ERROR WARN DEBUG INFO FUNCTION LOGIC ALL NONE)
+    if(NOT (log_level IN_LIST valid_log_levels))
+      message(FATAL_ERROR "Invalid log level ${log_level} for ${BLIB_LIBNAME}")
+    endif()
+    if(${log_level} STREQUAL "NONE")
+      set(log_level_define NS3_LOG_STATIC_LEVEL=LOG_NONE)
+    else()
+      set(log_level_define NS3_LOG_STATIC_LEVEL=LOG_LEVEL_${log_level})
+    endif()
+    if(NOT ${XCODE})
+      target_compile_definitions(
+        ${lib${BLIB_LIBNAME}-obj} PRIVATE ${log_level_define}
+      )
+    else()
+      target_compile_definitions(
+        ${lib${BLIB_LIBNAME}} PRIVATE ${log_level_define}
+      )
+    endif()
+  endif()
+
   # Associate public headers with library for installation purposes
   if("${BLIB_LIBNAME}" STREQUAL "core")
     set(config_headers ${CMAKE_HEADER_OUTPUT_DIRECTORY}/config-store-config.h
@@ -324,6 +352,7 @@ function(build_lib)
       endif()
       target_compile_definitions(
         ${test${BLIB_LIBNAME}} PRIVATE NS_TEST_SOURCEDIR="${FOLDER}/test"
+                                       ${log_level_define}
       )
       if(${PRECOMPILE_HEADERS_ENABLED} AND (NOT ${BLIB_IGNORE_PCH}))
         target_precompile_headers(${test${BLIB_LIBNAME}} REUSE_FROM stdlib_pch)
@@ -23,6 +23,13 @@ add_definitions(-DPROJECT_SOURCE_PATH="${PROJECT_SOURCE_DIR}")
 set(NS3_INT64X64 "INT128" CACHE STRING "Int64x64 implementation")
 set_property(CACHE NS3_INT64X64 PROPERTY STRINGS INT128 CAIRO DOUBLE)
 
+# Empty to let Time::SetResolution change the time resolution at run time, or
+# a unit (e.g. NS) to fix it at build time
+set(NS3_TIME_RESOLUTION "" CACHE STRING "Time resolution fixed at build time")
+set_property(
+  CACHE NS3_TIME_RESOLUTION PROPERTY STRINGS "" Y D H MIN S MS US NS PS FS
+)
+
 # Purposefully hidden options:
 
 # for ease of use, export all libraries and include directories to ns-3 module
@@ -590,6 +597,10 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  if(${NS3_ATOMIC_REFCOUNT})
+    add_definitions(-DNS3_ATOMIC_REFCOUNT)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -1259,6 +1270,15 @@ macro(process_options)
   check_include_file("netpacket/packet.h" "HAVE_PACKETH")
   check_function_exists("getenv" "HAVE_GETENV")
 
+  # Time resolution fixed at build time
+  if(NOT "${NS3_TIME_RESOLUTION}" STREQUAL "")
+    string(TOUPPER ${NS3_TIME_RESOLUTION} NS3_TIME_RESOLUTION)
+    set(valid_time_resolutions Y D H MIN S MS US NS PS FS)
+    if(NOT (NS3_TIME_RESOLUTION IN_LIST valid_time_resolutions))
+      message(FATAL_ERROR "Invalid time resolution ${NS3_TIME_RESOLUTION}")
+    endif()
+  endif()
+
   configure_file(
     build-support/core-config-template.h
     ${CMAKE_HEADER_OUTPUT_DIRECTORY}/core-config.h
@@ -59,6 +59,7 @@
 // Packets in this simulation belong to BestEffort Access Class (AC_BE).
 // By selecting an acknowledgment sequence for DL MU PPDUs, it is possible to aggregate a
 // Round Robin scheduler to the AP, so that DL MU PPDUs are sent by the AP via DL OFDMA.
+// A Proportional Fair scheduler can be aggregated to the AP instead of the Round Robin one.
 
 using namespace ns3;
 
@@ -74,6 +75,7 @@ int main (int argc, char *argv[])
   double frequency {5}; //whether 2.4, 5 or 6 GHz
   std::size_t nStations {1};
   std::string dlAckSeqType {"NO-OFDMA"};
+  std::string muSchedulerType {"RR"};
   int mcs {-1}; // -1 indicates an unset value
   uint32_t payloadSize = 700; // must fit in the max TX duration when transmitting at MCS 0 over an RU of 26 tones
   std::string phyModel {"Yans"};
@@ -90,6 +92,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("nStations", "Number of non-AP HE stations", nStations);
   cmd.AddValue ("dlAckType", "Ack sequence type for DL OFDMA (NO-OFDMA, ACK-SU-FORMAT, MU-BAR, AGGR-MU-BAR)",
                 dlAckSeqType);
+  cmd.AddValue ("muScheduler", "Multi-user scheduler used for DL OFDMA (RR or PF)", muSchedulerType);
   cmd.AddValue ("mcs", "if set, limit testing to a specific MCS (0-11)", mcs);
   cmd.AddValue ("payloadSize", "The application payload size in bytes", payloadSize);
   cmd.AddValue ("phyModel", "PHY model to use when OFDMA is disabled (Yans or Spectrum). If OFDMA is enabled then Spectrum is automatically selected", phyModel);
@@ -122,6 +125,11 @@ int main (int argc, char *argv[])
       NS_ABORT_MSG ("Invalid DL ack sequence type (must be NO-OFDMA, ACK-SU-FORMAT, MU-BAR or AGGR-MU-BAR)");
     }
 
+  if (muSchedulerType != "RR" && muSchedulerType != "PF")
+    {
+      NS_ABORT_MSG ("Invalid multi-user scheduler (must be RR or PF)");
+    }
+
   if (phyModel != "Yans" && phyModel != "Spectrum")
     {
       NS_ABORT_MSG ("Invalid PHY model (must be Yans or Spectrum)");
@@ -213,12 +221,16 @@ int main (int argc, char *argv[])
                   phy.Set ("ChannelWidth", UintegerValue (channelWidth));
                   staDevices = wifi.Install (phy, mac, wifiStaNodes);
 
-                  if (dlAckSeqType != "NO-OFDMA")
+                  if (dlAckSeqType != "NO-OFDMA" && muSchedulerType == "RR")
                     {
                       mac.SetMultiUserScheduler ("ns3::RrMultiUserScheduler",
                                                 "EnableUlOfdma", BooleanValue (false),
                                                 "EnableBsrp", BooleanValue (false));
                     }
+                  else if (dlAckSeqType != "NO-OFDMA")
+                    {
+                      mac.SetMultiUserScheduler ("ns3::PfMultiUserScheduler");
+                    }
                   mac.SetType ("ns3::ApWifiMac",
                               "EnableBeaconJitter", BooleanValue (false),
                               "Ssid", SsidValue (ssid));
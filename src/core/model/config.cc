@@ -26,7 +26,10 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
+#include <utility>
 
 /**
  * \file
@@ -294,6 +297,130 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * Split a Config path into its elements, as if it started and ended
+ * with a '/'.
+ *
+ * \param [in] path The Config path.
+ * \param [out] tokens The elements of the path.
+ */
+static void
+SplitPath (std::string path, std::vector<std::string> *tokens)
+{
+  NS_LOG_FUNCTION (path << tokens);
+  std::string::size_type start = (path.find ("/") == 0) ? 1 : 0;
+  while (start < path.size ())
+    {
+      std::string::size_type next = path.find ("/", start);
+      if (next == std::string::npos)
+        {
+          next = path.size ();
+        }
+      tokens->push_back (path.substr (start, next - start));
+      start = next + 1;
+    }
+}
+
+Path::Path (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+  std::string::size_type slash = path.find_last_of ("/");
+  NS_ASSERT (slash != std::string::npos);
+  m_root = path.substr (0, slash);
+  m_leaf = path.substr (slash + 1, path.size () - (slash + 1));
+  SplitPath (m_root, &m_tokens);
+}
+std::string
+Path::GetPath (void) const
+{
+  return m_path;
+}
+std::string
+Path::GetRoot (void) const
+{
+  return m_root;
+}
+std::string
+Path::GetLeaf (void) const
+{
+  return m_leaf;
+}
+std::size_t
+Path::GetTokenN (void) const
+{
+  return m_tokens.size ();
+}
+std::string
+Path::GetToken (std::size_t i) const
+{
+  return m_tokens[i];
+}
+
+/**
+ * \ingroup config-impl
+ * An element of the Config paths resolved together.  The elements
+ * form a tree, whose root is the '/' starting all the paths: the
+ * children of an element are the elements which follow it in the
+ * paths, so the paths starting with the same elements share the
+ * walk of their objects.
+ */
+class PathToken : public SimpleRefCount<PathToken>
+{
+public:
+  /**
+   * Parse an element of a Config path.
+   *
+   * \param [in] item The element.
+   */
+  PathToken (std::string item);
+  /**
+   * Get the child element of the paths, adding it if needed.
+   *
+   * \param [in] item The child element.
+   * \returns The child.
+   */
+  Ptr<PathToken> GetChild (std::string item);
+
+  std::string m_item;                       //!< The element.
+  bool m_names;                             //!< Whether the element may start a "/Names" path.
+  bool m_getObject;                         //!< Whether the element is a "$" GetObject call.
+  bool m_tidFound;                          //!< Whether the TypeId of the GetObject call exists.
+  TypeId m_tid;                             //!< The TypeId of the GetObject call.
+  ArrayMatcher m_matcher;                   //!< The matcher of the element as an index.
+  std::vector<Ptr<PathToken> > m_children;  //!< The elements following this one.
+  std::vector<std::size_t> m_paths;         //!< The paths ending with this element.
+};
+
+PathToken::PathToken (std::string item)
+  : m_item (item),
+    m_names (item.find ("Names") == 0),
+    m_getObject (item.find ("$") == 0),
+    m_tidFound (false),
+    m_matcher (item)
+{
+  if (m_getObject)
+    {
+      m_tidFound = TypeId::LookupByNameFailSafe (item.substr (1, item.size () - 1), &m_tid);
+    }
+}
+
+Ptr<PathToken>
+PathToken::GetChild (std::string item)
+{
+  for (std::vector<Ptr<PathToken> >::const_iterator i = m_children.begin (); i != m_children.end (); i++)
+    {
+      if ((*i)->m_item == item)
+        {
+          return *i;
+        }
+    }
+  Ptr<PathToken> child = Create<PathToken> (item);
+  m_children.push_back (child);
+  return child;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -302,16 +429,16 @@ class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from the tree of the Config paths to resolve.
    *
-   * \param [in] path The Config path.
+   * \param [in] tree The '/' starting all the Config paths.
    */
-  Resolver (std::string path);
+  Resolver (Ptr<const PathToken> tree);
   /** Destructor. */
   virtual ~Resolver ();
 
   /**
-   * Parse the stored Config path into an object reference,
+   * Parse the stored Config paths into object references,
    * beginning at the indicated root object.
    *
    * \param [in] root The object corresponding to the current position in
@@ -320,29 +447,74 @@ public:
   void Resolve (Ptr<Object> root);
 
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
+  /** An attribute holding objects, matched by an element of a path. */
+  struct ObjectAttribute
+  {
+    std::string name;                          //!< The attribute name.
+    bool pointer;                              //!< Whether the attribute is a pointer or a container.
+    struct TypeId::AttributeInformation info;  //!< The attribute, as looked up by name.
+  };
+  /** The attributes matched by an element on a TypeId. */
+  typedef std::vector<struct ObjectAttribute> ObjectAttributes;
+
+  /**
+   * Get the pointer and container attributes of a TypeId matching an
+   * element of a path.  The attributes are looked up once for each
+   * TypeId and element, and cached.
+   *
+   * \param [in] tid The TypeId of the object.
+   * \param [in] item The element of the path.
+   * \returns The matching attributes.
+   */
+  static const ObjectAttributes & GetObjectAttributes (TypeId tid, std::string item);
+  /**
+   * Get the value of an attribute matched by an element.
+   *
+   * \param [in] object The object.
+   * \param [in] attribute The attribute.
+   * \param [out] value The value.
+   */
+  static void GetAttribute (Ptr<Object> object, const struct ObjectAttribute &attribute,
+                            AttributeValue &value);
+  /**
+   * Parse the elements following a Config path element.
+   *
+   * \param [in] token The current element of the Config paths.
+   * \param [in] root The object corresponding to the current position
+   *                  in the Config path.
+   */
+  void DoResolve (Ptr<const PathToken> token, Ptr<Object> root);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] token The next element of the Config paths.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolveToken (Ptr<const PathToken> token, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] token The current element of the Config paths,
+   *                   whose children are the indices.
+   * \param [in,out] container The resulting list of matching objects.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (Ptr<const PathToken> token, const ObjectPtrContainerValue &container);
   /**
    * Handle one object found on the path.
    *
+   * \param [in] token The last element of the Config paths.
    * \param [in] object The current object on the Config path.
    */
-  void DoResolveOne (Ptr<Object> object);
+  void DoResolveOne (Ptr<const PathToken> token, Ptr<Object> object);
+  /**
+   * Append an element to the current Config path.
+   *
+   * \param [in] item The element.
+   */
+  void Push (std::string item);
+  /** Remove the last element of the current Config path. */
+  void Pop (void);
   /**
    * Get the current Config path.
    *
@@ -354,84 +526,142 @@ private:
    *
    * \param [in] object The found object.
    * \param [in] path The matching Config path context.
+   * \param [in] paths The indices of the Config paths matching the object.
    */
-  virtual void DoOne (Ptr<Object> object, std::string path) = 0;
+  virtual void DoOne (Ptr<Object> object, std::string path,
+                      const std::vector<std::size_t> &paths) = 0;
 
-  /** Current list of path tokens. */
-  std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The tree of the Config paths. */
+  Ptr<const PathToken> m_tree;
+  /** The current Config path. */
+  std::string m_resolvedPath;
+  /** The length of the current Config path before each element. */
+  std::vector<std::string::size_type> m_workStack;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (Ptr<const PathToken> tree)
+  : m_tree (tree),
+    m_resolvedPath ("/")
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << tree);
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
+
 void
-Resolver::Canonicalize (void)
+Resolver::Resolve (Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << root);
+
+  DoResolve (m_tree, root);
+}
 
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
+const Resolver::ObjectAttributes &
+Resolver::GetObjectAttributes (TypeId tid, std::string item)
+{
+  NS_LOG_FUNCTION (tid << item);
+  static std::map<std::pair<uint16_t, std::string>, ObjectAttributes> cache;
+  std::pair<uint16_t, std::string> key = std::make_pair (tid.GetUid (), item);
+  std::map<std::pair<uint16_t, std::string>, ObjectAttributes>::const_iterator it = cache.find (key);
+  if (it != cache.end ())
     {
-      // no slash at start
-      m_path = "/" + m_path;
+      return it->second;
     }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
+
+  ObjectAttributes &attributes = cache[key];
+  TypeId nextTid = tid;
+  TypeId current;
+  do
     {
-      // no slash at end
-      m_path = m_path + "/";
+      current = nextTid;
+      for (std::size_t i = 0; i < current.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = current.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          struct ObjectAttribute attribute;
+          attribute.name = info.name;
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.pointer = true;
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.pointer = false;
+            }
+          else
+            {
+              // this could be anything else and we don't know what to do with it.
+              // So, we just ignore it.
+              continue;
+            }
+          // the value is read as ObjectBase::GetAttribute would do, from
+          // the attribute of the most derived TypeId with this name.
+          tid.LookupAttributeByName (info.name, &attribute.info);
+          attributes.push_back (attribute);
+        }
+      nextTid = current.GetParent ();
     }
+  while (nextTid != current);
+  return attributes;
 }
 
 void
-Resolver::Resolve (Ptr<Object> root)
+Resolver::GetAttribute (Ptr<Object> object, const struct ObjectAttribute &attribute,
+                        AttributeValue &value)
 {
-  NS_LOG_FUNCTION (this << root);
+  if ((attribute.info.flags & TypeId::ATTR_GET)
+      && attribute.info.accessor->HasGetter ()
+      && attribute.info.accessor->Get (PeekPointer (object), value))
+    {
+      return;
+    }
+  // let ObjectBase::GetAttribute raise the errors
+  object->GetAttribute (attribute.name, value);
+}
 
-  DoResolve (m_path, root);
+void
+Resolver::Push (std::string item)
+{
+  m_workStack.push_back (m_resolvedPath.size ());
+  m_resolvedPath += item;
+  m_resolvedPath += "/";
+}
+
+void
+Resolver::Pop (void)
+{
+  m_resolvedPath.resize (m_workStack.back ());
+  m_workStack.pop_back ();
 }
 
 std::string
 Resolver::GetResolvedPath (void) const
 {
   NS_LOG_FUNCTION (this);
-
-  std::string fullPath = "/";
-  for (std::vector<std::string>::const_iterator i = m_workStack.begin (); i != m_workStack.end (); i++)
-    {
-      fullPath += *i + "/";
-    }
-  return fullPath;
+  return m_resolvedPath;
 }
 
 void
-Resolver::DoResolveOne (Ptr<Object> object)
+Resolver::DoResolveOne (Ptr<const PathToken> token, Ptr<Object> object)
 {
-  NS_LOG_FUNCTION (this << object);
+  NS_LOG_FUNCTION (this << token << object);
 
   NS_LOG_DEBUG ("resolved=" << GetResolvedPath ());
-  DoOne (object, GetResolvedPath ());
+  DoOne (object, GetResolvedPath (), token->m_paths);
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (Ptr<const PathToken> token, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << token << root);
 
-  if (next == std::string::npos)
+  if (!token->m_paths.empty ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -443,12 +673,21 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
       //
       if (root)
         {
-          DoResolveOne (root);
+          DoResolveOne (token, root);
         }
-      return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  for (std::vector<Ptr<PathToken> >::const_iterator i = token->m_children.begin ();
+       i != token->m_children.end (); i++)
+    {
+      DoResolveToken (*i, root);
+    }
+}
+
+void
+Resolver::DoResolveToken (Ptr<const PathToken> token, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << token << root);
+  const std::string &item = token->m_item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -457,16 +696,12 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   // the root of the "/Names" namespace, so we just ignore it and move on to
   // the next segment.
   //
-  if (root == 0)
+  if (root == 0 && token->m_names)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
-        {
-          m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
-          m_workStack.pop_back ();
-          return;
-        }
+      Push (item);
+      DoResolve (token, root);
+      Pop ();
+      return;
     }
 
   //
@@ -479,9 +714,9 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   if (namedObject)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
-      m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
-      m_workStack.pop_back ();
+      Push (item);
+      DoResolve (token, namedObject);
+      Pop ();
       return;
     }
 
@@ -496,82 +731,60 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (token->m_getObject)
     {
       // This is a call to GetObject
       std::string tidString = item.substr (1, item.size () - 1);
       NS_LOG_DEBUG ("GetObject=" << tidString << " on path=" << GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
+      // an unknown TypeId is a fatal error, as when it is looked up here
+      TypeId tid = token->m_tidFound ? token->m_tid : TypeId::LookupByName (tidString);
       Ptr<Object> object = root->GetObject<Object> (tid);
       if (object == 0)
         {
           NS_LOG_DEBUG ("GetObject (" << tidString << ") failed on path=" << GetResolvedPath ());
           return;
         }
-      m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
-      m_workStack.pop_back ();
+      Push (item);
+      DoResolve (token, object);
+      Pop ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
+      const ObjectAttributes &attributes = GetObjectAttributes (root->GetInstanceTypeId (), item);
       bool foundMatch = false;
 
-      do
+      for (ObjectAttributes::const_iterator i = attributes.begin (); i != attributes.end (); i++)
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          if (i->pointer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              GetAttribute (root, *i, pValue);
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              Push (i->name);
+              DoResolve (token, object);
+              Pop ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              foundMatch = true;
+              ObjectPtrContainerValue vector;
+              GetAttribute (root, *i, vector);
+              Push (i->name);
+              DoArrayResolve (token, vector);
+              Pop ();
             }
-
-          nextTid = tid.GetParent ();
         }
-      while (nextTid != tid);
 
       if (!foundMatch)
         {
@@ -582,30 +795,33 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (Ptr<const PathToken> token, const ObjectPtrContainerValue &container)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << token << &container);
+  if (token->m_children.empty ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
 
-  ArrayMatcher matcher = ArrayMatcher (item);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
-      if (matcher.Matches ((*it).first))
+      std::string index;
+      for (std::vector<Ptr<PathToken> >::const_iterator i = token->m_children.begin ();
+           i != token->m_children.end (); i++)
         {
-          std::ostringstream oss;
-          oss << (*it).first;
-          m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
-          m_workStack.pop_back ();
+          if ((*i)->m_matcher.Matches ((*it).first))
+            {
+              if (index.empty ())
+                {
+                  std::ostringstream oss;
+                  oss << (*it).first;
+                  index = oss.str ();
+                }
+              Push (index);
+              DoResolve (*i, (*it).second);
+              Pop ();
+            }
         }
     }
 }
@@ -620,20 +836,28 @@ public:
   // Keep Set and SetFailSafe since their errors are triggered
   // by the underlying ObjecBase functions.
   /** \copydoc Config::Set() */
-  void Set (std::string path, const AttributeValue &value);
+  void Set (const Path &path, const AttributeValue &value);
   /** \copydoc Config::SetFailSafe() */
-  bool SetFailSafe (std::string path, const AttributeValue &value);
+  bool SetFailSafe (const Path &path, const AttributeValue &value);
   /** \copydoc Config::ConnectWithoutContextFailSafe() */
-  bool ConnectWithoutContextFailSafe (std::string path, const CallbackBase &cb);
+  bool ConnectWithoutContextFailSafe (const Path &path, const CallbackBase &cb);
   /** \copydoc Config::ConnectFailSafe() */
-  bool ConnectFailSafe (std::string path, const CallbackBase &cb);
+  bool ConnectFailSafe (const Path &path, const CallbackBase &cb);
   /** \copydoc Config::DisconnectWithoutContext() */
-  void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
+  void DisconnectWithoutContext (const Path &path, const CallbackBase &cb);
   /** \copydoc Config::Disconnect() */
-  void Disconnect (std::string path, const CallbackBase &cb);
+  void Disconnect (const Path &path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
 
+  /**
+   * Resolve Config paths from every root namespace object, and from the
+   * root of the object name service.
+   *
+   * \param [in] resolver The resolver of the Config paths.
+   */
+  void Resolve (Resolver &resolver) const;
+
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
   /** \copydoc Config::UnregisterRootNamespaceObject() */
@@ -646,13 +870,13 @@ public:
 
 private:
   /**
-   * Break a Config path into the leading path and the last leaf token.
+   * Find the objects of a Config path, that is the objects holding its
+   * attribute or trace source.
+   *
    * \param [in] path The Config path.
-   * \param [in,out] root The leading part of the \pname{path},
-   *   up to the final slash.
-   * \param [in,out] leaf The trailing part of the \pname{path}.
+   * \returns The container of the objects.
    */
-  void ParsePath (std::string path, std::string *root, std::string *leaf) const;
+  MatchContainer LookupMatches (const Path &path);
 
   /** Container type to hold the root Config path tokens. */
   typedef std::vector<Ptr<Object> > Roots;
@@ -663,109 +887,114 @@ private:
 };  // class ConfigImpl
 
 void
-ConfigImpl::ParsePath (std::string path, std::string *root, std::string *leaf) const
+ConfigImpl::Set (const Path &path, const AttributeValue &value)
 {
-  NS_LOG_FUNCTION (this << path << root << leaf);
+  NS_LOG_FUNCTION (this << path.GetPath () << &value);
 
-  std::string::size_type slash = path.find_last_of ("/");
-  NS_ASSERT (slash != std::string::npos);
-  *root = path.substr (0, slash);
-  *leaf = path.substr (slash + 1, path.size () - (slash + 1));
-  NS_LOG_FUNCTION (path << *root << *leaf);
-}
-
-void
-ConfigImpl::Set (std::string path, const AttributeValue &value)
-{
-  NS_LOG_FUNCTION (this << path << &value);
-
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  container.Set (leaf, value);
+  MatchContainer container = LookupMatches (path);
+  container.Set (path.GetLeaf (), value);
 }
 bool
-ConfigImpl::SetFailSafe (std::string path, const AttributeValue &value)
+ConfigImpl::SetFailSafe (const Path &path, const AttributeValue &value)
 {
-  NS_LOG_FUNCTION (this << path << &value);
+  NS_LOG_FUNCTION (this << path.GetPath () << &value);
 
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  return container.SetFailSafe (leaf, value);
+  MatchContainer container = LookupMatches (path);
+  return container.SetFailSafe (path.GetLeaf (), value);
 }
 bool
-ConfigImpl::ConnectWithoutContextFailSafe (std::string path, const CallbackBase &cb)
+ConfigImpl::ConnectWithoutContextFailSafe (const Path &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  return container.ConnectWithoutContextFailSafe (leaf, cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  MatchContainer container = LookupMatches (path);
+  return container.ConnectWithoutContextFailSafe (path.GetLeaf (), cb);
 }
 void
-ConfigImpl::DisconnectWithoutContext (std::string path, const CallbackBase &cb)
+ConfigImpl::DisconnectWithoutContext (const Path &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  MatchContainer container = LookupMatches (path);
   if (container.GetN () == 0)
     {
+      std::string root = path.GetRoot ();
       std::size_t lastFwdSlash = root.rfind ("/");
-      NS_LOG_WARN ("Failed to disconnect " << leaf
+      NS_LOG_WARN ("Failed to disconnect " << path.GetLeaf ()
                                            << ", the Requested object name = " << root.substr (lastFwdSlash + 1)
                                            << " does not exits on path " << root.substr (0, lastFwdSlash));
     }
-  container.DisconnectWithoutContext (leaf, cb);
+  container.DisconnectWithoutContext (path.GetLeaf (), cb);
 }
 bool
-ConfigImpl::ConnectFailSafe (std::string path, const CallbackBase &cb)
+ConfigImpl::ConnectFailSafe (const Path &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
 
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
-  return container.ConnectFailSafe (leaf, cb);
+  MatchContainer container = LookupMatches (path);
+  return container.ConnectFailSafe (path.GetLeaf (), cb);
 }
 void
-ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
+ConfigImpl::Disconnect (const Path &path, const CallbackBase &cb)
 {
-  NS_LOG_FUNCTION (this << path << &cb);
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
 
-  std::string root, leaf;
-  ParsePath (path, &root, &leaf);
-  MatchContainer container = LookupMatches (root);
+  MatchContainer container = LookupMatches (path);
   if (container.GetN () == 0)
     {
+      std::string root = path.GetRoot ();
       std::size_t lastFwdSlash = root.rfind ("/");
-      NS_LOG_WARN ("Failed to disconnect " << leaf
+      NS_LOG_WARN ("Failed to disconnect " << path.GetLeaf ()
                                            << ", the Requested object name = " << root.substr (lastFwdSlash + 1)
                                            << " does not exits on path " << root.substr (0, lastFwdSlash));
     }
-  container.Disconnect (leaf, cb);
+  container.Disconnect (path.GetLeaf (), cb);
 }
 
 MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  // the objects of a Config path with an empty last element
+  return LookupMatches (Path (path + "/"));
+}
+
+MatchContainer
+ConfigImpl::LookupMatches (const Path &path)
+{
+  NS_LOG_FUNCTION (this << path.GetPath ());
   class LookupMatchesResolver : public Resolver
   {
 public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (Ptr<const PathToken> tree)
+      : Resolver (tree)
     {
     }
-    virtual void DoOne (Ptr<Object> object, std::string path)
+    virtual void DoOne (Ptr<Object> object, std::string path,
+                        const std::vector<std::size_t> &paths)
     {
       m_objects.push_back (object);
       m_contexts.push_back (path);
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  };
+
+  Ptr<PathToken> tree = Create<PathToken> ("");
+  Ptr<PathToken> token = tree;
+  for (std::size_t i = 0; i < path.GetTokenN (); i++)
+    {
+      token = token->GetChild (path.GetToken (i));
+    }
+  token->m_paths.push_back (0);
+
+  LookupMatchesResolver resolver (tree);
+  Resolve (resolver);
+  return MatchContainer (resolver.m_objects, resolver.m_contexts, path.GetRoot ());
+}
+
+void
+ConfigImpl::Resolve (Resolver &resolver) const
+{
+  NS_LOG_FUNCTION (this << &resolver);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -777,8 +1006,6 @@ public:
   // looking at the root of the "/Names" namespace during this go.
   //
   resolver.Resolve (0);
-
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
 }
 
 void
@@ -839,12 +1066,12 @@ void Reset (void)
 void Set (std::string path, const AttributeValue &value)
 {
   NS_LOG_FUNCTION (path << &value);
-  ConfigImpl::Get ()->Set (path, value);
+  ConfigImpl::Get ()->Set (Path (path), value);
 }
 bool SetFailSafe (std::string path, const AttributeValue &value)
 {
   NS_LOG_FUNCTION (path << &value);
-  return ConfigImpl::Get ()->SetFailSafe (path, value);
+  return ConfigImpl::Get ()->SetFailSafe (Path (path), value);
 }
 void SetDefault (std::string name, const AttributeValue &value)
 {
@@ -909,12 +1136,12 @@ void ConnectWithoutContext (std::string path, const CallbackBase &cb)
 bool ConnectWithoutContextFailSafe (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  return ConfigImpl::Get ()->ConnectWithoutContextFailSafe (path, cb);
+  return ConfigImpl::Get ()->ConnectWithoutContextFailSafe (Path (path), cb);
 }
 void DisconnectWithoutContext (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->DisconnectWithoutContext (path, cb);
+  ConfigImpl::Get ()->DisconnectWithoutContext (Path (path), cb);
 }
 void
 Connect (std::string path, const CallbackBase &cb)
@@ -929,13 +1156,55 @@ bool
 ConnectFailSafe (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  return ConfigImpl::Get ()->ConnectFailSafe (path, cb);
+  return ConfigImpl::Get ()->ConnectFailSafe (Path (path), cb);
 }
 void
 Disconnect (std::string path, const CallbackBase &cb)
 {
   NS_LOG_FUNCTION (path << &cb);
-  ConfigImpl::Get ()->Disconnect (path, cb);
+  ConfigImpl::Get ()->Disconnect (Path (path), cb);
+}
+void
+Path::Set (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (m_path << &value);
+  ConfigImpl::Get ()->Set (*this, value);
+}
+bool
+Path::SetFailSafe (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (m_path << &value);
+  return ConfigImpl::Get ()->SetFailSafe (*this, value);
+}
+void
+Path::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (m_path << &cb);
+  if (!ConnectWithoutContextFailSafe (cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << m_path);
+    }
+}
+bool
+Path::ConnectWithoutContextFailSafe (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (m_path << &cb);
+  return ConfigImpl::Get ()->ConnectWithoutContextFailSafe (*this, cb);
+}
+void
+Path::Connect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (m_path << &cb);
+  if (!ConnectFailSafe (cb))
+    {
+      NS_FATAL_ERROR ("Could not connect callback to " << m_path);
+    }
+}
+bool
+Path::ConnectFailSafe (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (m_path << &cb);
+  return ConfigImpl::Get ()->ConnectFailSafe (*this, cb);
 }
 MatchContainer LookupMatches (std::string path)
 {
@@ -943,6 +1212,126 @@ MatchContainer LookupMatches (std::string path)
   return ConfigImpl::Get ()->LookupMatches (path);
 }
 
+BulkConnector::BulkConnector ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+BulkConnector::Add (const Path &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  Sink sink = {path, cb, true};
+  m_sinks.push_back (sink);
+}
+
+void
+BulkConnector::Add (std::string path, const CallbackBase &cb)
+{
+  Add (Path (path), cb);
+}
+
+void
+BulkConnector::AddWithoutContext (const Path &path, const CallbackBase &cb)
+{
+  NS_LOG_FUNCTION (this << path.GetPath () << &cb);
+  Sink sink = {path, cb, false};
+  m_sinks.push_back (sink);
+}
+
+void
+BulkConnector::AddWithoutContext (std::string path, const CallbackBase &cb)
+{
+  AddWithoutContext (Path (path), cb);
+}
+
+std::size_t
+BulkConnector::GetN (void) const
+{
+  return m_sinks.size ();
+}
+
+void
+BulkConnector::Connect (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<bool> connected;
+  DoConnect (&connected);
+  for (std::size_t i = 0; i < m_sinks.size (); i++)
+    {
+      if (!connected[i])
+        {
+          NS_FATAL_ERROR ("Could not connect callback to " << m_sinks[i].path.GetPath ());
+        }
+    }
+}
+
+bool
+BulkConnector::ConnectFailSafe (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<bool> connected;
+  DoConnect (&connected);
+  return std::find (connected.begin (), connected.end (), false) == connected.end ();
+}
+
+void
+BulkConnector::DoConnect (std::vector<bool> *connected)
+{
+  NS_LOG_FUNCTION (this << connected);
+  class ConnectResolver : public Resolver
+  {
+public:
+    ConnectResolver (Ptr<const PathToken> tree, const std::vector<Sink> &sinks,
+                     std::vector<bool> *connected)
+      : Resolver (tree),
+        m_sinks (sinks),
+        m_connected (connected)
+    {
+    }
+    virtual void DoOne (Ptr<Object> object, std::string path,
+                        const std::vector<std::size_t> &paths)
+    {
+      for (std::vector<std::size_t>::const_iterator i = paths.begin (); i != paths.end (); i++)
+        {
+          const Sink &sink = m_sinks[*i];
+          std::string name = sink.path.GetLeaf ();
+          bool ok;
+          if (sink.context)
+            {
+              ok = object->TraceConnect (name, path + name, sink.cb);
+            }
+          else
+            {
+              ok = object->TraceConnectWithoutContext (name, sink.cb);
+            }
+          if (ok)
+            {
+              (*m_connected)[*i] = true;
+            }
+        }
+    }
+    const std::vector<Sink> &m_sinks;
+    std::vector<bool> *m_connected;
+  };
+
+  Ptr<PathToken> tree = Create<PathToken> ("");
+  for (std::size_t i = 0; i < m_sinks.size (); i++)
+    {
+      Ptr<PathToken> token = tree;
+      const Path &path = m_sinks[i].path;
+      for (std::size_t j = 0; j < path.GetTokenN (); j++)
+        {
+          token = token->GetChild (path.GetToken (j));
+        }
+      token->m_paths.push_back (i);
+    }
+
+  connected->assign (m_sinks.size (), false);
+  ConnectResolver resolver (tree, m_sinks, connected);
+  ConfigImpl::Get ()->Resolve (resolver);
+}
+
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
   NS_LOG_FUNCTION (obj);
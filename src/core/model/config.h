@@ -21,6 +21,7 @@
 #define CONFIG_H
 
 #include "ptr.h"
+#include "callback.h"
 #include <string>
 #include <vector>
 
@@ -34,7 +35,6 @@ namespace ns3 {
 
 class AttributeValue;
 class Object;
-class CallbackBase;
 
 /**
  * \ingroup core
@@ -314,6 +314,184 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \brief A Config path split into its tokens once, to be resolved many times.
+ *
+ * The functions taking a path string, such as Config::Connect, split
+ * the path at every call.  A Path is split once, when it is
+ * constructed, so a script can keep the paths it sets or connects
+ * repeatedly, for instance for every new node.  The paths of a
+ * BulkConnector are also resolved together in a single walk of the
+ * objects.
+ */
+class Path
+{
+public:
+  /**
+   * Split a Config path.
+   *
+   * \param [in] path The Config path, whose last element is the name of
+   *        an attribute or of a trace source.
+   */
+  explicit Path (std::string path);
+
+  /**
+   * \returns The Config path.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns The path of the objects, without the last element.
+   */
+  std::string GetRoot (void) const;
+  /**
+   * \returns The last element of the path, that is the name of the
+   *          attribute or of the trace source.
+   */
+  std::string GetLeaf (void) const;
+  /**
+   * \returns The number of elements of the path of the objects.
+   */
+  std::size_t GetTokenN (void) const;
+  /**
+   * \param [in] i Index of the element of the path of the objects ([0,n[)
+   * \returns The element.
+   */
+  std::string GetToken (std::size_t i) const;
+
+  /**
+   * Set the attribute named by this path on all the matching objects,
+   * as Config::Set does.
+   *
+   * \param [in] value The value to set.
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \copybrief Set
+   *
+   * \param [in] value The value to set.
+   * \returns \c true if any matching attributes could be set.
+   */
+  bool SetFailSafe (const AttributeValue &value) const;
+  /**
+   * Connect a callback without a context to the trace sources named by
+   * this path, as Config::ConnectWithoutContext does.
+   *
+   * \param [in] cb The callback to connect.
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \copybrief ConnectWithoutContext
+   *
+   * \param [in] cb The callback to connect.
+   * \returns \c true if any trace sources could be connected.
+   */
+  bool ConnectWithoutContextFailSafe (const CallbackBase &cb) const;
+  /**
+   * Connect a callback with a context to the trace sources named by
+   * this path, as Config::Connect does.
+   *
+   * \param [in] cb The callback to connect.
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \copybrief Connect
+   *
+   * \param [in] cb The callback to connect.
+   * \returns \c true if any trace sources could be connected.
+   */
+  bool ConnectFailSafe (const CallbackBase &cb) const;
+
+private:
+  std::string m_path;                 //!< The Config path.
+  std::string m_root;                 //!< The path of the objects.
+  std::string m_leaf;                 //!< The attribute or trace source name.
+  std::vector<std::string> m_tokens;  //!< The elements of the path of the objects.
+};
+
+/**
+ * \ingroup config
+ * \brief Connect many trace sinks in a single walk of the objects.
+ *
+ * Every call to Config::Connect walks all the objects of its path from
+ * the root namespace objects, such as the NodeList.  A BulkConnector
+ * collects the paths and the sinks of a script, merges the paths which
+ * start with the same elements, and visits each matching object once
+ * to connect the sinks of all the paths ending at it.
+ *
+ * \code
+ *   Config::BulkConnector connector;
+ *   connector.Add ("/NodeList/[0-9]/DeviceList/0/Mac/MacTx", MakeCallback (&MacTx));
+ *   connector.Add ("/NodeList/[0-9]/DeviceList/0/Mac/MacRx", MakeCallback (&MacRx));
+ *   connector.Connect ();
+ * \endcode
+ */
+class BulkConnector
+{
+public:
+  BulkConnector ();
+
+  /**
+   * Add a sink to connect with a context, as with Config::Connect.
+   *
+   * \param [in] path A path to match trace sources.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   */
+  void Add (const Path &path, const CallbackBase &cb);
+  /**
+   * \copydoc Add(const Path&,const CallbackBase&)
+   */
+  void Add (std::string path, const CallbackBase &cb);
+  /**
+   * Add a sink to connect without a context, as with
+   * Config::ConnectWithoutContext.
+   *
+   * \param [in] path A path to match trace sources.
+   * \param [in] cb The callback to connect to the matching trace sources.
+   */
+  void AddWithoutContext (const Path &path, const CallbackBase &cb);
+  /**
+   * \copydoc AddWithoutContext(const Path&,const CallbackBase&)
+   */
+  void AddWithoutContext (std::string path, const CallbackBase &cb);
+  /**
+   * \returns The number of sinks added.
+   */
+  std::size_t GetN (void) const;
+
+  /**
+   * Connect all the sinks added.  This method will raise a fatal error
+   * if the path of a sink does not match any trace source; use
+   * ConnectFailSafe if the absence of a match is to be permitted.
+   */
+  void Connect (void);
+  /**
+   * Connect all the sinks added.
+   *
+   * \returns \c true if the path of every sink matched at least one
+   *          trace source.
+   */
+  bool ConnectFailSafe (void);
+
+private:
+  /** A sink to connect. */
+  struct Sink
+  {
+    Path path;         //!< The path of the trace sources.
+    CallbackBase cb;   //!< The callback.
+    bool context;      //!< Whether to connect the callback with a context.
+  };
+  /**
+   * Connect all the sinks added.
+   *
+   * \param [out] connected Whether each sink was connected to at
+   *        least one trace source.
+   */
+  void DoConnect (std::vector<bool> *connected);
+
+  std::vector<Sink> m_sinks;  //!< The sinks to connect.
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
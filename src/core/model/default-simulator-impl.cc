@@ -25,10 +25,16 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "uinteger.h"
+#include "boolean.h"
 #include "assert.h"
+#include "abort.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <set>
 
 
 /**
@@ -46,6 +52,9 @@ NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+thread_local DefaultSimulatorImpl::BatchSlot *DefaultSimulatorImpl::m_currentSlot = 0;
+std::atomic<bool> DefaultSimulatorImpl::m_inBatch (false);
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
@@ -53,6 +62,19 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("BatchThreads",
+                   "The number of threads executing the batches of independent "
+                   "events with the same timestamp, including the main thread; "
+                   "0 executes all the events one by one.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_batchThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("CheckBatchRaces",
+                   "Abort if two events of a batch touch the state of the "
+                   "same context, as reported by NotifyAccess ().",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_checkBatchRaces),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -74,6 +96,15 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_eventCount = 0;
   m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self ();
+  m_batchThreads = 0;
+  m_checkBatchRaces = false;
+  m_batchSize = 0;
+  m_batchUid = 0;
+  m_generation = 0;
+  m_nextSlot = 0;
+  m_busyThreads = 0;
+  m_exit = false;
+  m_sleepingThreads = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
@@ -140,6 +171,17 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 {
   Scheduler::Event next = m_events->RemoveNext ();
 
+  if (m_batchThreads > 0 && next.impl->IsIndependent ()
+      && next.key.m_context != Simulator::NO_CONTEXT)
+    {
+      CollectBatch (next);
+      if (m_batchSize > 1)
+        {
+          ProcessBatch ();
+          return;
+        }
+    }
+
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
   m_eventCount++;
@@ -154,6 +196,221 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   ProcessEventsWithContext ();
 }
 
+void
+DefaultSimulatorImpl::CollectBatch (const Scheduler::Event &first)
+{
+  std::set<uint32_t> contexts;
+  contexts.insert (first.key.m_context);
+  m_batchSize = 0;
+  Scheduler::Event ev = first;
+  for (;;)
+    {
+      if (m_batchSize == m_batch.size ())
+        {
+          m_batch.push_back (BatchSlot ());
+        }
+      BatchSlot &slot = m_batch[m_batchSize];
+      slot.ev = ev;
+      slot.index = m_batchSize;
+      slot.scheduled.clear ();
+      slot.accessed.clear ();
+      slot.checkRaces = m_checkBatchRaces;
+      slot.stop = false;
+      m_batchSize++;
+
+      if (m_events->IsEmpty ())
+        {
+          break;
+        }
+      const Scheduler::Event &next = m_events->PeekNext ();
+      if (next.key.m_ts != first.key.m_ts
+          || !next.impl->IsIndependent ()
+          || !contexts.insert (next.key.m_context).second
+          || next.key.m_context == Simulator::NO_CONTEXT)
+        {
+          break;
+        }
+      ev = m_events->RemoveNext ();
+    }
+}
+
+void
+DefaultSimulatorImpl::ProcessBatch (void)
+{
+  NS_ASSERT (m_batch[0].ev.key.m_ts >= m_currentTs);
+  m_unscheduledEvents -= m_batchSize;
+  m_eventCount += m_batchSize;
+
+  NS_LOG_LOGIC ("handle batch of " << m_batchSize << " at " << m_batch[0].ev.key.m_ts);
+  m_currentTs = m_batch[0].ev.key.m_ts;
+  m_currentContext = Simulator::NO_CONTEXT;
+  // The events of the batch run at once: they have all expired for
+  // each other.
+  m_currentUid = m_batch[m_batchSize - 1].ev.key.m_uid;
+  m_batchUid = m_uid;
+
+  m_nextSlot.store (0, std::memory_order_relaxed);
+  m_busyThreads.store (m_threads.size (), std::memory_order_relaxed);
+  m_inBatch.store (true, std::memory_order_relaxed);
+  WakeWorkers ();
+  RunBatchSlots ();
+  while (m_busyThreads.load (std::memory_order_acquire) != 0)
+    {
+      std::this_thread::yield ();
+    }
+  m_inBatch.store (false, std::memory_order_relaxed);
+
+  if (m_checkBatchRaces)
+    {
+      CheckBatchRaces ();
+    }
+
+  // The uid of the n-th event scheduled by the i-th event of the batch
+  // is m_batchUid + n * m_batchSize + i: see ScheduleInBatch ().
+  std::size_t maxScheduled = 0;
+  for (uint32_t i = 0; i < m_batchSize; i++)
+    {
+      BatchSlot &slot = m_batch[i];
+      for (std::vector<Scheduler::Event>::const_iterator j = slot.scheduled.begin ();
+           j != slot.scheduled.end (); ++j)
+        {
+          m_events->Insert (*j);
+        }
+      m_unscheduledEvents += slot.scheduled.size ();
+      maxScheduled = std::max (maxScheduled, slot.scheduled.size ());
+      if (slot.stop)
+        {
+          m_stop = true;
+        }
+      slot.ev.impl->Unref ();
+    }
+  m_uid = m_batchUid + maxScheduled * m_batchSize;
+
+  ProcessEventsWithContext ();
+}
+
+void
+DefaultSimulatorImpl::RunBatchSlots (void)
+{
+  for (;;)
+    {
+      uint32_t i = m_nextSlot.fetch_add (1, std::memory_order_relaxed);
+      if (i >= m_batchSize)
+        {
+          return;
+        }
+      m_currentSlot = &m_batch[i];
+      m_batch[i].ev.impl->Invoke ();
+      m_currentSlot = 0;
+    }
+}
+
+void
+DefaultSimulatorImpl::CheckBatchRaces (void) const
+{
+  // The event which touched each context.
+  std::map<uint32_t, uint32_t> owner;
+  for (uint32_t i = 0; i < m_batchSize; i++)
+    {
+      owner[m_batch[i].ev.key.m_context] = i;
+    }
+  for (uint32_t i = 0; i < m_batchSize; i++)
+    {
+      const BatchSlot &slot = m_batch[i];
+      for (std::vector<uint32_t>::const_iterator j = slot.accessed.begin (); j != slot.accessed.end (); ++j)
+        {
+          std::pair<std::map<uint32_t, uint32_t>::iterator, bool> ret = owner.insert (std::make_pair (*j, i));
+          if (!ret.second && ret.first->second != i)
+            {
+              NS_FATAL_ERROR ("The independent events of contexts "
+                              << m_batch[ret.first->second].ev.key.m_context
+                              << " and " << slot.ev.key.m_context
+                              << " both touched the state of context " << *j
+                              << " at time " << TimeStep (m_currentTs).As (Time::S));
+            }
+        }
+    }
+}
+
+EventId
+DefaultSimulatorImpl::ScheduleInBatch (BatchSlot *slot, uint32_t context, const Time &delay, EventImpl *event)
+{
+  NS_ASSERT_MSG (delay.IsPositive (), "DefaultSimulatorImpl::Schedule(): Negative delay");
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) (delay + TimeStep (m_currentTs)).GetTimeStep ();
+  ev.key.m_context = context;
+  ev.key.m_uid = m_batchUid + slot->scheduled.size () * m_batchSize + slot->index;
+  slot->scheduled.push_back (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+DefaultSimulatorImpl::BatchSlot *
+DefaultSimulatorImpl::GetCurrentSlot (void)
+{
+  if (!m_inBatch.load (std::memory_order_relaxed))
+    {
+      return 0;
+    }
+  return m_currentSlot;
+}
+
+void
+DefaultSimulatorImpl::WorkerLoop (void)
+{
+  uint32_t generation = 0;
+  for (;;)
+    {
+      // Batches may be far apart: spin for a while, then sleep.
+      uint32_t spins = 0;
+      while (m_generation.load () == generation)
+        {
+          if (++spins < 1000)
+            {
+              continue;
+            }
+          if (spins < 2000)
+            {
+              std::this_thread::yield ();
+              continue;
+            }
+          std::unique_lock<std::mutex> lock (m_workerMutex);
+          m_sleepingThreads++;
+          m_workerCondition.wait (lock, [this, generation] { return m_generation.load () != generation; });
+          m_sleepingThreads--;
+        }
+      generation++;
+      if (m_exit)
+        {
+          return;
+        }
+      RunBatchSlots ();
+      m_busyThreads.fetch_sub (1, std::memory_order_release);
+    }
+}
+
+void
+DefaultSimulatorImpl::WakeWorkers (void)
+{
+  m_generation.fetch_add (1);
+  if (m_sleepingThreads.load () > 0)
+    {
+      std::lock_guard<std::mutex> lock (m_workerMutex);
+      m_workerCondition.notify_all ();
+    }
+}
+
+void
+DefaultSimulatorImpl::NotifyAccess (uint32_t context)
+{
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0 && slot->checkRaces && context != slot->ev.key.m_context
+      && std::find (slot->accessed.begin (), slot->accessed.end (), context) == slot->accessed.end ())
+    {
+      slot->accessed.push_back (context);
+    }
+}
+
 bool
 DefaultSimulatorImpl::IsFinished (void) const
 {
@@ -199,11 +456,26 @@ DefaultSimulatorImpl::Run (void)
   ProcessEventsWithContext ();
   m_stop = false;
 
+  m_exit = false;
+  m_generation = 0;
+  for (uint32_t i = 1; i < m_batchThreads; i++)
+    {
+      m_threads.push_back (std::thread (&DefaultSimulatorImpl::WorkerLoop, this));
+    }
+
   while (!m_events->IsEmpty () && !m_stop)
     {
       ProcessOneEvent ();
     }
 
+  m_exit = true;
+  WakeWorkers ();
+  for (std::vector<std::thread>::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      i->join ();
+    }
+  m_threads.clear ();
+
   // If the simulator stopped naturally by lack of events, make a
   // consistency test to check that we didn't lose any events along the way.
   NS_ASSERT (!m_events->IsEmpty () || m_unscheduledEvents == 0);
@@ -213,6 +485,12 @@ void
 DefaultSimulatorImpl::Stop (void)
 {
   NS_LOG_FUNCTION (this);
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0)
+    {
+      slot->stop = true;
+      return;
+    }
   m_stop = true;
 }
 
@@ -230,6 +508,11 @@ EventId
 DefaultSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
 {
   NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0)
+    {
+      return ScheduleInBatch (slot, slot->ev.key.m_context, delay, event);
+    }
   NS_ASSERT_MSG (SystemThread::Equals (m_main), "Simulator::Schedule Thread-unsafe invocation!");
 
   NS_ASSERT_MSG (delay.IsPositive (), "DefaultSimulatorImpl::Schedule(): Negative delay");
@@ -251,7 +534,12 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 {
   NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
 
-  if (SystemThread::Equals (m_main))
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0)
+    {
+      ScheduleInBatch (slot, context, delay, event);
+    }
+  else if (SystemThread::Equals (m_main))
     {
       Time tAbsolute = delay + TimeStep (m_currentTs);
       Scheduler::Event ev;
@@ -281,6 +569,11 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0)
+    {
+      return ScheduleInBatch (slot, slot->ev.key.m_context, TimeStep (0), event);
+    }
   NS_ASSERT_MSG (SystemThread::Equals (m_main), "Simulator::ScheduleNow Thread-unsafe invocation!");
 
   Scheduler::Event ev;
@@ -297,6 +590,7 @@ DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 EventId
 DefaultSimulatorImpl::ScheduleDestroy (EventImpl *event)
 {
+  NS_ABORT_MSG_IF (GetCurrentSlot () != 0, "Simulator::ScheduleDestroy cannot be called from an independent event");
   NS_ASSERT_MSG (SystemThread::Equals (m_main), "Simulator::ScheduleDestroy Thread-unsafe invocation!");
 
   EventId id (Ptr<EventImpl> (event, false), m_currentTs, 0xffffffff, 2);
@@ -328,6 +622,13 @@ DefaultSimulatorImpl::GetDelayLeft (const EventId &id) const
 void
 DefaultSimulatorImpl::Remove (const EventId &id)
 {
+  if (GetCurrentSlot () != 0)
+    {
+      // The event list belongs to the main thread: cancel the event,
+      // which stays in the list until it expires.
+      Cancel (id);
+      return;
+    }
   if (id.GetUid () == 2)
     {
       // destroy events.
@@ -409,6 +710,11 @@ DefaultSimulatorImpl::GetMaximumSimulationTime (void) const
 uint32_t
 DefaultSimulatorImpl::GetContext (void) const
 {
+  BatchSlot *slot = GetCurrentSlot ();
+  if (slot != 0)
+    {
+      return slot->ev.key.m_context;
+    }
   return m_currentContext;
 }
 
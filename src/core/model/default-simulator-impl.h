@@ -29,7 +29,12 @@
 
 #include "ptr.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /**
  * \file
@@ -43,6 +48,26 @@ namespace ns3 {
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the BatchThreads attribute is not zero, the events marked as
+ * independent (see Simulator::ScheduleIndependent ()) which have the
+ * same timestamp and distinct contexts form a batch, executed on
+ * BatchThreads threads.  The events scheduled by the events of a batch
+ * are inserted in the event list at the end of the batch, with uids
+ * which only depend on the position of the event in the batch and on
+ * the order in which it scheduled them, so the simulation results do
+ * not depend on the number of threads.  Within a batch, Remove () only
+ * cancels the event, Stop () takes effect at the end of the batch, and
+ * ScheduleDestroy () is not allowed.
+ *
+ * An independent event may only touch the state of its own context;
+ * the objects shared by several contexts, such as trace sinks, must be
+ * safe to use from several threads, and ns-3 must be built with atomic
+ * reference counts (\c --enable-atomic-refcount) when the events of a
+ * batch share objects.  The CheckBatchRaces attribute verifies the first
+ * rule: the models report the contexts whose state they touch with
+ * NotifyAccess (), and the simulator aborts when two events of a batch
+ * touch the state of the same context.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -79,11 +104,62 @@ public:
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
 
+  /**
+   * Report an access to the state of a context, such as a node, by the
+   * current event.  Does nothing unless the event runs in a batch with
+   * CheckBatchRaces enabled.
+   *
+   * \param [in] context The context whose state is accessed.
+   */
+  static void NotifyAccess (uint32_t context);
+
 private:
   virtual void DoDispose (void);
 
+  /** An event of a batch, and the effects of its execution. */
+  struct BatchSlot
+  {
+    Scheduler::Event ev;                     ///< The event.
+    uint32_t index;                          ///< The position of the event in the batch.
+    std::vector<Scheduler::Event> scheduled; ///< The events it scheduled.
+    std::vector<uint32_t> accessed;          ///< The other contexts whose state it touched.
+    bool checkRaces;                         ///< Whether to record the accessed contexts.
+    bool stop;                               ///< Whether it called Stop ().
+  };
+
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Gather the independent events which can run in a batch with an event.
+   * \param [in] first The first event of the batch.
+   */
+  void CollectBatch (const Scheduler::Event &first);
+  /** Execute the events of the batch, and insert the events they scheduled. */
+  void ProcessBatch (void);
+  /** Execute the events of the batch claimed by the calling thread. */
+  void RunBatchSlots (void);
+  /**
+   * Check that the events of the batch touched disjoint contexts.
+   */
+  void CheckBatchRaces (void) const;
+  /**
+   * Buffer an event scheduled by an event of the batch.
+   * \param [in] slot The scheduling event.
+   * \param [in] context The context of the new event.
+   * \param [in] delay The delay of the new event.
+   * \param [in] event The new event.
+   * \return The id of the new event.
+   */
+  EventId ScheduleInBatch (BatchSlot *slot, uint32_t context, const Time &delay, EventImpl *event);
+  /**
+   * Get the slot of the batch running on the calling thread.
+   * \return The slot, or 0 outside of a batch.
+   */
+  static BatchSlot * GetCurrentSlot (void);
+  /** The loop of a batch worker thread. */
+  void WorkerLoop (void);
+  /** Start the worker threads on the current batch, or make them return. */
+  void WakeWorkers (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
 
@@ -136,6 +212,25 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  uint32_t m_batchThreads;               ///< The BatchThreads attribute.
+  bool m_checkBatchRaces;                ///< The CheckBatchRaces attribute.
+  std::vector<BatchSlot> m_batch;        ///< The current batch; only the first m_batchSize slots are used.
+  uint32_t m_batchSize;                  ///< The number of events in the current batch.
+  uint32_t m_batchUid;                   ///< The first uid of the events scheduled by the batch.
+  std::vector<std::thread> m_threads;    ///< The batch worker threads.
+  std::atomic<uint32_t> m_generation;    ///< Incremented to start a batch.
+  std::atomic<uint32_t> m_nextSlot;      ///< The next slot of the batch to run.
+  std::atomic<uint32_t> m_busyThreads;   ///< The workers still running the batch.
+  bool m_exit;                           ///< Flag asking the workers to return.
+  std::atomic<uint32_t> m_sleepingThreads; ///< The workers waiting on #m_workerCondition.
+  std::mutex m_workerMutex;              ///< Mutex of #m_workerCondition.
+  std::condition_variable m_workerCondition; ///< Wakes the workers waiting for a batch.
+
+  /** The slot of the batch running on the calling thread, if any. */
+  static thread_local BatchSlot *m_currentSlot;
+  /** Whether a batch is running, which avoids the thread-local lookups otherwise. */
+  static std::atomic<bool> m_inBatch;
 };
 
 } // namespace ns3
@@ -37,7 +37,8 @@ EventImpl::~EventImpl ()
 }
 
 EventImpl::EventImpl ()
-  : m_cancel (false)
+  : m_cancel (false),
+    m_independent (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -66,4 +67,17 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+void
+EventImpl::SetIndependent (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_independent = true;
+}
+
+bool
+EventImpl::IsIndependent (void) const
+{
+  return m_independent;
+}
+
 } // namespace ns3
@@ -65,6 +65,18 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Marks the event as independent: it only touches the state of its
+   * own context, so that it may run concurrently with the independent
+   * events of other contexts which have the same timestamp.
+   *
+   * \see DefaultSimulatorImpl
+   */
+  void SetIndependent (void);
+  /**
+   * \returns true if the event was marked as independent.
+   */
+  bool IsIndependent (void) const;
 
 protected:
   /**
@@ -77,6 +89,7 @@ protected:
 
 private:
   bool m_cancel;  /**< Has this event been cancelled. */
+  bool m_independent;  /**< Is this event independent of the other contexts. */
 };
 
 } // namespace ns3
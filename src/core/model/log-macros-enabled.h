@@ -75,6 +75,36 @@
 
 #ifdef NS3_LOG_ENABLE
 
+#ifndef NS3_LOG_STATIC_LEVEL
+/**
+ * \ingroup logging
+ * The log levels compiled in the current translation unit, as the
+ * name of a LogLevel without its \c ns3:: qualifier.
+ *
+ * The messages of the other levels are compiled out: their arguments
+ * are not evaluated, and they cannot be enabled at run time.  The
+ * build systems define this macro for each module, from the
+ * \c NS3_LOG_LEVEL and \c NS3_LOG_LEVEL_<module> CMake variables or
+ * from the \c --log-level waf option, for instance:
+ * \code
+ *   cmake -DNS3_LOG=ON -DNS3_LOG_LEVEL=warn -DNS3_LOG_LEVEL_lte=all ..
+ * \endcode
+ * A source file can also define it before including any header.
+ */
+#define NS3_LOG_STATIC_LEVEL LOG_LEVEL_ALL
+#endif
+
+/**
+ * \ingroup logging
+ * Check if a log level is compiled in the current translation unit.
+ * \internal
+ * Logging implementation macro; should not be called directly.
+ *
+ * \param [in] level The log level.
+ */
+#define NS_LOG_STATIC_ENABLED(level)                            \
+  ((ns3::NS3_LOG_STATIC_LEVEL & (level) & ns3::LOG_LEVEL_ALL) != 0)
+
 /**
  * \ingroup logging
  * Append the simulation time to a log message.
@@ -187,7 +217,8 @@
 #define NS_LOG(level, msg)                                      \
   NS_LOG_CONDITION                                              \
   do {                                                          \
-      if (g_log.IsEnabled (level))                              \
+      if (NS_LOG_STATIC_ENABLED (level)                         \
+          && g_log.IsEnabled (level))                           \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -209,7 +240,8 @@
 #define NS_LOG_FUNCTION_NOARGS()                                \
   NS_LOG_CONDITION                                              \
   do {                                                          \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_STATIC_ENABLED (ns3::LOG_FUNCTION)             \
+          && g_log.IsEnabled (ns3::LOG_FUNCTION))               \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -245,7 +277,8 @@
   NS_LOG_CONDITION                                              \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_STATIC_ENABLED (ns3::LOG_FUNCTION)             \
+          && g_log.IsEnabled (ns3::LOG_FUNCTION))               \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup memory
+ * ns3::MemoryGauge implementation.
+ */
+
+#include "memory-gauge.h"
+#include "assert.h"
+
+#include <algorithm>
+#include <iomanip>
+
+// Note: this file is used by the static gauges of all the modules, which
+// are constructed before main (), so it can't use the logging macros.
+
+namespace ns3 {
+
+/* static */
+std::atomic<bool> MemoryGauge::g_enabled (false);
+
+/* static */
+MemoryGauge::GaugeList *
+MemoryGauge::GetGaugeList (void)
+{
+  static GaugeList gauges;
+  return &gauges;
+}
+
+MemoryGauge::MemoryGauge (const std::string & subsystem, const std::string & name)
+  : m_subsystem (subsystem),
+    m_name (name),
+    m_bytes (0),
+    m_count (0),
+    m_peakBytes (0)
+{
+  NS_ASSERT_MSG (Find (subsystem, name) == nullptr,
+                 "Memory gauge \"" << subsystem << "::" << name
+                 << "\" is registered twice");
+  GetGaugeList ()->push_back (this);
+}
+
+MemoryGauge::~MemoryGauge ()
+{
+  GaugeList *gauges = GetGaugeList ();
+  gauges->erase (std::remove (gauges->begin (), gauges->end (), this), gauges->end ());
+}
+
+void
+MemoryGauge::DoAdd (int64_t bytes, int64_t count)
+{
+  int64_t now = m_bytes.fetch_add (bytes, std::memory_order_relaxed) + bytes;
+  m_count.fetch_add (count, std::memory_order_relaxed);
+  int64_t peak = m_peakBytes.load (std::memory_order_relaxed);
+  while (now > peak
+         && !m_peakBytes.compare_exchange_weak (peak, now, std::memory_order_relaxed))
+    {
+      // peak has been reloaded, try again
+    }
+}
+
+std::string
+MemoryGauge::GetSubsystem (void) const
+{
+  return m_subsystem;
+}
+
+std::string
+MemoryGauge::GetName (void) const
+{
+  return m_name;
+}
+
+int64_t
+MemoryGauge::GetBytes (void) const
+{
+  return m_bytes.load (std::memory_order_relaxed);
+}
+
+int64_t
+MemoryGauge::GetCount (void) const
+{
+  return m_count.load (std::memory_order_relaxed);
+}
+
+int64_t
+MemoryGauge::GetPeakBytes (void) const
+{
+  return m_peakBytes.load (std::memory_order_relaxed);
+}
+
+void
+MemoryGauge::Reset (void)
+{
+  m_bytes.store (0, std::memory_order_relaxed);
+  m_count.store (0, std::memory_order_relaxed);
+  m_peakBytes.store (0, std::memory_order_relaxed);
+}
+
+/* static */
+void
+MemoryGauge::Enable (void)
+{
+  g_enabled.store (true, std::memory_order_relaxed);
+}
+
+/* static */
+void
+MemoryGauge::Disable (void)
+{
+  g_enabled.store (false, std::memory_order_relaxed);
+}
+
+/* static */
+std::vector<const MemoryGauge *>
+MemoryGauge::GetGauges (void)
+{
+  const GaugeList *gauges = GetGaugeList ();
+  std::vector<const MemoryGauge *> sorted (gauges->begin (), gauges->end ());
+  std::sort (sorted.begin (), sorted.end (),
+             [] (const MemoryGauge *a, const MemoryGauge *b)
+             {
+               if (a->m_subsystem != b->m_subsystem)
+                 {
+                   return a->m_subsystem < b->m_subsystem;
+                 }
+               return a->m_name < b->m_name;
+             });
+  return sorted;
+}
+
+/* static */
+const MemoryGauge *
+MemoryGauge::Find (const std::string & subsystem, const std::string & name)
+{
+  for (const MemoryGauge *gauge : *GetGaugeList ())
+    {
+      if (gauge->m_subsystem == subsystem && gauge->m_name == name)
+        {
+          return gauge;
+        }
+    }
+  return nullptr;
+}
+
+/* static */
+void
+MemoryGauge::Print (std::ostream & os)
+{
+  std::ios::fmtflags oldFlags (os.flags ());
+  for (const MemoryGauge *gauge : GetGauges ())
+    {
+      os << std::left << std::setw (10) << gauge->m_subsystem
+         << std::setw (56) << gauge->m_name
+         << std::right
+         << std::setw (14) << gauge->GetBytes () << " B"
+         << std::setw (12) << gauge->GetCount ()
+         << std::setw (14) << gauge->GetPeakBytes () << " B peak"
+         << std::endl;
+    }
+  os.flags (oldFlags);
+}
+
+} // namespace ns3
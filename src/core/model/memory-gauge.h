@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_GAUGE_H
+#define MEMORY_GAUGE_H
+
+/**
+ * \file
+ * \ingroup memory
+ * ns3::MemoryGauge declaration and ns3::GetHeapBytes() helpers.
+ */
+
+#include <atomic>
+#include <complex>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \ingroup debugging
+ * \defgroup memory Memory accounting
+ *
+ * Opt-in accounting of the memory held by the long-lived data
+ * structures of the models.
+ *
+ * Each structure of interest is tracked by a MemoryGauge, a static
+ * object defined next to the code which fills and drains the structure.
+ * Gauges are tagged with the subsystem (usually the module) they
+ * belong to, and are listed in a process-wide registry.
+ *
+ * Accounting is disabled by default, in which case updating a gauge
+ * costs a single test of a global flag, so that the gauges can be left
+ * in optimized builds.  Call MemoryGauge::Enable(), or create a
+ * MemoryReporter, before building the scenario: memory allocated while
+ * accounting was disabled is not seen by the gauges.
+ */
+
+/**
+ * \ingroup memory
+ *
+ * The number of bytes and of elements held by a data structure.
+ *
+ * The values are estimates, computed by the owner of the structure
+ * from the size of its elements (see GetHeapBytes()), rather than
+ * measured at the allocator.  The counters are atomic, so a gauge can
+ * be updated from the threads of the multithreaded simulator.
+ *
+ * Example usage, in the implementation of a model:
+ *
+ * \code
+ *     static MemoryGauge g_cacheGauge ("spectrum", "MyModel::m_cache");
+ *
+ *     void
+ *     MyModel::Store (uint32_t key, const std::vector<double> & value)
+ *     {
+ *       m_cache[key] = value;
+ *       g_cacheGauge.Add (sizeof (value) + GetHeapBytes (value));
+ *     }
+ * \endcode
+ */
+class MemoryGauge
+{
+public:
+  /**
+   * Register a gauge.
+   *
+   * \param [in] subsystem The subsystem the gauge belongs to.
+   * \param [in] name The name of the gauge, unique within the subsystem.
+   */
+  MemoryGauge (const std::string & subsystem, const std::string & name);
+  /** Unregister the gauge. */
+  ~MemoryGauge ();
+
+  // Delete copy constructor and assignment operator to avoid misuse
+  MemoryGauge (const MemoryGauge &) = delete;
+  MemoryGauge & operator = (const MemoryGauge &) = delete;
+
+  /**
+   * Account for memory added to the structure.
+   *
+   * Does nothing unless accounting is enabled.
+   *
+   * \param [in] bytes The number of bytes added.
+   * \param [in] count The number of elements added.
+   */
+  inline void Add (int64_t bytes, int64_t count = 1)
+  {
+    if (g_enabled.load (std::memory_order_relaxed))
+      {
+        DoAdd (bytes, count);
+      }
+  }
+  /**
+   * Account for memory removed from the structure.
+   *
+   * Does nothing unless accounting is enabled.
+   *
+   * \param [in] bytes The number of bytes removed.
+   * \param [in] count The number of elements removed.
+   */
+  inline void Remove (int64_t bytes, int64_t count = 1)
+  {
+    if (g_enabled.load (std::memory_order_relaxed))
+      {
+        DoAdd (-bytes, -count);
+      }
+  }
+
+  /** \returns The subsystem the gauge belongs to. */
+  std::string GetSubsystem (void) const;
+  /** \returns The name of the gauge. */
+  std::string GetName (void) const;
+  /** \returns The number of bytes currently accounted for. */
+  int64_t GetBytes (void) const;
+  /** \returns The number of elements currently accounted for. */
+  int64_t GetCount (void) const;
+  /** \returns The largest number of bytes accounted for so far. */
+  int64_t GetPeakBytes (void) const;
+  /** Reset the counters and the peak to zero. */
+  void Reset (void);
+
+  /**
+   * Check if accounting is enabled.
+   *
+   * Owners of a structure should test this before computing
+   * the size of its elements, when that is not trivial.
+   *
+   * \returns \c true if the gauges are updated.
+   */
+  inline static bool IsEnabled (void)
+  {
+    return g_enabled.load (std::memory_order_relaxed);
+  }
+  /** Enable the accounting in all the gauges. */
+  static void Enable (void);
+  /** Disable the accounting in all the gauges. */
+  static void Disable (void);
+
+  /**
+   * Get the registered gauges.
+   *
+   * \returns The gauges, sorted by subsystem and name.
+   */
+  static std::vector<const MemoryGauge *> GetGauges (void);
+  /**
+   * Look up a gauge.
+   *
+   * \param [in] subsystem The subsystem the gauge belongs to.
+   * \param [in] name The name of the gauge.
+   * \returns The gauge, or \c nullptr if there is none with that name.
+   */
+  static const MemoryGauge * Find (const std::string & subsystem,
+                                   const std::string & name);
+  /**
+   * Print the current value of all the registered gauges,
+   * one per line.
+   *
+   * \param [in] os The output stream.
+   */
+  static void Print (std::ostream & os);
+
+private:
+  /**
+   * Update the counters and the peak.
+   *
+   * \param [in] bytes The number of bytes added.
+   * \param [in] count The number of elements added.
+   */
+  void DoAdd (int64_t bytes, int64_t count);
+
+  /** The registered gauges. */
+  typedef std::vector<MemoryGauge *> GaugeList;
+  /**
+   * Get the registry of gauges.
+   *
+   * The registry is a function-local static, so that gauges
+   * defined at namespace scope in any module can register.
+   *
+   * \returns The list of registered gauges.
+   */
+  static GaugeList * GetGaugeList (void);
+
+  std::string m_subsystem;          //!< The subsystem.
+  std::string m_name;               //!< The name of the gauge.
+  std::atomic<int64_t> m_bytes;     //!< The number of bytes.
+  std::atomic<int64_t> m_count;     //!< The number of elements.
+  std::atomic<int64_t> m_peakBytes; //!< The peak number of bytes.
+
+  /** Whether the gauges are updated; read by the simulation threads. */
+  static std::atomic<bool> g_enabled;
+
+};  // class MemoryGauge
+
+
+/**
+ * \ingroup memory
+ * \defgroup memoryheapbytes Heap footprint of containers
+ *
+ * Estimate the heap memory owned by a value, excluding
+ * the \c sizeof of the value itself.
+ *
+ * The estimate is based on the capacity of the containers,
+ * and recurses into nested vectors.
+ */
+/**
+ * \ingroup memoryheapbytes
+ * \returns Zero, for a value which owns no heap memory.
+ */
+template <typename T>
+inline int64_t
+GetHeapBytes (const T &)
+{
+  return 0;
+}
+
+/**
+ * \ingroup memoryheapbytes
+ * \param [in] value A vector of numbers.
+ * \returns The heap memory owned by the vector.
+ */
+inline int64_t
+GetHeapBytes (const std::vector<double> & value)
+{
+  return value.capacity () * sizeof (double);
+}
+
+/**
+ * \ingroup memoryheapbytes
+ * \param [in] value A vector of complex numbers.
+ * \returns The heap memory owned by the vector.
+ */
+inline int64_t
+GetHeapBytes (const std::vector<std::complex<double> > & value)
+{
+  return value.capacity () * sizeof (std::complex<double>);
+}
+
+/**
+ * \ingroup memoryheapbytes
+ * \param [in] value A vector.
+ * \returns The heap memory owned by the vector and its elements.
+ */
+template <typename T>
+inline int64_t
+GetHeapBytes (const std::vector<T> & value)
+{
+  int64_t bytes = value.capacity () * sizeof (T);
+  for (const T & item : value)
+    {
+      bytes += GetHeapBytes (item);
+    }
+  return bytes;
+}
+
+} // namespace ns3
+
+#endif /* MEMORY_GAUGE_H */
@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup memory
+ * ns3::MemoryReporter implementation.
+ */
+
+#include "memory-reporter.h"
+#include "memory-gauge.h"
+#include "log.h"
+#include "simulator.h"
+#include "trace-source-accessor.h"
+
+#ifdef __linux__
+#include <fstream>
+#include <unistd.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MemoryReporter");
+
+NS_OBJECT_ENSURE_REGISTERED (MemoryReporter);
+
+TypeId
+MemoryReporter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MemoryReporter")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MemoryReporter> ()
+    .AddAttribute ("Interval",
+                   "The simulation time between two reports.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&MemoryReporter::m_interval),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddTraceSource ("Gauge",
+                     "The value of a memory gauge, fired for each gauge "
+                     "at every report.",
+                     MakeTraceSourceAccessor (&MemoryReporter::m_gaugeTrace),
+                     "ns3::MemoryReporter::GaugeTracedCallback")
+    .AddTraceSource ("Total",
+                     "The total of the memory gauges and the resident "
+                     "set size of the process, fired at every report.",
+                     MakeTraceSourceAccessor (&MemoryReporter::m_totalTrace),
+                     "ns3::MemoryReporter::TotalTracedCallback")
+  ;
+  return tid;
+}
+
+MemoryReporter::MemoryReporter ()
+  : m_os (&std::cout)
+{
+  NS_LOG_FUNCTION (this);
+  MemoryGauge::Enable ();
+}
+
+MemoryReporter::~MemoryReporter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MemoryReporter::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Stop ();
+  Object::DoDispose ();
+}
+
+void
+MemoryReporter::SetStream (std::ostream & os)
+{
+  m_os = &os;
+}
+
+void
+MemoryReporter::DisableOutput (void)
+{
+  m_os = nullptr;
+}
+
+void
+MemoryReporter::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_event);
+  m_event = Simulator::Schedule (m_interval, &MemoryReporter::PeriodicReport, this);
+}
+
+void
+MemoryReporter::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_event);
+}
+
+void
+MemoryReporter::PeriodicReport (void)
+{
+  Report ();
+  m_event = Simulator::Schedule (m_interval, &MemoryReporter::PeriodicReport, this);
+}
+
+void
+MemoryReporter::Report (void)
+{
+  NS_LOG_FUNCTION (this);
+  int64_t accounted = 0;
+  for (const MemoryGauge *gauge : MemoryGauge::GetGauges ())
+    {
+      int64_t bytes = gauge->GetBytes ();
+      accounted += bytes;
+      m_gaugeTrace (gauge->GetSubsystem (), gauge->GetName (), bytes, gauge->GetCount ());
+    }
+  int64_t resident = GetResidentBytes ();
+  m_totalTrace (accounted, resident);
+
+  if (m_os != nullptr)
+    {
+      *m_os << Simulator::Now ().As (Time::S) << " memory report";
+      if (resident > 0)
+        {
+          *m_os << ", resident " << resident << " B";
+        }
+      *m_os << std::endl;
+      MemoryGauge::Print (*m_os);
+    }
+}
+
+/* static */
+int64_t
+MemoryReporter::GetResidentBytes (void)
+{
+#ifdef __linux__
+  // statm holds the sizes in pages: total program size, then resident
+  std::ifstream statm ("/proc/self/statm");
+  int64_t size = 0;
+  int64_t resident = 0;
+  if (statm >> size >> resident)
+    {
+      return resident * sysconf (_SC_PAGESIZE);
+    }
+#endif
+  return 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_REPORTER_H
+#define MEMORY_REPORTER_H
+
+/**
+ * \file
+ * \ingroup memory
+ * ns3::MemoryReporter declaration.
+ */
+
+#include <iostream>
+#include <string>
+
+#include "event-id.h"
+#include "nstime.h"
+#include "object.h"
+#include "traced-callback.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup memory
+ *
+ * Periodically report the memory accounted for by the MemoryGauge objects.
+ *
+ * Creating a reporter enables the accounting, so it must be created
+ * before the scenario is built.  Every \c Interval of simulation time,
+ * the reporter fires its trace sources with the value of every gauge and
+ * with the resident set size of the process, if available, and prints
+ * them on its output stream, if any.
+ *
+ * Example usage:
+ *
+ * \code
+ *     int main (int arg, char ** argv)
+ *     {
+ *       Ptr<MemoryReporter> reporter = CreateObject<MemoryReporter> ();
+ *       reporter->SetAttribute ("Interval", TimeValue (Seconds (10)));
+ *       reporter->Start ();
+ *
+ *       // Create your model
+ *
+ *       Simulator::Run ();
+ *       Simulator::Destroy ();
+ *     }
+ * \endcode
+ *
+ * This generates output similar to the following:
+ *
+ * \code
+ *     +10s memory report, resident 371879936 B
+ *     network   Buffer::Data                                                   1083904 B        2117       1210368 B peak
+ *     network   Buffer::FreeList                                                262144 B         512        262144 B peak
+ *     spectrum  ThreeGppChannelModel::m_channelMap                            84713472 B         380      84713472 B peak
+ *     spectrum  ThreeGppSpectrumPropagationLossModel::m_longTermMap            5894400 B         380       5894400 B peak
+ *     wifi      InterferenceHelper::NiChanges                                    52736 B         824         61440 B peak
+ *     wifi      WifiMacQueue                                                    412160 B         280        998400 B peak
+ * \endcode
+ */
+class MemoryReporter : public Object
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor; enables the memory accounting. */
+  MemoryReporter ();
+  /** Destructor. */
+  virtual ~MemoryReporter ();
+
+  /**
+   * Set the output stream to print the reports on.
+   * \param [in] os The output stream; defaults to std::cout.
+   */
+  void SetStream (std::ostream & os);
+  /**
+   * Only fire the trace sources, without printing the reports.
+   */
+  void DisableOutput (void);
+
+  /** Start the periodic reports, the first one after \c Interval. */
+  void Start (void);
+  /** Stop the periodic reports. */
+  void Stop (void);
+  /** Report the current values now. */
+  void Report (void);
+
+  /**
+   * Get the resident set size of the process.
+   *
+   * \returns The resident set size, in bytes, or zero if it is
+   *          not available on this platform.
+   */
+  static int64_t GetResidentBytes (void);
+
+  /**
+   * TracedCallback signature for the value of a gauge.
+   *
+   * \param [in] subsystem The subsystem of the gauge.
+   * \param [in] name The name of the gauge.
+   * \param [in] bytes The number of bytes.
+   * \param [in] count The number of elements.
+   */
+  typedef void (* GaugeTracedCallback)
+    (const std::string & subsystem, const std::string & name,
+     int64_t bytes, int64_t count);
+
+  /**
+   * TracedCallback signature for the memory of the process.
+   *
+   * \param [in] accounted The total number of bytes of the gauges.
+   * \param [in] resident The resident set size, or zero.
+   */
+  typedef void (* TotalTracedCallback) (int64_t accounted, int64_t resident);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /** Report and schedule the next report. */
+  void PeriodicReport (void);
+
+  Time m_interval;        //!< The simulation time between reports.
+  EventId m_event;        //!< The next report.
+  std::ostream *m_os;     //!< The output stream, or \c nullptr.
+
+  /** The value of each gauge. */
+  TracedCallback<const std::string &, const std::string &,
+                 int64_t, int64_t> m_gaugeTrace;
+  /** The total of the gauges and the memory of the process. */
+  TracedCallback<int64_t, int64_t> m_totalTrace;
+
+};  // class MemoryReporter
+
+} // namespace ns3
+
+#endif /* MEMORY_REPORTER_H */
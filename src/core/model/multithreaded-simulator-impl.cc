@@ -0,0 +1,791 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "multithreaded-simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ptr.h"
+#include "pointer.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+std::vector<uint32_t> MultithreadedSimulatorImpl::m_partitions;
+thread_local MultithreadedSimulatorImpl::LogicalProcess *MultithreadedSimulatorImpl::m_currentLp = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Lookahead",
+                   "The length of the windows in which the partitions run "
+                   "concurrently.  It must not exceed the smallest delay of "
+                   "an event scheduled from a partition to another one.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker (Seconds (0)))
+    .AddAttribute ("NumThreads",
+                   "The number of threads running the partitions, including "
+                   "the main thread; 0 uses one thread per hardware thread.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_numThreads),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = false;
+  m_currentTs = 0;
+  m_eventsWithContextEmpty = true;
+  m_main = std::this_thread::get_id ();
+  m_windowEnd = 0;
+  m_generation = 0;
+  m_nextLp = 0;
+  m_busyThreads = 0;
+  m_exit = false;
+  m_running = false;
+  m_idleUid = 0;
+  m_schedulerFactory.SetTypeId ("ns3::MapScheduler");
+  m_global = CreateLp ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  ProcessEventsWithContext ();
+
+  m_lps.push_back (m_global);
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      LogicalProcess *lp = *i;
+      while (!lp->events->IsEmpty ())
+        {
+          Scheduler::Event next = lp->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      delete lp;
+    }
+  m_lps.clear ();
+  m_global = 0;
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+
+  m_lps.push_back (m_global);
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!(*i)->events->IsEmpty ())
+        {
+          Scheduler::Event next = (*i)->events->RemoveNext ();
+          scheduler->Insert (next);
+        }
+      (*i)->events = scheduler;
+    }
+  m_lps.pop_back ();
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (context << partition);
+  NS_ASSERT_MSG (context != Simulator::NO_CONTEXT, "Events without context are global");
+  if (context >= m_partitions.size ())
+    {
+      m_partitions.resize (context + 1, 0);
+    }
+  m_partitions[context] = partition;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context)
+{
+  return context < m_partitions.size () ? m_partitions[context] : 0;
+}
+
+void
+MultithreadedSimulatorImpl::ClearPartitions (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_partitions.clear ();
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::CreateLp (void)
+{
+  LogicalProcess *lp = new LogicalProcess;
+  lp->events = m_schedulerFactory.Create<Scheduler> ();
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  lp->uid = 4;
+  lp->currentUid = 0;
+  lp->currentTs = m_currentTs;
+  lp->currentContext = Simulator::NO_CONTEXT;
+  lp->eventCount = 0;
+  lp->unscheduledEvents = 0;
+  return lp;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::GetCurrentLp (void) const
+{
+  if (m_currentLp != 0)
+    {
+      return m_currentLp;
+    }
+  if (std::this_thread::get_id () == m_main)
+    {
+      return m_global;
+    }
+  return 0;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::GetLp (uint32_t context)
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return m_global;
+    }
+  uint32_t partition = GetPartition (context);
+  if (partition >= m_lps.size ())
+    {
+      NS_ASSERT_MSG (m_currentLp == 0 || m_currentLp == m_global,
+                     "Partition " << partition << " was created while the partitions run");
+      while (partition >= m_lps.size ())
+        {
+          m_lps.push_back (CreateLp ());
+        }
+    }
+  return m_lps[partition];
+}
+
+MultithreadedSimulatorImpl::LogicalProcess *
+MultithreadedSimulatorImpl::GetOwner (const EventId &id) const
+{
+  if (id.GetContext () == Simulator::NO_CONTEXT
+      || (!m_running && id.GetUid () >= m_idleUid))
+    {
+      return m_global;
+    }
+  uint32_t partition = GetPartition (id.GetContext ());
+  if (partition >= m_lps.size ())
+    {
+      // The partition has never had any event.
+      return 0;
+    }
+  return m_lps[partition];
+}
+
+void
+MultithreadedSimulatorImpl::Insert (LogicalProcess *lp, Scheduler::Event &ev)
+{
+  // While the simulator does not run, all the events are kept in the
+  // global list and take their uids from the global counter.
+  LogicalProcess *counter = m_running ? lp : m_global;
+  ev.key.m_uid = counter->uid;
+  counter->uid++;
+  lp->unscheduledEvents++;
+  lp->events->Insert (ev);
+}
+
+void
+MultithreadedSimulatorImpl::DistributeEvents (void)
+{
+  std::vector<Scheduler::Event> events;
+  while (!m_global->events->IsEmpty ())
+    {
+      events.push_back (m_global->events->RemoveNext ());
+    }
+  for (std::vector<Scheduler::Event>::iterator i = events.begin (); i != events.end (); ++i)
+    {
+      LogicalProcess *lp = GetLp (i->key.m_context);
+      if (lp != m_global)
+        {
+          m_global->unscheduledEvents--;
+          lp->unscheduledEvents++;
+        }
+      // Keep the uid, which is unique among the events scheduled
+      // while the simulator did not run.
+      lp->events->Insert (*i);
+    }
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      (*i)->uid = std::max ((*i)->uid, m_global->uid);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (LogicalProcess *lp)
+{
+  Scheduler::Event next = lp->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= lp->currentTs);
+  lp->unscheduledEvents--;
+  lp->eventCount++;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  lp->currentTs = next.key.m_ts;
+  lp->currentContext = next.key.m_context;
+  lp->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  if (!m_global->events->IsEmpty ())
+    {
+      return false;
+    }
+  for (std::vector<LogicalProcess *>::const_iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessEventsWithContext (void)
+{
+  if (m_eventsWithContextEmpty)
+    {
+      return;
+    }
+
+  // swap queues
+  EventsWithContext eventsWithContext;
+  {
+    std::lock_guard<std::mutex> lock (m_eventsWithContextMutex);
+    m_eventsWithContext.swap (eventsWithContext);
+    m_eventsWithContextEmpty = true;
+  }
+  while (!eventsWithContext.empty ())
+    {
+      EventWithContext event = eventsWithContext.front ();
+      eventsWithContext.pop_front ();
+      Scheduler::Event ev;
+      ev.impl = event.event;
+      ev.key.m_ts = m_currentTs + event.timestamp;
+      ev.key.m_context = event.context;
+      Insert (m_running ? GetLp (event.context) : m_global, ev);
+    }
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetNextPartitionTs (void) const
+{
+  uint64_t next = std::numeric_limits<uint64_t>::max ();
+  for (std::vector<LogicalProcess *>::const_iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          next = std::min (next, (*i)->events->PeekNext ().key.m_ts);
+        }
+    }
+  return next;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (void)
+{
+  // The partitions are claimed one at a time, so that the threads
+  // which are done with a light partition help with the others.
+  for (;;)
+    {
+      uint32_t index = m_nextLp.fetch_add (1, std::memory_order_relaxed);
+      if (index >= m_lps.size ())
+        {
+          break;
+        }
+      LogicalProcess *lp = m_lps[index];
+      m_currentLp = lp;
+      while (!lp->events->IsEmpty ()
+             && lp->events->PeekNext ().key.m_ts < m_windowEnd)
+        {
+          ProcessOneEvent (lp);
+        }
+      m_currentLp = 0;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DeliverMessages (void)
+{
+  // Deliver in partition order and, within a partition, in the order
+  // the messages were sent, so that the uids do not depend on the threads.
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      std::vector<Message> &outbox = (*i)->outbox;
+      for (std::vector<Message>::iterator j = outbox.begin (); j != outbox.end (); ++j)
+        {
+          Insert (j->lp, j->ev);
+        }
+      outbox.clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WorkerLoop (void)
+{
+  uint32_t generation = 0;
+  for (;;)
+    {
+      uint32_t spins = 0;
+      while (m_generation.load (std::memory_order_acquire) == generation)
+        {
+          if (++spins > 1000)
+            {
+              std::this_thread::yield ();
+            }
+        }
+      generation++;
+      if (m_exit)
+        {
+          return;
+        }
+      ProcessWindow ();
+      m_busyThreads.fetch_sub (1, std::memory_order_release);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = std::this_thread::get_id ();
+  ProcessEventsWithContext ();
+  m_stop = false;
+
+  // Create all the partitions before the threads start, since the
+  // partition list cannot grow while they run.
+  for (uint32_t context = 0; context < m_partitions.size (); context++)
+    {
+      GetLp (context);
+    }
+  if (m_lps.empty ())
+    {
+      m_lps.push_back (CreateLp ());
+    }
+  // The events scheduled since the last run, such as the initialization
+  // of the nodes, were kept in the global list: move them to the
+  // partitions which own their context.
+  DistributeEvents ();
+  m_running = true;
+
+  uint32_t numThreads = m_numThreads;
+  if (numThreads == 0)
+    {
+      numThreads = std::max (std::thread::hardware_concurrency (), 1U);
+    }
+  numThreads = std::min<uint32_t> (numThreads, m_lps.size ());
+  NS_LOG_LOGIC ("running " << m_lps.size () << " partitions on " << numThreads << " threads");
+  m_exit = false;
+  m_generation = 0;
+  for (uint32_t i = 1; i < numThreads; i++)
+    {
+      m_threads.push_back (std::thread (&MultithreadedSimulatorImpl::WorkerLoop, this));
+    }
+
+  uint64_t lookahead = std::max<int64_t> (m_lookahead.GetTimeStep (), 1);
+  while (!m_stop)
+    {
+      uint64_t next = GetNextPartitionTs ();
+      if (!m_global->events->IsEmpty ()
+          && m_global->events->PeekNext ().key.m_ts <= next)
+        {
+          // Global events run alone, before the partition events with
+          // the same timestamp.
+          m_currentLp = m_global;
+          ProcessOneEvent (m_global);
+          m_currentLp = 0;
+          m_currentTs = m_global->currentTs;
+          ProcessEventsWithContext ();
+          continue;
+        }
+      if (next == std::numeric_limits<uint64_t>::max ())
+        {
+          break;
+        }
+
+      m_windowEnd = next + std::min (lookahead, std::numeric_limits<uint64_t>::max () - next);
+      if (!m_global->events->IsEmpty ())
+        {
+          m_windowEnd = std::min (m_windowEnd, m_global->events->PeekNext ().key.m_ts);
+        }
+      m_nextLp.store (0, std::memory_order_relaxed);
+      m_busyThreads.store (m_threads.size (), std::memory_order_relaxed);
+      m_generation.fetch_add (1, std::memory_order_release);
+      ProcessWindow ();
+      while (m_busyThreads.load (std::memory_order_acquire) != 0)
+        {
+          std::this_thread::yield ();
+        }
+
+      DeliverMessages ();
+      for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+        {
+          m_currentTs = std::max (m_currentTs, (*i)->currentTs);
+        }
+      m_global->currentTs = m_currentTs;
+      ProcessEventsWithContext ();
+    }
+
+  m_exit = true;
+  m_generation.fetch_add (1, std::memory_order_release);
+  for (std::vector<std::thread>::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      i->join ();
+    }
+  m_threads.clear ();
+  m_running = false;
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      m_global->uid = std::max (m_global->uid, (*i)->uid);
+    }
+  m_idleUid = m_global->uid;
+
+  // If the simulator stopped naturally by lack of events, make a
+  // consistency test to check that we didn't lose any events along the way.
+  NS_ASSERT (!m_global->events->IsEmpty () || m_global->unscheduledEvents == 0);
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      NS_ASSERT (!(*i)->events->IsEmpty () || (*i)->unscheduledEvents == 0);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  LogicalProcess *lp = GetCurrentLp ();
+  NS_ASSERT_MSG (lp != 0, "Simulator::Schedule Thread-unsafe invocation!");
+
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = lp->currentTs + delay.GetTimeStep ();
+  ev.key.m_context = lp->currentContext;
+  Insert (lp, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+
+  LogicalProcess *lp = GetCurrentLp ();
+  if (lp == 0)
+    {
+      EventWithContext ev;
+      ev.context = context;
+      // Current time added in ProcessEventsWithContext()
+      ev.timestamp = delay.GetTimeStep ();
+      ev.event = event;
+      {
+        std::lock_guard<std::mutex> lock (m_eventsWithContextMutex);
+        m_eventsWithContext.push_back (ev);
+        m_eventsWithContextEmpty = false;
+      }
+      return;
+    }
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = lp->currentTs + delay.GetTimeStep ();
+  ev.key.m_context = context;
+  if (lp == m_global)
+    {
+      // No partition runs: the event can be inserted right away.
+      Insert (m_running ? GetLp (context) : m_global, ev);
+      return;
+    }
+  NS_ASSERT_MSG (context == Simulator::NO_CONTEXT || GetPartition (context) < m_lps.size (),
+                 "Partition of context " << context << " was created while the partitions run");
+  LogicalProcess *dst = context == Simulator::NO_CONTEXT ? m_global : m_lps[GetPartition (context)];
+  if (dst == lp)
+    {
+      Insert (lp, ev);
+      return;
+    }
+  if (ev.key.m_ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event for context " << context << " scheduled from context "
+                      << lp->currentContext << " of another partition with delay "
+                      << delay.As (Time::NS) << ", which is shorter than the lookahead "
+                      << m_lookahead.As (Time::NS));
+    }
+  Message message;
+  message.lp = dst;
+  message.ev = ev;
+  lp->outbox.push_back (message);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  LogicalProcess *lp = GetCurrentLp ();
+  NS_ASSERT_MSG (lp != 0, "Simulator::ScheduleNow Thread-unsafe invocation!");
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = lp->currentTs;
+  ev.key.m_context = lp->currentContext;
+  Insert (lp, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_ASSERT_MSG (GetCurrentLp () == m_global, "Simulator::ScheduleDestroy Thread-unsafe invocation!");
+
+  EventId id (Ptr<EventImpl> (event, false), m_currentTs, 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  if (m_currentLp != 0)
+    {
+      return TimeStep (m_currentLp->currentTs);
+    }
+  return TimeStep (m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Now ().GetTimeStep ());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  LogicalProcess *lp = GetOwner (id);
+  NS_ASSERT_MSG (m_currentLp == 0 || m_currentLp == m_global || m_currentLp == lp,
+                 "Event removed from another partition");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  lp->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  lp->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  // The uids are only ordered within the list which owns the event.
+  const LogicalProcess *lp = GetOwner (id);
+  if (lp == 0)
+    {
+      return true;
+    }
+  if (id.GetTs () < lp->currentTs
+      || (id.GetTs () == lp->currentTs && id.GetUid () <= lp->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  if (m_currentLp != 0)
+    {
+      return m_currentLp->currentContext;
+    }
+  return m_global->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = m_global->eventCount;
+  for (std::vector<LogicalProcess *>::const_iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      count += (*i)->eventCount;
+    }
+  return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A conservative parallel simulator engine which runs groups of
+ * nodes on threads of a single process.
+ *
+ * Every event context (that is, every node id) belongs to a
+ * partition, set with SetPartition () before the simulation starts;
+ * contexts which were not assigned explicitly belong to partition 0.
+ * Each partition is a logical process with its own event list, clock
+ * and event uids.  Events scheduled without context (for example,
+ * from the main program) are global: they are executed alone, while
+ * no partition runs.
+ *
+ * The simulation advances in windows.  A window starts at the
+ * timestamp \f$t\f$ of the earliest pending event and ends at
+ * \f$t + L\f$, where \f$L\f$ is the Lookahead attribute, or at the next
+ * global event if that comes earlier.  All the partitions execute the
+ * events of the window concurrently, on NumThreads threads.  An event
+ * scheduled for a context of another partition is buffered in the
+ * outbox of its source partition and delivered at the end of the
+ * window, in partition order, so the results do not depend on the
+ * number of threads or on how the threads are interleaved.  An event
+ * scheduled for another partition must not fall inside the current
+ * window, which the simulator enforces with a fatal error: the
+ * Lookahead must thus not exceed the smallest delay of any interaction
+ * between partitions, such as the propagation delay between nodes of
+ * different partitions attached to a shared channel (see
+ * SpectrumChannel::GetMinimumPropagationDelay ()).
+ *
+ * The events of a partition may only touch the state of the nodes of
+ * that partition, and the objects shared between partitions (channels,
+ * propagation models, trace sinks) must be safe to use from several
+ * threads.  Since Ptr reference counts are not atomic in the default
+ * build, passing objects across partitions requires ns-3 to be built
+ * with atomic reference counts (\c --enable-atomic-refcount).
+ *
+ * Simulator::Stop () called from a partition takes effect at the end
+ * of the current window.  An EventId may only be cancelled, removed
+ * or checked from the partition which owns the event, or from the
+ * main program.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Assign a context to a partition.
+   *
+   * The partitions cannot be changed while the simulator runs.
+   *
+   * \param [in] context The context, usually a node id.
+   * \param [in] partition The partition.
+   */
+  static void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * Get the partition of a context.
+   *
+   * \param [in] context The context, usually a node id.
+   * \return The partition of the context, 0 if it was not assigned.
+   */
+  static uint32_t GetPartition (uint32_t context);
+  /** Forget all the partitions assigned with SetPartition (). */
+  static void ClearPartitions (void);
+
+private:
+  virtual void DoDispose (void);
+
+  struct LogicalProcess;
+
+  /** A message sent to another partition. */
+  struct Message
+  {
+    LogicalProcess *lp;                ///< The destination partition.
+    Scheduler::Event ev;               ///< The event, without uid.
+  };
+
+  /** A logical process: the events and the clock of a partition. */
+  struct LogicalProcess
+  {
+    Ptr<Scheduler> events;             ///< The event list.
+    uint32_t uid;                      ///< The next event uid.
+    uint32_t currentUid;               ///< The uid of the current event.
+    uint64_t currentTs;                ///< The timestamp of the current event.
+    uint32_t currentContext;           ///< The context of the current event.
+    uint64_t eventCount;               ///< The number of events executed.
+    int unscheduledEvents;             ///< The number of events in the list.
+    std::vector<Message> outbox;       ///< The messages sent during the window.
+  };
+
+  /**
+   * Get the logical process which runs on the calling thread.
+   * \return The current logical process, the global one on the main
+   * thread outside of a window, or 0 on a foreign thread.
+   */
+  LogicalProcess * GetCurrentLp (void) const;
+  /**
+   * Get the logical process which owns a context.
+   * \param [in] context The context.
+   * \return The logical process, created if needed.
+   */
+  LogicalProcess * GetLp (uint32_t context);
+  /**
+   * Create a logical process.
+   * \return The new logical process.
+   */
+  LogicalProcess * CreateLp (void);
+  /**
+   * Get the logical process which owns an event.
+   * \param [in] id The event.
+   * \return The logical process, or 0 if its partition does not exist.
+   */
+  LogicalProcess * GetOwner (const EventId &id) const;
+  /**
+   * Insert an event in a logical process and assign its uid.
+   * \param [in] lp The logical process.
+   * \param [in,out] ev The event.
+   */
+  void Insert (LogicalProcess *lp, Scheduler::Event &ev);
+  /** Move the events of the global list to the partitions which own their context. */
+  void DistributeEvents (void);
+  /**
+   * Execute the next event of a logical process.
+   * \param [in] lp The logical process.
+   */
+  void ProcessOneEvent (LogicalProcess *lp);
+  /** Execute the events of the current window in the partitions claimed by the calling thread. */
+  void ProcessWindow (void);
+  /** Deliver the messages sent during the last window. */
+  void DeliverMessages (void);
+  /** Insert the events scheduled by foreign threads. */
+  void ProcessEventsWithContext (void);
+  /** The loop of a worker thread. */
+  void WorkerLoop (void);
+  /**
+   * Get the timestamp of the earliest event of all the partitions.
+   * \return The timestamp, or the maximum value if there are no events.
+   */
+  uint64_t GetNextPartitionTs (void) const;
+
+  /** An event scheduled by a foreign thread. */
+  struct EventWithContext
+  {
+    uint32_t context;                  ///< The event context.
+    uint64_t timestamp;                ///< The event delay.
+    EventImpl *event;                  ///< The event implementation.
+  };
+  /** Container type for the events from foreign threads. */
+  typedef std::list<struct EventWithContext> EventsWithContext;
+  /** The events scheduled by foreign threads. */
+  EventsWithContext m_eventsWithContext;
+  /** Flag \c true if #m_eventsWithContext is empty. */
+  std::atomic<bool> m_eventsWithContextEmpty;
+  /** Mutex to control access to #m_eventsWithContext. */
+  std::mutex m_eventsWithContextMutex;
+
+  /** Container type for the destroy events. */
+  typedef std::list<EventId> DestroyEvents;
+  /** The destroy events. */
+  DestroyEvents m_destroyEvents;
+
+  ObjectFactory m_schedulerFactory;    ///< The factory of the event lists.
+  LogicalProcess *m_global;            ///< The global events.
+  std::vector<LogicalProcess *> m_lps; ///< The partitions.
+  uint64_t m_currentTs;                ///< The latest timestamp reached by all the partitions.
+  std::atomic<bool> m_stop;            ///< Flag calling for the end of the simulation.
+  std::thread::id m_main;              ///< The main thread.
+
+  Time m_lookahead;                    ///< The Lookahead attribute.
+  uint32_t m_numThreads;               ///< The NumThreads attribute.
+  uint64_t m_windowEnd;                ///< The end of the current window, exclusive.
+  std::vector<std::thread> m_threads;  ///< The worker threads.
+  std::atomic<uint32_t> m_generation;  ///< Incremented to start a window.
+  std::atomic<uint32_t> m_nextLp;      ///< The next partition to run in the window.
+  std::atomic<uint32_t> m_busyThreads; ///< The workers still running the window.
+  bool m_exit;                         ///< Flag asking the workers to return.
+  bool m_running;                      ///< Whether Run () executes the partitions.
+  uint32_t m_idleUid;                  ///< The first uid allocated since the last run.
+
+  /** The partition of each context, indexed by context. */
+  static std::vector<uint32_t> m_partitions;
+  /** The logical process running on the calling thread, if any. */
+  static thread_local LogicalProcess *m_currentLp;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
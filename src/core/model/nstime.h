@@ -99,6 +99,11 @@ class TimeWithUnit;
  * resolution.  Therefore the maximum possible duration of your simulation
  * if you use picoseconds is 2^64 ps = 2^24 s = 7 months, whereas,
  * had you used nanoseconds, you could have run for 584 years.
+ *
+ * The resolution can instead be fixed at build time (see FIXED_RESOLUTION).
+ * The conversions to and from integers and doubles in other units,
+ * such as GetSeconds() or MicroSeconds(), then reduce to a multiplication
+ * or a division by a constant.
  */
 class Time
 {
@@ -434,6 +439,9 @@ public:
    * Change the global resolution used to convert all
    * user-provided time values in Time objects and Time objects
    * in user-expected time units.
+   *
+   * If the resolution is fixed at build time, only that resolution
+   * is accepted.
    */
   static void SetResolution (enum Unit resolution);
   /**
@@ -441,6 +449,18 @@ public:
    */
   static enum Unit GetResolution (void);
 
+#ifdef NS3_TIME_RESOLUTION
+  /**
+   * The resolution fixed at build time by the \c NS3_TIME_RESOLUTION
+   * CMake variable or the \c --time-resolution waf option.
+   *
+   * The integer and double conversions to and from the other units
+   * then multiply or divide by compile-time constants instead of
+   * looking up the conversion table and going through int64x64_t.
+   */
+  static constexpr enum Unit FIXED_RESOLUTION = NS3_TIME_RESOLUTION;
+#endif
+
 
   /**
    *  Create a Time in the current unit.
@@ -467,6 +487,13 @@ public:
    */
   inline static Time FromInteger (uint64_t value, enum Unit unit)
   {
+#ifdef NS3_TIME_RESOLUTION
+    if (unit <= FIXED_RESOLUTION)
+      {
+        return Time (value * GetFactor (unit, FIXED_RESOLUTION));
+      }
+    return Time (value / GetFactor (unit, FIXED_RESOLUTION));
+#else
     struct Information *info = PeekInformation (unit);
     if (info->fromMul)
       {
@@ -477,10 +504,19 @@ public:
         value /= info->factor;
       }
     return Time (value);
+#endif
   }
   inline static Time FromDouble (double value, enum Unit unit)
   {
+#ifdef NS3_TIME_RESOLUTION
+    if (unit <= FIXED_RESOLUTION)
+      {
+        return Time (value * GetFactor (unit, FIXED_RESOLUTION));
+      }
+    return Time (value / GetFactor (unit, FIXED_RESOLUTION));
+#else
     return From (int64x64_t (value), unit);
+#endif
   }
   inline static Time From (const int64x64_t & value, enum Unit unit)
   {
@@ -515,6 +551,13 @@ public:
    */
   inline int64_t ToInteger (enum Unit unit) const
   {
+#ifdef NS3_TIME_RESOLUTION
+    if (unit <= FIXED_RESOLUTION)
+      {
+        return m_data / GetFactor (unit, FIXED_RESOLUTION);
+      }
+    return m_data * GetFactor (unit, FIXED_RESOLUTION);
+#else
     struct Information *info = PeekInformation (unit);
     int64_t v = m_data;
     if (info->toMul)
@@ -526,10 +569,19 @@ public:
         v /= info->factor;
       }
     return v;
+#endif
   }
   inline double ToDouble (enum Unit unit) const
   {
+#ifdef NS3_TIME_RESOLUTION
+    if (unit <= FIXED_RESOLUTION)
+      {
+        return static_cast<double> (m_data) / GetFactor (unit, FIXED_RESOLUTION);
+      }
+    return static_cast<double> (m_data) * GetFactor (unit, FIXED_RESOLUTION);
+#else
     return To (unit).GetDouble ();
+#endif
   }
   inline int64x64_t To (enum Unit unit) const
   {
@@ -616,6 +668,33 @@ private:
   {
     return &(PeekResolution ()->info[timeUnit]);
   }
+  /**
+   *  Get the conversion factor between two units, as computed at run
+   *  time by SetResolution().
+   *
+   *  \param [in] unit The unit to convert from or to.
+   *  \param [in] resolution The resolution.
+   *  \return The number of \pname{resolution} in one \pname{unit} if
+   *          \pname{unit} is coarser, else the number of \pname{unit} in
+   *          one \pname{resolution}.
+   */
+  static constexpr int64_t GetFactor (enum Unit unit, enum Unit resolution)
+  {
+    // Same as UNIT_POWER and UNIT_COEFF in time.cc
+    constexpr int8_t power[LAST] = { 17, 17, 17, 16, 15, 12, 9, 6, 3, 0 };
+    constexpr int32_t coeff[LAST] = { 315360, 864, 36, 6, 1, 1, 1, 1, 1, 1 };
+    int64_t factor = unit <= resolution
+      ? coeff[unit] / coeff[resolution]
+      : coeff[resolution] / coeff[unit];
+    int shift = unit <= resolution
+      ? power[unit] - power[resolution]
+      : power[resolution] - power[unit];
+    for (int i = 0; i < shift; ++i)
+      {
+        factor *= 10;
+      }
+    return factor;
+  }
 
   /**
    *  Set the default resolution
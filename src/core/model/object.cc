@@ -97,11 +97,11 @@ Object::Object ()
   : m_tid (Object::GetTypeId ()),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  m_aggregates->index = 0;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object ()
@@ -120,6 +120,9 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the index may refer to this object
+  std::free (m_aggregates->index);
+  m_aggregates->index = 0;
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -132,10 +135,10 @@ Object::Object (const Object &o)
   : m_tid (o.m_tid),
     m_disposed (false),
     m_initialized (false),
-    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates))),
-    m_getObjectCount (0)
+    m_aggregates ((struct Aggregates *) std::malloc (sizeof (struct Aggregates)))
 {
   m_aggregates->n = 1;
+  m_aggregates->index = 0;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -145,39 +148,79 @@ Object::Construct (const AttributeConstructionList &attributes)
   ConstructSelf (attributes);
 }
 
-Ptr<Object>
+Object *
 Object::DoGetObject (TypeId tid) const
 {
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
-  uint32_t n = m_aggregates->n;
+  // The index is built on the first lookup after the aggregate changed.
+  if (m_aggregates->index == 0)
+    {
+      m_aggregates->index = CreateIndex (m_aggregates);
+    }
+  const struct AggregatesIndex *index = m_aggregates->index;
+  uint16_t uid = tid.GetUid ();
+  uint32_t i = uid & index->mask;
+  while (index->entries[i].uid != 0)
+    {
+      if (index->entries[i].uid == uid)
+        {
+          return index->entries[i].object;
+        }
+      i = (i + 1) & index->mask;
+    }
+  return 0;
+}
+struct Object::AggregatesIndex *
+Object::CreateIndex (const struct Aggregates *aggregates)
+{
+  NS_LOG_FUNCTION (aggregates);
+  // Gather the TypeIds of the objects and of their parents, in the
+  // order of the aggregates: the first object matching a TypeId wins.
   TypeId objectTid = Object::GetTypeId ();
-  for (uint32_t i = 0; i < n; i++)
+  std::vector<std::pair<uint16_t, Object *> > types;
+  for (uint32_t i = 0; i < aggregates->n; i++)
     {
-      Object *current = m_aggregates->buffer[i];
+      Object *current = aggregates->buffer[i];
       TypeId cur = current->GetInstanceTypeId ();
-      while (cur != tid && cur != objectTid)
+      types.push_back (std::make_pair (cur.GetUid (), current));
+      while (cur != objectTid && cur.HasParent ())
         {
           cur = cur.GetParent ();
+          types.push_back (std::make_pair (cur.GetUid (), current));
+        }
+    }
+
+  // Keep the table at most half full, so that the probes are short
+  // and always reach an empty entry.
+  uint32_t size = 8;
+  while (size < 2 * types.size ())
+    {
+      size *= 2;
+    }
+  struct AggregatesIndex *index =
+    (struct AggregatesIndex *)std::malloc (sizeof(struct AggregatesIndex) + (size - 1) * sizeof(struct AggregatesIndex::Entry));
+  index->mask = size - 1;
+  for (uint32_t i = 0; i < size; i++)
+    {
+      index->entries[i].uid = 0;
+      index->entries[i].object = 0;
+    }
+  for (std::vector<std::pair<uint16_t, Object *> >::const_iterator j = types.begin (); j != types.end (); ++j)
+    {
+      uint32_t i = j->first & index->mask;
+      while (index->entries[i].uid != 0 && index->entries[i].uid != j->first)
+        {
+          i = (i + 1) & index->mask;
         }
-      if (cur == tid)
+      if (index->entries[i].uid == 0)
         {
-          // This is an attempt to 'cache' the result of this lookup.
-          // the idea is that if we perform a lookup for a TypeId on this object,
-          // we are likely to perform the same lookup later so, we make sure
-          // that the aggregate array is sorted by the number of accesses
-          // to each object.
-
-          // first, increment the access count
-          current->m_getObjectCount++;
-          // then, update the sort
-          UpdateSortedArray (m_aggregates, i);
-          // finally, return the match
-          return const_cast<Object *> (current);
+          index->entries[i].uid = j->first;
+          index->entries[i].object = j->second;
         }
     }
-  return 0;
+  return index;
 }
 void
 Object::Initialize (void)
@@ -236,19 +279,6 @@ restart:
     }
 }
 void
-Object::UpdateSortedArray (struct Aggregates *aggregates, uint32_t j) const
-{
-  NS_LOG_FUNCTION (this << aggregates << j);
-  while (j > 0
-         && aggregates->buffer[j]->m_getObjectCount > aggregates->buffer[j - 1]->m_getObjectCount)
-    {
-      Object *tmp = aggregates->buffer[j - 1];
-      aggregates->buffer[j - 1] = aggregates->buffer[j];
-      aggregates->buffer[j] = tmp;
-      j--;
-    }
-}
-void
 Object::AggregateObject (Ptr<Object> o)
 {
   NS_LOG_FUNCTION (this << o);
@@ -263,6 +293,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates =
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates) + (total - 1) * sizeof(Object*));
   aggregates->n = total;
+  aggregates->index = 0;
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0],
@@ -281,7 +312,6 @@ Object::AggregateObject (Ptr<Object> o)
                           other->GetInstanceTypeId () <<
                           " on objects of type " << typeId);
         }
-      UpdateSortedArray (aggregates, m_aggregates->n + i);
     }
 
   // keep track of the old aggregate buffers for the iteration
@@ -314,7 +344,9 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
+  std::free (a->index);
   std::free (a);
+  std::free (b->index);
   std::free (b);
 }
 /**
@@ -342,21 +342,57 @@ private:
    * variable sized buffer whose size is indicated by the element
    * \c n
    */
+  struct AggregatesIndex;
   struct Aggregates
   {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The index of the Objects by TypeId, or 0 until the first lookup. */
+    struct AggregatesIndex *index;
     /** The array of Objects. */
     Object *buffer[1];
   };
 
+  /**
+   * The Objects of an aggregate indexed by TypeId, so that a lookup
+   * is a single probe in the common case.
+   *
+   * This is an open addressing hash table, with linear probing,
+   * keyed by TypeId uid.  It maps the TypeId of every aggregated
+   * Object, and all the parents of that TypeId, to the first Object
+   * of the aggregate with that TypeId.  It uses the same allocation
+   * trick as Aggregates.
+   */
+  struct AggregatesIndex
+  {
+    /** The number of entries of \c entries, minus one: it is a power of two. */
+    uint32_t mask;
+    /** An entry of the table. */
+    struct Entry
+    {
+      /** The TypeId uid, or 0 if the entry is empty. */
+      uint16_t uid;
+      /** The Object. */
+      Object *object;
+    };
+    /** The entries. */
+    struct Entry entries[1];
+  };
+
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
    *
    * \param [in] tid The TypeId we're looking for
    * \return The matching Object, if it is found
    */
-  Ptr<Object> DoGetObject (TypeId tid) const;
+  Object * DoGetObject (TypeId tid) const;
+  /**
+   * Index the Objects of an aggregate.
+   *
+   * \param [in] aggregates The list of aggregated Objects.
+   * \return The new index.
+   */
+  static struct AggregatesIndex * CreateIndex (const struct Aggregates *aggregates);
   /**
    * Verify that this Object is still live, by checking it's reference count.
    * \return \c true if the reference count is non zero.
@@ -397,13 +433,6 @@ private:
   */
   void Construct (const AttributeConstructionList &attributes);
 
-  /**
-   * Keep the list of aggregates in most-recently-used order
-   *
-   * \param [in,out] aggregates The list of aggregated Objects.
-   * \param [in] i The most recently used entry in the list.
-   */
-  void UpdateSortedArray (struct Aggregates *aggregates, uint32_t i) const;
   /**
    * Attempt to delete this Object.
    *
@@ -435,14 +464,6 @@ private:
    * so the size of the array is indirectly a reference count.
    */
   struct Aggregates * m_aggregates;
-  /**
-   * The number of times the Object was accessed with a
-   * call to GetObject().
-   *
-   * This integer is used to implement a heuristic to sort
-   * the array of aggregates in most-frequently accessed order.
-   */
-  uint32_t m_getObjectCount;
 };
 
 template <typename T>
@@ -469,20 +490,14 @@ template <typename T>
 Ptr<T>
 Object::GetObject () const
 {
-  // This is an optimization: if the cast works (which is likely),
-  // things will be pretty fast.
-  T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
-  if (result != 0)
-    {
-      return Ptr<T> (result);
-    }
-  // if the cast does not work, we try to do a full type check.
-  Ptr<Object> found = DoGetObject (T::GetTypeId ());
+  Object *found = DoGetObject (T::GetTypeId ());
   if (found != 0)
     {
-      return Ptr<T> (static_cast<T *> (PeekPointer (found)));
+      return Ptr<T> (static_cast<T *> (found));
     }
-  return 0;
+  // The TypeId hierarchy of some classes does not follow their C++
+  // hierarchy: fall back to a cast of the first Object.
+  return Ptr<T> (dynamic_cast<T *> (m_aggregates->buffer[0]));
 }
 
 /**
@@ -503,10 +518,10 @@ template <typename T>
 Ptr<T>
 Object::GetObject (TypeId tid) const
 {
-  Ptr<Object> found = DoGetObject (tid);
+  Object *found = DoGetObject (tid);
   if (found != 0)
     {
-      return Ptr<T> (static_cast<T *> (PeekPointer (found)));
+      return Ptr<T> (static_cast<T *> (found));
     }
   return 0;
 }
@@ -529,7 +544,7 @@ Object::GetObject (TypeId tid) const
     }
   else
     {
-      return DoGetObject (tid);
+      return Ptr<Object> (DoGetObject (tid));
     }
 }
 
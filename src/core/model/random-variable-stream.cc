@@ -132,6 +132,16 @@ RandomVariableStream::GetStream (void) const
   return m_stream;
 }
 
+void
+RandomVariableStream::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 RngStream *
 RandomVariableStream::Peek (void) const
 {
@@ -197,6 +207,23 @@ UniformRandomVariable::GetInteger (uint32_t min, uint32_t max)
   return static_cast<uint32_t> ( GetValue ((double) (min), (double) (max) + 1.0) );
 }
 
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n, double min, double max)
+{
+  NS_LOG_FUNCTION (this << values << n << min << max);
+  Peek ()->RandU01s (values, n);
+  bool isAntithetic = IsAntithetic ();
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      double v = min + values[i] * (max - min);
+      if (isAntithetic)
+        {
+          v = min + (max - v);
+        }
+      values[i] = v;
+    }
+}
+
 double
 UniformRandomVariable::GetValue (void)
 {
@@ -209,6 +236,12 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, std::size_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (values, n, m_min, m_max);
+}
 
 NS_OBJECT_ENSURE_REGISTERED (ConstantRandomVariable);
 
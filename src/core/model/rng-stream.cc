@@ -367,6 +367,57 @@ double RngStream::RandU01 ()
   return u;
 }
 
+void RngStream::RandU01s (double *values, std::size_t n)
+{
+  // Same recurrence as RandU01, on a local copy of the state
+  double s10 = m_currentState[0];
+  double s11 = m_currentState[1];
+  double s12 = m_currentState[2];
+  double s20 = m_currentState[3];
+  double s21 = m_currentState[4];
+  double s22 = m_currentState[5];
+
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      int32_t k;
+      double p1, p2;
+
+      /* Component 1 */
+      p1 = a12 * s11 - a13n * s10;
+      k = static_cast<int32_t> (p1 / m1);
+      p1 -= k * m1;
+      if (p1 < 0.0)
+        {
+          p1 += m1;
+        }
+      s10 = s11;
+      s11 = s12;
+      s12 = p1;
+
+      /* Component 2 */
+      p2 = a21 * s22 - a23n * s20;
+      k = static_cast<int32_t> (p2 / m2);
+      p2 -= k * m2;
+      if (p2 < 0.0)
+        {
+          p2 += m2;
+        }
+      s20 = s21;
+      s21 = s22;
+      s22 = p2;
+
+      /* Combination */
+      values[i] = ((p1 > p2) ? (p1 - p2) * norm : (p1 - p2 + m1) * norm);
+    }
+
+  m_currentState[0] = s10;
+  m_currentState[1] = s11;
+  m_currentState[2] = s12;
+  m_currentState[3] = s20;
+  m_currentState[4] = s21;
+  m_currentState[5] = s22;
+}
+
 RngStream::RngStream (uint32_t seedNumber, uint64_t stream, uint64_t substream)
 {
   if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
@@ -408,4 +459,150 @@ RngStream::AdvanceNthBy (uint64_t nth, int by, double state[6])
 
 } // namespace ns3
 
+/** Namespace for Philox4x32-10 implementation details. */
+namespace Philox4x32 {
+
+/** First multiplier. */
+const uint32_t m0 = 0xD2511F53;
+
+/** Second multiplier. */
+const uint32_t m1 = 0xCD9E8D57;
+
+/** First key increment, the golden ratio. */
+const uint32_t w0 = 0x9E3779B9;
+
+/** Second key increment, sqrt(3) - 1. */
+const uint32_t w1 = 0xBB67AE85;
+
+/** Number of rounds. */
+const int rounds = 10;
+
+/**
+ * Convert two random words to a double uniformly distributed in [0,1),
+ * with 53 random bits.
+ *
+ * \param [in] hi The most significant random word.
+ * \param [in] lo The least significant random word.
+ * \returns The random.
+ */
+inline double
+WordsToU01 (uint32_t hi, uint32_t lo)
+{
+  // 2^-53
+  const double norm = 1.0 / 9007199254740992.0;
+  return ((hi >> 5) * 67108864.0 + (lo >> 6)) * norm;
+}
+
+} // namespace Philox4x32
+
+
+namespace ns3 {
+
+void
+PhiloxStream::Block (const uint32_t counter[4], const uint32_t key[2], uint32_t block[4])
+{
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  for (int r = 0; r < Philox4x32::rounds; ++r)
+    {
+      if (r > 0)
+        {
+          k0 += Philox4x32::w0;
+          k1 += Philox4x32::w1;
+        }
+      uint64_t p0 = static_cast<uint64_t> (Philox4x32::m0) * c0;
+      uint64_t p1 = static_cast<uint64_t> (Philox4x32::m1) * c2;
+      uint32_t hi0 = static_cast<uint32_t> (p0 >> 32);
+      uint32_t lo0 = static_cast<uint32_t> (p0);
+      uint32_t hi1 = static_cast<uint32_t> (p1 >> 32);
+      uint32_t lo1 = static_cast<uint32_t> (p1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+    }
+  block[0] = c0;
+  block[1] = c1;
+  block[2] = c2;
+  block[3] = c3;
+}
+
+PhiloxStream::PhiloxStream (uint32_t seed, uint64_t stream, uint64_t substream)
+  : m_index (0)
+{
+  if (substream >> 32)
+    {
+      NS_FATAL_ERROR ("invalid substream " << substream);
+    }
+  m_key[0] = seed;
+  m_key[1] = static_cast<uint32_t> (stream >> 32);
+  m_counter[0] = static_cast<uint32_t> (substream);
+  m_counter[1] = static_cast<uint32_t> (stream);
+}
+
+double
+PhiloxStream::RandU01 (uint64_t index) const
+{
+  // Each block holds the randoms of two consecutive indices
+  uint64_t blockIndex = index >> 1;
+  uint32_t counter[4] = {static_cast<uint32_t> (blockIndex),
+                         static_cast<uint32_t> (blockIndex >> 32),
+                         m_counter[0], m_counter[1]};
+  uint32_t block[4];
+  Block (counter, m_key, block);
+  return (index & 1)
+         ? Philox4x32::WordsToU01 (block[2], block[3])
+         : Philox4x32::WordsToU01 (block[0], block[1]);
+}
+
+double
+PhiloxStream::RandU01 (void)
+{
+  return RandU01 (m_index++);
+}
+
+void
+PhiloxStream::RandU01s (double *values, std::size_t n)
+{
+  std::size_t i = 0;
+  if (n > 0 && (m_index & 1))
+    {
+      values[i++] = RandU01 (m_index++);
+    }
+  for (; i + 1 < n; i += 2)
+    {
+      uint64_t blockIndex = m_index >> 1;
+      uint32_t counter[4] = {static_cast<uint32_t> (blockIndex),
+                             static_cast<uint32_t> (blockIndex >> 32),
+                             m_counter[0], m_counter[1]};
+      uint32_t block[4];
+      Block (counter, m_key, block);
+      values[i] = Philox4x32::WordsToU01 (block[0], block[1]);
+      values[i + 1] = Philox4x32::WordsToU01 (block[2], block[3]);
+      m_index += 2;
+    }
+  if (i < n)
+    {
+      values[i] = RandU01 (m_index++);
+    }
+}
+
+void
+PhiloxStream::SetIndex (uint64_t index)
+{
+  m_index = index;
+}
+
+uint64_t
+PhiloxStream::GetIndex (void) const
+{
+  return m_index;
+}
+
+} // namespace ns3
+
 /**@}*/  // \ingroup rngimpl
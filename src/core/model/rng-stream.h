@@ -20,6 +20,7 @@
 #ifndef RNGSTREAM_H
 #define RNGSTREAM_H
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -70,6 +71,17 @@ public:
    * \returns The next random.
    */
   double RandU01 (void);
+  /**
+   * Generate the next random numbers for this stream.
+   *
+   * The numbers are the same as those returned by \pname{n} calls to
+   * RandU01, but the state of the generator is kept in registers
+   * for the whole batch.
+   *
+   * \param [out] values The array to fill with the next randoms.
+   * \param [in] n The number of randoms to generate.
+   */
+  void RandU01s (double *values, std::size_t n);
 
 private:
   /**
@@ -85,6 +97,86 @@ private:
   double m_currentState[6];
 };
 
+/**
+ * \ingroup rngimpl
+ *
+ * \brief Counter-based generator Philox4x32-10
+ *
+ * Unlike RngStream, this generator has no state to advance: the
+ * random number of index \pname{i} of a stream and substream is a
+ * function of the seed, the stream, the substream and \pname{i}.
+ * Several threads can therefore draw numbers from the same stream
+ * without sharing any state, and the numbers drawn do not depend on
+ * the order of the draws.  The details of this generator are
+ * explained in:
+ * J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw, "Parallel
+ * random numbers: as easy as 1, 2, 3", SC'11.
+ *
+ * The streams of this generator are not those of RngStream.
+ */
+class PhiloxStream
+{
+public:
+  /**
+   * Construct from explicit seed, stream and substream values.
+   *
+   * \param [in] seed The starting seed.
+   * \param [in] stream The stream number.
+   * \param [in] substream The sub-stream number, lower than 2<sup>32</sup>.
+   */
+  PhiloxStream (uint32_t seed, uint64_t stream, uint64_t substream);
+  /**
+   * Generate the random number of index \pname{index} of this stream.
+   * Uniformly distributed between 0 and 1.
+   *
+   * \param [in] index The index of the random.
+   * \returns The random.
+   */
+  double RandU01 (uint64_t index) const;
+  /**
+   * Generate the random number following the last one generated
+   * without an index.  Uniformly distributed between 0 and 1.
+   *
+   * \returns The next random.
+   */
+  double RandU01 (void);
+  /**
+   * Generate the next random numbers for this stream, as \pname{n}
+   * calls to RandU01() would do.
+   *
+   * \param [out] values The array to fill with the next randoms.
+   * \param [in] n The number of randoms to generate.
+   */
+  void RandU01s (double *values, std::size_t n);
+  /**
+   * Set the index of the next random returned by RandU01().
+   *
+   * \param [in] index The index.
+   */
+  void SetIndex (uint64_t index);
+  /**
+   * \returns The index of the next random returned by RandU01().
+   */
+  uint64_t GetIndex (void) const;
+
+  /**
+   * Compute one block of the Philox4x32-10 function.
+   *
+   * \param [in] counter The counter.
+   * \param [in] key The key.
+   * \param [out] block The four random words.
+   */
+  static void Block (const uint32_t counter[4], const uint32_t key[2], uint32_t block[4]);
+
+private:
+  /** The key, holding the seed and the most significant half of the stream. */
+  uint32_t m_key[2];
+  /** The substream and the least significant half of the stream. */
+  uint32_t m_counter[2];
+  /** The index of the next random returned by RandU01(). */
+  uint64_t m_index;
+};
+
 } // namespace ns3
 
 #endif
@@ -226,6 +226,12 @@ Simulator::ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *
 #endif
   return GetImpl ()->ScheduleWithContext (context, delay, impl);
 }
+void
+Simulator::ScheduleIndependent (uint32_t context, const Time &delay, EventImpl *impl)
+{
+  impl->SetIndependent ();
+  return ScheduleWithContext (context, delay, impl);
+}
 EventId
 Simulator::ScheduleDestroy (const Ptr<EventImpl> &ev)
 {
@@ -292,6 +292,42 @@ public:
    */
   template <typename... Us, typename... Ts>
   static void ScheduleWithContext (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args);
+
+  /**
+   * Schedule an independent event with the given context: the event
+   * only touches the state of its context, so that the simulator may
+   * run it concurrently with the independent events of other contexts
+   * with the same timestamp (see DefaultSimulatorImpl).  Otherwise, it
+   * behaves as ScheduleWithContext().
+   *
+   * We leverage SFINAE to discard this overload if the second argument is
+   * convertible to Ptr<EventImpl> or is a function pointer.
+   *
+   * @tparam FUNC @deduced Template type for the function to invoke.
+   * @tparam Ts @deduced Argument types.
+   * @param [in] context User-specified context parameter
+   * @param [in] delay The relative expiration time of the event.
+   * @param [in] f The function to invoke.
+   * @param [in] args Arguments to pass to MakeEvent.
+   */
+  template <typename FUNC,
+            typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type = 0,
+            typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type = 0,
+            typename... Ts>
+  static void ScheduleIndependent (uint32_t context, Time const &delay, FUNC f, Ts&&... args);
+
+  /**
+   * Schedule an independent event with the given context.
+   *
+   * @tparam Us @deduced Formal function argument types.
+   * @tparam Ts @deduced Actual function argument types.
+   * @param [in] context User-specified context parameter
+   * @param [in] delay The relative expiration time of the event.
+   * @param [in] f The function to invoke.
+   * @param [in] args Arguments to pass to the invoked function.
+   */
+  template <typename... Us, typename... Ts>
+  static void ScheduleIndependent (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args);
   /** @} */  // Schedule events (in a different context) to run now or at a future time.
 
   /**
@@ -468,6 +504,16 @@ public:
    */
   static void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
 
+  /**
+   * Schedule an independent event (in a different context).
+   * This method is thread-safe: it can be called from any thread.
+   *
+   * @param [in] delay Delay until the event expires.
+   * @param [in] context Event context.
+   * @param [in] event The event to schedule.
+   */
+  static void ScheduleIndependent (uint32_t context, const Time &delay, EventImpl *event);
+
   /**
    * Schedule an event to run at the end of the simulation, after
    * the Stop() time or condition has been reached.
@@ -580,6 +626,21 @@ void Simulator::ScheduleWithContext (uint32_t context, Time const &delay, void (
   return ScheduleWithContext (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
 }
 
+template <typename FUNC,
+          typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type,
+          typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type,
+          typename... Ts>
+void Simulator::ScheduleIndependent (uint32_t context, Time const &delay, FUNC f, Ts&&... args)
+{
+  return ScheduleIndependent (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
+template <typename... Us, typename... Ts>
+void Simulator::ScheduleIndependent (uint32_t context, Time const &delay, void (*f)(Us...), Ts&&... args)
+{
+  return ScheduleIndependent (context, delay, MakeEvent (f, std::forward<Ts> (args)...));
+}
+
 template <typename FUNC,
           typename std::enable_if<!std::is_convertible<FUNC, Ptr<EventImpl>>::value,int>::type,
           typename std::enable_if<!std::is_function<typename std::remove_pointer<FUNC>::type>::value,int>::type,
@@ -214,7 +214,11 @@ Time::SetDefaultNsResolution (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
   struct Resolution resolution;
+#ifdef NS3_TIME_RESOLUTION
+  SetResolution (FIXED_RESOLUTION, &resolution, false);
+#else
   SetResolution (Time::NS, &resolution, false);
+#endif
   return resolution;
 }
 
@@ -223,6 +227,10 @@ void
 Time::SetResolution (enum Unit resolution)
 {
   NS_LOG_FUNCTION (resolution);
+#ifdef NS3_TIME_RESOLUTION
+  NS_ABORT_MSG_IF (resolution != FIXED_RESOLUTION,
+                   "The Time resolution is fixed at build time");
+#endif
   SetResolution (resolution, PeekResolution ());
 }
 
@@ -21,8 +21,10 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
+#include "ptr.h"
+#include "simple-ref-count.h"
 
 /**
  * \file
@@ -44,7 +46,13 @@ namespace ns3 {
  *
  * This is a functor: the chain of Callbacks is invoked by
  * calling the \c operator() form with the appropriate
- * number of arguments.
+ * number of arguments.  The arguments are built by the caller
+ * even if no Callback is connected; use NS_TRACED_CALLBACK_FIRE
+ * when they are expensive to build.
+ *
+ * A Callback may connect or disconnect Callbacks, including itself,
+ * while the chain is invoked: the invocation in progress calls the
+ * chain as it was when it started.
  *
  * \tparam Ts \explicit Types of the functor arguments.
  */
@@ -109,16 +117,57 @@ public:
 private:
   /**
    * Container type for holding the chain of Callbacks.
+   * A vector, so that firing the chain walks contiguous memory.
    *
    * \tparam Ts \deduced Types of the functor arguments.
    */
-  typedef std::list<Callback<void,Ts...> > CallbackList;
-  /** The chain of Callbacks. */
-  CallbackList m_callbackList;
+  typedef std::vector<Callback<void,Ts...> > CallbackList;
+  /**
+   * The chain of Callbacks, shared with the firings in progress.
+   */
+  struct SharedCallbackList : public SimpleRefCount<SharedCallbackList>
+  {
+    CallbackList m_list; //!< The Callbacks.
+  };
+  /**
+   * Get the chain of Callbacks for modification.
+   *
+   * The chain is copied first if a firing in progress holds it,
+   * so that the firing is not affected by the modification.
+   *
+   * \return The chain of Callbacks.
+   */
+  CallbackList & GetWritableList (void);
+  /** The chain of Callbacks, or null if none was ever connected. */
+  Ptr<SharedCallbackList> m_callbackList;
 };
 
 } // namespace ns3
 
+/**
+ * \ingroup tracing
+ * Invoke the chain of Callbacks of a TracedCallback, evaluating
+ * the arguments only if at least one Callback is connected.
+ *
+ * A disconnected trace source then costs a single test, whatever
+ * the cost of building the arguments of the trace:
+ * \code
+ *   NS_TRACED_CALLBACK_FIRE (m_rxTrace, packet->Copy (), GetTxVector ());
+ * \endcode
+ *
+ * \param [in] trace The TracedCallback.
+ * \param [in] ... The arguments to the functor.
+ */
+#define NS_TRACED_CALLBACK_FIRE(trace, ...)     \
+  do                                            \
+    {                                           \
+      if (!(trace).IsEmpty ())                  \
+        {                                       \
+          (trace) (__VA_ARGS__);                \
+        }                                       \
+    }                                           \
+  while (false)
+
 
 /********************************************************************
  *  Implementation of the templates declared above.
@@ -131,6 +180,20 @@ TracedCallback<Ts...>::TracedCallback ()
   : m_callbackList ()
 {}
 template<typename... Ts>
+typename TracedCallback<Ts...>::CallbackList &
+TracedCallback<Ts...>::GetWritableList (void)
+{
+  if (m_callbackList == 0)
+    {
+      m_callbackList = Create<SharedCallbackList> ();
+    }
+  else if (m_callbackList->GetReferenceCount () > 1)
+    {
+      m_callbackList = Create<SharedCallbackList> (*m_callbackList);
+    }
+  return m_callbackList->m_list;
+}
+template<typename... Ts>
 void
 TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
 {
@@ -139,7 +202,7 @@ TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
     {
       NS_FATAL_ERROR_NO_MSG ();
     }
-  m_callbackList.push_back (cb);
+  GetWritableList ().push_back (cb);
 }
 template<typename... Ts>
 void
@@ -151,24 +214,31 @@ TracedCallback<Ts...>::Connect (const CallbackBase & callback, std::string path)
       NS_FATAL_ERROR ("when connecting to " << path);
     }
   Callback<void,Ts...> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  GetWritableList ().push_back (realCb);
 }
 template<typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext (const CallbackBase & callback)
 {
-  for (typename CallbackList::iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); /* empty */)
+  if (IsEmpty ())
     {
-      if ((*i).IsEqual (callback))
-        {
-          i = m_callbackList.erase (i);
-        }
-      else
+      return;
+    }
+  CallbackList & callbackList = GetWritableList ();
+  typename CallbackList::iterator last = callbackList.begin ();
+  for (typename CallbackList::iterator i = callbackList.begin ();
+       i != callbackList.end (); i++)
+    {
+      if (!(*i).IsEqual (callback))
         {
-          i++;
+          if (last != i)
+            {
+              *last = *i;
+            }
+          last++;
         }
     }
+  callbackList.erase (last, callbackList.end ());
 }
 template<typename... Ts>
 void
@@ -186,10 +256,17 @@ template<typename... Ts>
 void
 TracedCallback<Ts...>::operator() (Ts... args) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  // Fire a snapshot of the chain: a Callback may connect or disconnect
+  // Callbacks, itself included, which then copies the chain and only
+  // takes effect from the next firing.
+  Ptr<const SharedCallbackList> snapshot = m_callbackList;
+  if (snapshot == 0)
+    {
+      return;
+    }
+  for (const Callback<void,Ts...> & cb : snapshot->m_list)
     {
-      (*i)(args...);
+      cb (args...);
     }
 }
 
@@ -197,7 +274,7 @@ template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty () const
 {
-  return m_callbackList.empty ();
+  return m_callbackList == 0 || m_callbackList->m_list.empty ();
 }
 
 } // namespace ns3
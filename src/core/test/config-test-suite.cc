@@ -840,6 +840,148 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for the compiled Config paths and the BulkConnector.
+ */
+class BulkConnectorConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  BulkConnectorConfigTestCase ();
+  /** Destructor. */
+  virtual ~BulkConnectorConfigTestCase ()
+  {}
+
+  /**
+   * Trace callback without context.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Trace (int16_t oldValue, int16_t newValue)
+  {
+    NS_UNUSED (oldValue);
+    m_newValue = newValue;
+    m_count++;
+  }
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  {
+    NS_UNUSED (old);
+    m_newValue = newValue;
+    m_path = path;
+    m_count++;
+  }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+  uint32_t m_count;   //!< Number of trace callbacks invoked.
+};
+
+BulkConnectorConfigTestCase::BulkConnectorConfigTestCase ()
+  : TestCase ("Check the compiled Config paths and the connection of several paths in a single walk")
+{}
+
+void
+BulkConnectorConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+  a->SetNodeB (b);
+  Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject> ();
+  Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject> ();
+  b->AddNodeB (obj0);
+  b->AddNodeB (obj1);
+  b->AddNodeB (obj2);
+
+  //
+  // A compiled path is split once, and can be set repeatedly.
+  //
+  Config::Path path ("/NodeA/NodeB/NodesB/[0-1]/A");
+  NS_TEST_ASSERT_MSG_EQ (path.GetTokenN (), 4, "Unexpected number of path elements");
+  NS_TEST_ASSERT_MSG_EQ (path.GetToken (2), "NodesB", "Unexpected path element");
+  NS_TEST_ASSERT_MSG_EQ (path.GetRoot (), "/NodeA/NodeB/NodesB/[0-1]", "Unexpected path of the objects");
+  NS_TEST_ASSERT_MSG_EQ (path.GetLeaf (), "A", "Unexpected attribute name");
+  path.Set (IntegerValue (-7));
+  obj0->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), -7, "Object Attribute \"A\" not set as expected");
+  obj1->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), -7, "Object Attribute \"A\" not set as expected");
+  obj2->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 10, "Object Attribute \"A\" unexpectedly set");
+
+  //
+  // Connect the sources of two paths sharing their first elements, and of
+  // a path starting from the object name service.
+  //
+  Names::Add ("Bulk", obj2);
+  Config::BulkConnector connector;
+  connector.Add ("/NodeA/NodeB/NodesB/[0-1]/Source",
+                 MakeCallback (&BulkConnectorConfigTestCase::TraceWithPath, this));
+  connector.AddWithoutContext ("/NodeA/NodeB/NodesB/0/Source",
+                               MakeCallback (&BulkConnectorConfigTestCase::Trace, this));
+  connector.Add (Config::Path ("/Names/Bulk/Source"),
+                 MakeCallback (&BulkConnectorConfigTestCase::TraceWithPath, this));
+  NS_TEST_ASSERT_MSG_EQ (connector.GetN (), 3, "Unexpected number of sinks");
+  NS_TEST_ASSERT_MSG_EQ (connector.ConnectFailSafe (), true, "Could not connect all the sinks");
+
+  m_newValue = 0;
+  m_path = "";
+  obj1->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -2, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/1/Source", "Trace 1 did not provide expected context");
+
+  m_newValue = 0;
+  m_path = "";
+  obj2->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -3, "Trace 2 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/Names/Bulk/Source", "Trace 2 did not provide expected context");
+
+  //
+  // Both sinks of index 0 fire.
+  //
+  m_newValue = 0;
+  m_path = "";
+  m_count = 0;
+  obj0->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -5, "Trace 0 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/NodeA/NodeB/NodesB/0/Source", "Trace 0 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 2, "Both sinks of trace 0 did not fire");
+
+  //
+  // A path which does not match any trace source fails, but the other
+  // sinks are connected.
+  //
+  Config::BulkConnector failing;
+  failing.AddWithoutContext ("/NodeA/NodeB/NodesB/2/Missing",
+                             MakeCallback (&BulkConnectorConfigTestCase::Trace, this));
+  failing.AddWithoutContext ("/NodeA/NodeB/NodesB/2/Source",
+                             MakeCallback (&BulkConnectorConfigTestCase::Trace, this));
+  NS_TEST_ASSERT_MSG_EQ (failing.ConnectFailSafe (), false, "Unexpected connection to a missing trace source");
+
+  m_newValue = 0;
+  m_path = "";
+  obj2->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -4, "Trace 2 did not fire as expected");
+
+  Names::Clear ();
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +1000,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new BulkConnectorConfigTestCase);
 }
 
 /**
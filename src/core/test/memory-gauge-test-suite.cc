@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/memory-gauge.h"
+#include "ns3/memory-reporter.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/test.h"
+#include <complex>
+#include <sstream>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup memory
+ * \ingroup memory-tests
+ *
+ * MemoryGauge and MemoryReporter test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup memory-tests Memory accounting tests
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup memory-tests
+ * Check the counters, the registry and the heap footprint helpers.
+ */
+class MemoryGaugeTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MemoryGaugeTestCase ();
+  virtual void DoRun (void);
+};
+
+MemoryGaugeTestCase::MemoryGaugeTestCase ()
+  : TestCase ("Check the memory gauge counters")
+{}
+
+void
+MemoryGaugeTestCase::DoRun (void)
+{
+  MemoryGauge::Disable ();
+  {
+    MemoryGauge gauge ("memory-tests", "b");
+    MemoryGauge other ("memory-tests", "a");
+
+    gauge.Add (100);
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetBytes (), 0, "Disabled gauge was updated");
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetCount (), 0, "Disabled gauge was updated");
+
+    MemoryGauge::Enable ();
+    NS_TEST_ASSERT_MSG_EQ (MemoryGauge::IsEnabled (), true, "Accounting not enabled");
+    gauge.Add (100);
+    gauge.Add (300, 2);
+    gauge.Remove (150);
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetBytes (), 250, "Wrong number of bytes");
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetCount (), 2, "Wrong number of elements");
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetPeakBytes (), 400, "Wrong peak");
+    NS_TEST_ASSERT_MSG_EQ (other.GetBytes (), 0, "Gauges are not independent");
+
+    NS_TEST_ASSERT_MSG_EQ (MemoryGauge::Find ("memory-tests", "b"), &gauge,
+                           "Gauge not registered");
+    NS_TEST_ASSERT_MSG_EQ (MemoryGauge::Find ("memory-tests", "c"), nullptr,
+                           "Found a gauge which does not exist");
+    std::vector<const MemoryGauge *> gauges = MemoryGauge::GetGauges ();
+    std::size_t a = 0;
+    std::size_t b = 0;
+    for (std::size_t i = 0; i < gauges.size (); ++i)
+      {
+        if (gauges[i] == &other)
+          {
+            a = i;
+          }
+        else if (gauges[i] == &gauge)
+          {
+            b = i;
+          }
+      }
+    NS_TEST_ASSERT_MSG_LT (a, b, "Gauges are not sorted by name");
+
+    std::ostringstream oss;
+    MemoryGauge::Print (oss);
+    NS_TEST_ASSERT_MSG_NE (oss.str ().find ("memory-tests"), std::string::npos,
+                           "Gauge not printed");
+
+    gauge.Reset ();
+    NS_TEST_ASSERT_MSG_EQ (gauge.GetPeakBytes (), 0, "Peak not reset");
+    MemoryGauge::Disable ();
+  }
+  NS_TEST_ASSERT_MSG_EQ (MemoryGauge::Find ("memory-tests", "b"), nullptr,
+                         "Gauge not unregistered");
+
+  std::vector<double> doubles;
+  doubles.reserve (10);
+  NS_TEST_ASSERT_MSG_EQ (GetHeapBytes (doubles), 10 * sizeof (double),
+                         "Wrong footprint of a vector");
+  std::vector<std::vector<std::complex<double> > > matrix (3);
+  for (auto & row : matrix)
+    {
+      row.resize (4);
+      row.shrink_to_fit ();
+    }
+  matrix.shrink_to_fit ();
+  NS_TEST_ASSERT_MSG_EQ (GetHeapBytes (matrix),
+                         3 * sizeof (std::vector<std::complex<double> >)
+                         + 12 * sizeof (std::complex<double>),
+                         "Wrong footprint of a nested vector");
+  NS_TEST_ASSERT_MSG_EQ (GetHeapBytes (1.0), 0, "Wrong footprint of a number");
+}
+
+
+/**
+ * \ingroup memory-tests
+ * Check that the reporter fires its trace sources periodically.
+ */
+class MemoryReporterTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MemoryReporterTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Record the value of the test gauge.
+   * \param [in] subsystem The subsystem of the gauge.
+   * \param [in] name The name of the gauge.
+   * \param [in] bytes The number of bytes.
+   * \param [in] count The number of elements.
+   */
+  void GaugeReported (const std::string & subsystem, const std::string & name,
+                      int64_t bytes, int64_t count);
+  /**
+   * Count the reports.
+   * \param [in] accounted The total number of bytes of the gauges.
+   * \param [in] resident The resident set size.
+   */
+  void TotalReported (int64_t accounted, int64_t resident);
+
+  std::vector<Time> m_times;      //!< The times of the test gauge reports.
+  std::vector<int64_t> m_bytes;   //!< The bytes of the test gauge reports.
+  uint32_t m_totals;              //!< The number of reports.
+};
+
+MemoryReporterTestCase::MemoryReporterTestCase ()
+  : TestCase ("Check the periodic memory reports"),
+    m_totals (0)
+{}
+
+void
+MemoryReporterTestCase::GaugeReported (const std::string & subsystem,
+                                       const std::string & name,
+                                       int64_t bytes, int64_t count)
+{
+  if (subsystem == "memory-tests" && name == "reported")
+    {
+      m_times.push_back (Simulator::Now ());
+      m_bytes.push_back (bytes);
+    }
+}
+
+void
+MemoryReporterTestCase::TotalReported (int64_t accounted, int64_t resident)
+{
+  ++m_totals;
+}
+
+void
+MemoryReporterTestCase::DoRun (void)
+{
+  MemoryGauge gauge ("memory-tests", "reported");
+  Ptr<MemoryReporter> reporter = CreateObject<MemoryReporter> ();
+  NS_TEST_ASSERT_MSG_EQ (MemoryGauge::IsEnabled (), true,
+                         "Reporter did not enable the accounting");
+  reporter->SetAttribute ("Interval", TimeValue (Seconds (2)));
+  reporter->DisableOutput ();
+  reporter->TraceConnectWithoutContext ("Gauge",
+                                        MakeCallback (&MemoryReporterTestCase::GaugeReported, this));
+  reporter->TraceConnectWithoutContext ("Total",
+                                        MakeCallback (&MemoryReporterTestCase::TotalReported, this));
+  reporter->Start ();
+
+  gauge.Add (1000);
+  Simulator::Schedule (Seconds (3), &MemoryGauge::Remove, &gauge, 400, 1);
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  reporter->Dispose ();
+  Simulator::Destroy ();
+  MemoryGauge::Disable ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_times.size (), 2, "Wrong number of reports");
+  NS_TEST_ASSERT_MSG_EQ (m_totals, 2, "Wrong number of total reports");
+  NS_TEST_ASSERT_MSG_EQ (m_times[0], Seconds (2), "Wrong time of the first report");
+  NS_TEST_ASSERT_MSG_EQ (m_times[1], Seconds (4), "Wrong time of the second report");
+  NS_TEST_ASSERT_MSG_EQ (m_bytes[0], 1000, "Wrong value in the first report");
+  NS_TEST_ASSERT_MSG_EQ (m_bytes[1], 600, "Wrong value in the second report");
+}
+
+
+/**
+ * \ingroup memory-tests
+ * MemoryGauge test suite
+ */
+class MemoryGaugeTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  MemoryGaugeTestSuite ()
+    : TestSuite ("memory-gauge")
+  {
+    AddTestCase (new MemoryGaugeTestCase ());
+    AddTestCase (new MemoryReporterTestCase ());
+  }
+};
+
+/**
+ * \ingroup memory-tests
+ * MemoryGaugeTestSuite instance variable.
+ */
+static MemoryGaugeTestSuite g_memoryGaugeTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/config.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * \ingroup simulator-tests
+ *
+ * Run chains of events which hop between contexts of different
+ * partitions, and check that the MultithreadedSimulatorImpl executes
+ * the same events at the same times as the DefaultSimulatorImpl, with
+ * results which do not depend on the number of threads.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// The events executed in a context: (time in ns, chain, hop)
+  typedef std::vector<std::pair<int64_t, std::pair<uint32_t, uint32_t> > > Trace;
+
+  /**
+   * Run the scenario.
+   * \param [in] type The simulator implementation.
+   * \param [in] threads The number of threads of the MultithreadedSimulatorImpl.
+   */
+  void RunScenario (std::string type, uint32_t threads);
+  /**
+   * A hop of a chain of events.
+   * \param [in] context The context of the event.
+   * \param [in] chain The chain.
+   * \param [in] hop The number of the hop in the chain.
+   */
+  void Hop (uint32_t context, uint32_t chain, uint32_t hop);
+  /**
+   * An event which is cancelled before it expires.
+   * \param [in] context The context of the event.
+   */
+  void Cancelled (uint32_t context);
+  /** A global event. */
+  void Global (void);
+
+  static const uint32_t N_CONTEXTS = 8;   //!< The number of contexts.
+  static const uint32_t N_PARTITIONS = 4; //!< The number of partitions.
+
+  std::vector<Trace> m_traces;            //!< The trace of each context.
+  std::vector<uint32_t> m_cancelled;      //!< The cancelled events executed in each context.
+  std::vector<uint32_t> m_beforeGlobal;   //!< The events running after the global event time before it.
+  bool m_globalDone;                      //!< Whether the global event ran.
+  int64_t m_globalNs;                     //!< The time of the global event.
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase ()
+  : TestCase ("Check that the partitions run the same events on any number of threads")
+{}
+
+void
+MultithreadedSimulatorTestCase::Hop (uint32_t context, uint32_t chain, uint32_t hop)
+{
+  NS_ASSERT (Simulator::GetContext () == context);
+  int64_t now = Simulator::Now ().GetNanoSeconds ();
+  m_traces[context].push_back (std::make_pair (now, std::make_pair (chain, hop)));
+  if (now >= 2000 && !m_globalDone)
+    {
+      m_beforeGlobal[context]++;
+    }
+  if (hop % 2 == 0)
+    {
+      EventId id = Simulator::Schedule (NanoSeconds (10), &MultithreadedSimulatorTestCase::Cancelled, this, context);
+      Simulator::Cancel (id);
+      Simulator::Schedule (NanoSeconds (37 + context), &MultithreadedSimulatorTestCase::Hop, this, context, chain, hop + 1);
+    }
+  else
+    {
+      // the delay to another partition is never shorter than the 100 ns lookahead
+      uint32_t next = (context + 1 + chain) % N_CONTEXTS;
+      Simulator::ScheduleWithContext (next, NanoSeconds (100 + 3 * context),
+                                      &MultithreadedSimulatorTestCase::Hop, this, next, chain, hop + 1);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::Cancelled (uint32_t context)
+{
+  m_cancelled[context]++;
+}
+
+void
+MultithreadedSimulatorTestCase::Global (void)
+{
+  m_globalNs = Simulator::Now ().GetNanoSeconds ();
+  m_globalDone = true;
+}
+
+void
+MultithreadedSimulatorTestCase::RunScenario (std::string type, uint32_t threads)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (type));
+  if (threads > 0)
+    {
+      Simulator::GetImplementation ()->SetAttribute ("Lookahead", TimeValue (NanoSeconds (100)));
+      Simulator::GetImplementation ()->SetAttribute ("NumThreads", UintegerValue (threads));
+    }
+  m_traces.assign (N_CONTEXTS, Trace ());
+  m_cancelled.assign (N_CONTEXTS, 0);
+  m_beforeGlobal.assign (N_CONTEXTS, 0);
+  m_globalDone = false;
+  m_globalNs = 0;
+
+  for (uint32_t chain = 0; chain < 3; chain++)
+    {
+      for (uint32_t context = 0; context < N_CONTEXTS; context++)
+        {
+          Simulator::ScheduleWithContext (context, NanoSeconds (chain * 5),
+                                          &MultithreadedSimulatorTestCase::Hop, this, context, chain, 0);
+        }
+    }
+  Simulator::Schedule (NanoSeconds (2000), &MultithreadedSimulatorTestCase::Global, this);
+  Simulator::Stop (NanoSeconds (10000));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now ().GetNanoSeconds (), 10000, "the simulator did not stop on time");
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_globalNs, 2000, "the global event did not run on time");
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_cancelled[context], 0u, "a cancelled event ran in context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_beforeGlobal[context], 0u, "an event ran before the global event in context " << context);
+      NS_TEST_EXPECT_MSG_GT (m_traces[context].size (), 10u, "too few events in context " << context);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      MultithreadedSimulatorImpl::SetPartition (context, context % N_PARTITIONS);
+    }
+
+  RunScenario ("ns3::DefaultSimulatorImpl", 0);
+  std::vector<Trace> reference = m_traces;
+
+  RunScenario ("ns3::MultithreadedSimulatorImpl", 1);
+  std::vector<Trace> oneThread = m_traces;
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      // events of different chains with the same timestamp may run in another order
+      Trace sorted = m_traces[context];
+      std::sort (sorted.begin (), sorted.end ());
+      std::sort (reference[context].begin (), reference[context].end ());
+      NS_TEST_EXPECT_MSG_EQ ((sorted == reference[context]), true,
+                             "context " << context << " differs from the DefaultSimulatorImpl");
+    }
+
+  RunScenario ("ns3::MultithreadedSimulatorImpl", 4);
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((m_traces[context] == oneThread[context]), true,
+                             "context " << context << " depends on the number of threads");
+    }
+
+  MultithreadedSimulatorImpl::ClearPartitions ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup simulator-tests
+ *
+ * MultithreadedSimulatorImpl test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorTestCase (), TestCase::QUICK);
+  }
+};
+
+/// Static variable for test initialization
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
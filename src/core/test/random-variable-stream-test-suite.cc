@@ -37,6 +37,7 @@
 #include "ns3/log.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/rng-stream.h"
 
 using namespace ns3;
 
@@ -2436,6 +2437,139 @@ NormalCachingTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_GT (v2, 0, "Incorrect value returned, expected > 0");
 }
 
+/**
+ * Test case for the random values drawn in batches.
+ */
+class BatchTestCase : public TestCaseBase
+{
+public:
+  // Constructor
+  BatchTestCase ();
+
+private:
+  // Inherited
+  virtual void DoRun (void);
+};
+
+BatchTestCase::BatchTestCase ()
+  : TestCaseBase ("Random values drawn in batches")
+{}
+
+void
+BatchTestCase::DoRun (void)
+{
+  NS_LOG_FUNCTION (this);
+  SetTestSuiteSeed ();
+
+  static const std::size_t N_VALUES {1001};
+  std::vector<double> values (N_VALUES);
+
+  // A batch of uniform values is the sequence of values drawn one by one.
+  Ptr<UniformRandomVariable> u1 = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> u2 = CreateObject<UniformRandomVariable> ();
+  u1->SetStream (100);
+  u2->SetStream (100);
+  u1->GetValues (&values[0], N_VALUES, -5, 5);
+  for (std::size_t i = 0; i < N_VALUES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[i], u2->GetValue (-5, 5), "Batch value " << i << " differs");
+    }
+  NS_TEST_ASSERT_MSG_EQ (u1->GetValue (), u2->GetValue (), "Stream not advanced by the batch");
+
+  // So is an antithetic one.
+  u1->SetAntithetic (true);
+  u2->SetAntithetic (true);
+  u1->GetValues (&values[0], N_VALUES);
+  for (std::size_t i = 0; i < N_VALUES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[i], u2->GetValue (), "Antithetic batch value " << i << " differs");
+    }
+
+  // The default batch draws the values of any distribution one by one.
+  Ptr<ExponentialRandomVariable> e1 = CreateObject<ExponentialRandomVariable> ();
+  Ptr<ExponentialRandomVariable> e2 = CreateObject<ExponentialRandomVariable> ();
+  e1->SetStream (101);
+  e2->SetStream (101);
+  e1->GetValues (&values[0], N_VALUES);
+  for (std::size_t i = 0; i < N_VALUES; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[i], e2->GetValue (), "Exponential batch value " << i << " differs");
+    }
+}
+
+/**
+ * Test case for the counter-based Philox4x32-10 generator.
+ */
+class PhiloxTestCase : public TestCaseBase
+{
+public:
+  // Constructor
+  PhiloxTestCase ();
+
+private:
+  // Inherited
+  virtual void DoRun (void);
+};
+
+PhiloxTestCase::PhiloxTestCase ()
+  : TestCaseBase ("Counter-based Philox4x32-10 generator")
+{}
+
+void
+PhiloxTestCase::DoRun (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  // Known answers of the Random123 reference implementation
+  const uint32_t counters[3][4] = {
+    {0, 0, 0, 0},
+    {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+    {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}
+  };
+  const uint32_t keys[3][2] = {
+    {0, 0},
+    {0xffffffff, 0xffffffff},
+    {0xa4093822, 0x299f31d0}
+  };
+  const uint32_t answers[3][4] = {
+    {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+  };
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      uint32_t block[4];
+      PhiloxStream::Block (counters[i], keys[i], block);
+      for (uint32_t j = 0; j < 4; ++j)
+        {
+          NS_TEST_ASSERT_MSG_EQ (block[j], answers[i][j], "Wrong word " << j << " of block " << i);
+        }
+    }
+
+  // The values drawn in sequence, in a batch, and by index are the same.
+  static const std::size_t N_VALUES {1001};
+  PhiloxStream sequence (1, 5, 3);
+  PhiloxStream batch (1, 5, 3);
+  batch.SetIndex (1);
+  std::vector<double> values (N_VALUES);
+  batch.RandU01s (&values[0], N_VALUES);
+  NS_TEST_ASSERT_MSG_EQ (batch.GetIndex (), N_VALUES + 1, "Index not advanced by the batch");
+  NS_TEST_ASSERT_MSG_EQ (sequence.RandU01 (), sequence.RandU01 (0), "Wrong first value");
+  for (std::size_t i = 0; i < N_VALUES; ++i)
+    {
+      double value = sequence.RandU01 ();
+      NS_TEST_ASSERT_MSG_EQ (values[i], value, "Batch value " << i << " differs");
+      NS_TEST_ASSERT_MSG_EQ (batch.RandU01 (i + 1), value, "Indexed value " << i << " differs");
+      NS_TEST_ASSERT_MSG_EQ ((value >= 0 && value < 1), true, "Value out of [0,1)");
+    }
+
+  // Other streams and substreams draw other values.
+  PhiloxStream otherStream (1, 6, 3);
+  PhiloxStream otherSubstream (1, 5, 4);
+  NS_TEST_ASSERT_MSG_NE (otherStream.RandU01 (7), sequence.RandU01 (7), "Streams not independent");
+  NS_TEST_ASSERT_MSG_NE (otherSubstream.RandU01 (7), sequence.RandU01 (7), "Substreams not independent");
+}
+
 /**
  * RandomVariableStream test suite, covering all random number variable
  * stream generator types.
@@ -2487,6 +2621,8 @@ RandomVariableSuite::RandomVariableSuite ()
   AddTestCase (new EmpiricalAntitheticTestCase);
   /// Issue #302:  NormalRandomVariable produces stale values
   AddTestCase (new NormalCachingTestCase);
+  AddTestCase (new BatchTestCase);
+  AddTestCase (new PhiloxTestCase);
 }
 
 static RandomVariableSuite randomVariableSuite;
@@ -24,6 +24,13 @@
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +472,150 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * Run rounds of independent events in several contexts, and check that
+ * the batches of the DefaultSimulatorImpl execute the same events as
+ * the sequential mode, with results which do not depend on the number
+ * of threads.
+ */
+class SimulatorBatchTestCase : public TestCase
+{
+public:
+  SimulatorBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// The events executed in a context: (time in ns, round)
+  typedef std::vector<std::pair<int64_t, uint32_t> > Trace;
+
+  /**
+   * Run the scenario.
+   * \param threads The BatchThreads attribute.
+   * \param checkRaces The CheckBatchRaces attribute.
+   */
+  void RunScenario (uint32_t threads, bool checkRaces);
+  /**
+   * An independent event.
+   * \param context The context of the event.
+   * \param round The round of the event.
+   */
+  void Rx (uint32_t context, uint32_t round);
+  /**
+   * An event scheduled by an independent event in the collector context.
+   * \param from The context of the scheduling event.
+   */
+  void Collect (uint32_t from);
+  /**
+   * An event which is removed before it expires.
+   * \param context The context of the event.
+   */
+  void Removed (uint32_t context);
+
+  static const uint32_t N_CONTEXTS = 8;  //!< The number of contexts.
+  static const uint32_t N_ROUNDS = 20;   //!< The number of rounds.
+
+  std::vector<Trace> m_traces;           //!< The trace of each context.
+  std::vector<uint32_t> m_wrongContext;  //!< The events of each context which saw another context.
+  std::vector<uint32_t> m_removed;       //!< The removed events executed in each context.
+  std::vector<uint32_t> m_collected;     //!< The sources of the events of the collector.
+};
+
+SimulatorBatchTestCase::SimulatorBatchTestCase ()
+  : TestCase ("Check that the batches of independent events run the same events on any number of threads")
+{}
+
+void
+SimulatorBatchTestCase::Rx (uint32_t context, uint32_t round)
+{
+  if (Simulator::GetContext () != context)
+    {
+      m_wrongContext[context]++;
+    }
+  m_traces[context].push_back (std::make_pair (Simulator::Now ().GetNanoSeconds (), round));
+  DefaultSimulatorImpl::NotifyAccess (context);
+  if (context == 0)
+    {
+      // a context which no other event touches
+      DefaultSimulatorImpl::NotifyAccess (1000);
+    }
+
+  EventId id = Simulator::Schedule (NanoSeconds (1), &SimulatorBatchTestCase::Removed, this, context);
+  Simulator::Remove (id);
+  Simulator::ScheduleWithContext (N_CONTEXTS, NanoSeconds (5), &SimulatorBatchTestCase::Collect, this, context);
+  if (round + 1 < N_ROUNDS)
+    {
+      // every third round, the odd contexts are late and form another batch
+      uint32_t delay = 10 + (round % 3 == 0 ? context % 2 : 0);
+      Simulator::ScheduleIndependent (context, NanoSeconds (delay), &SimulatorBatchTestCase::Rx, this, context, round + 1);
+    }
+}
+
+void
+SimulatorBatchTestCase::Collect (uint32_t from)
+{
+  m_collected.push_back (from);
+}
+
+void
+SimulatorBatchTestCase::Removed (uint32_t context)
+{
+  m_removed[context]++;
+}
+
+void
+SimulatorBatchTestCase::RunScenario (uint32_t threads, bool checkRaces)
+{
+  Simulator::GetImplementation ()->SetAttribute ("BatchThreads", UintegerValue (threads));
+  Simulator::GetImplementation ()->SetAttribute ("CheckBatchRaces", BooleanValue (checkRaces));
+  m_traces.assign (N_CONTEXTS, Trace ());
+  m_wrongContext.assign (N_CONTEXTS, 0);
+  m_removed.assign (N_CONTEXTS, 0);
+  m_collected.clear ();
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      Simulator::ScheduleIndependent (context, NanoSeconds (100), &SimulatorBatchTestCase::Rx, this, context, 0);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_wrongContext[context], 0u, "wrong context in context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_removed[context], 0u, "a removed event ran in context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_traces[context].size (), N_ROUNDS, "missing events in context " << context);
+    }
+}
+
+void
+SimulatorBatchTestCase::DoRun (void)
+{
+  RunScenario (0, false);
+  std::vector<Trace> reference = m_traces;
+  std::vector<uint32_t> sequential = m_collected;
+  std::sort (sequential.begin (), sequential.end ());
+
+  RunScenario (1, true);
+  std::vector<uint32_t> oneThread = m_collected;
+  std::vector<uint32_t> sorted = m_collected;
+  std::sort (sorted.begin (), sorted.end ());
+  NS_TEST_EXPECT_MSG_EQ ((sorted == sequential), true, "the batches did not schedule the same events");
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((m_traces[context] == reference[context]), true,
+                             "context " << context << " differs from the sequential mode");
+    }
+
+  RunScenario (4, true);
+  NS_TEST_EXPECT_MSG_EQ ((m_collected == oneThread), true, "the event order depends on the number of threads");
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((m_traces[context] == reference[context]), true,
+                             "context " << context << " depends on the number of threads");
+    }
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -483,5 +634,6 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorBatchTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -195,12 +195,14 @@ TimeSimpleTestCase::DoRun (void)
                          "is 1fs really 1fs ?");
 #endif
 
+#ifndef NS3_TIME_RESOLUTION
   Time ten = NanoSeconds (10);
   int64_t tenValue = ten.GetInteger ();
   Time::SetResolution (Time::PS);
   int64_t tenKValue = ten.GetInteger ();
   NS_TEST_ASSERT_MSG_EQ (tenValue * 1000, tenKValue,
                          "change resolution to PS");
+#endif
 }
 
 void
@@ -401,6 +403,61 @@ void
 TimeWithSignTestCase::DoTeardown (void)
 {}
 
+/**
+ * \ingroup core-tests
+ * \brief Time unit conversions, checked against the int64x64_t path
+ */
+class TimeUnitConversionTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor for TimeUnitConversionTestCase.
+   */
+  TimeUnitConversionTestCase ();
+
+private:
+  /**
+   * \brief DoRun for TimeUnitConversionTestCase.
+   */
+  virtual void DoRun (void);
+};
+
+TimeUnitConversionTestCase::TimeUnitConversionTestCase ()
+  : TestCase ("Unit conversions to and from integers and doubles")
+{}
+
+void
+TimeUnitConversionTestCase::DoRun (void)
+{
+  Time t = TimeStep (123456789012);
+  for (int i = 0; i < Time::LAST; i++)
+    {
+      Time::Unit unit = static_cast<Time::Unit> (i);
+      NS_TEST_EXPECT_MSG_EQ (t.ToInteger (unit), t.To (unit).GetHigh (),
+                             "ToInteger of unit " << i);
+      if (unit <= Time::GetResolution ())
+        {
+          // the int64x64_t inverse of the year is only accurate to a
+          // few ulps, so compare with the exact quotient instead
+          double steps = Time::FromInteger (1, unit).GetTimeStep ();
+          double expected = t.GetTimeStep () / steps;
+          NS_TEST_EXPECT_MSG_EQ_TOL (t.ToDouble (unit), expected, expected * 1e-14,
+                                     "ToDouble of unit " << i);
+          NS_TEST_EXPECT_MSG_EQ (Time::FromInteger (7, unit),
+                                 Time::From (int64x64_t (7), unit),
+                                 "FromInteger of unit " << i);
+          Time fromDouble = Time::FromDouble (2.5, unit);
+          NS_TEST_EXPECT_MSG_LT_OR_EQ (Abs (fromDouble - Time::From (int64x64_t (2.5), unit)).GetTimeStep (), 1,
+                                       "FromDouble of unit " << i);
+        }
+      else
+        {
+          NS_TEST_EXPECT_MSG_EQ (t.ToDouble (unit), static_cast<double> (t.ToInteger (unit)),
+                                 "ToDouble of unit " << i);
+        }
+    }
+}
+
 /**
  * \ingroup core-tests
  * \brief Input output Test Case for Time
@@ -546,6 +603,7 @@ public:
     : TestSuite ("time", UNIT)
   {
     AddTestCase (new TimeWithSignTestCase (), TestCase::QUICK);
+    AddTestCase (new TimeUnitConversionTestCase (), TestCase::QUICK);
     AddTestCase (new TimeInputOutputTestCase (), TestCase::QUICK);
     // This should be last, since it changes the resolution
     AddTestCase (new TimeSimpleTestCase (), TestCase::QUICK);
@@ -113,6 +113,122 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class FireTracedCallbackTestCase : public TestCase
+{
+public:
+  FireTracedCallbackTestCase ();
+  virtual ~FireTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  void CbOne (uint8_t a, double b);
+  void CbConnect (uint8_t a, double b);
+  void CbDisconnect (uint8_t a, double b);
+  double GetArgument (void);
+
+  TracedCallback<uint8_t, double> m_trace;
+  uint32_t m_one;
+  uint32_t m_disconnect;
+  uint32_t m_arguments;
+};
+
+FireTracedCallbackTestCase::FireTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback firing with and without connected Callbacks")
+{}
+
+void
+FireTracedCallbackTestCase::CbOne (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_one++;
+}
+
+void
+FireTracedCallbackTestCase::CbConnect (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_trace.ConnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbOne, this));
+}
+
+void
+FireTracedCallbackTestCase::CbDisconnect (uint8_t a, double b)
+{
+  NS_UNUSED (a);
+  NS_UNUSED (b);
+  m_disconnect++;
+  m_trace.DisconnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbDisconnect, this));
+}
+
+double
+FireTracedCallbackTestCase::GetArgument (void)
+{
+  m_arguments++;
+  return 2;
+}
+
+void
+FireTracedCallbackTestCase::DoRun (void)
+{
+  m_one = 0;
+  m_arguments = 0;
+
+  //
+  // The arguments of a trace with no connected Callback are not evaluated.
+  //
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Trace unexpectedly connected");
+  NS_TRACED_CALLBACK_FIRE (m_trace, 1, GetArgument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 0, "Arguments unexpectedly evaluated");
+
+  //
+  // A Callback connecting another one while the trace is fired does not
+  // invalidate the chain; the new Callback is called from the next firing.
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbConnect, this));
+  NS_TRACED_CALLBACK_FIRE (m_trace, 1, GetArgument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Arguments not evaluated");
+  NS_TEST_ASSERT_MSG_EQ (m_one, 0, "Callback CbOne called in the firing connecting it");
+  m_trace.DisconnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbConnect, this));
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Callback CbOne not called");
+
+  //
+  // Disconnecting removes every copy of a Callback, and keeps the others.
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbOne, this));
+  m_one = 0;
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_one, 2, "Callback CbOne not called twice");
+  m_trace.DisconnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbOne, this));
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), true, "Trace still connected");
+
+  //
+  // A Callback disconnecting itself while the trace is fired does not
+  // make the next Callback of the chain skipped.
+  //
+  m_trace.ConnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbDisconnect, this));
+  m_trace.ConnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbOne, this));
+  m_one = 0;
+  m_disconnect = 0;
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_disconnect, 1, "Callback CbDisconnect not called");
+  NS_TEST_ASSERT_MSG_EQ (m_one, 1, "Callback CbOne skipped");
+  m_trace (1, 2);
+  NS_TEST_ASSERT_MSG_EQ (m_disconnect, 1, "Callback CbDisconnect still connected");
+  NS_TEST_ASSERT_MSG_EQ (m_one, 2, "Callback CbOne not called");
+
+  //
+  // Modifying a copy of a TracedCallback does not modify the original.
+  //
+  TracedCallback<uint8_t, double> copy = m_trace;
+  copy.DisconnectWithoutContext (MakeCallback (&FireTracedCallbackTestCase::CbOne, this));
+  NS_TEST_ASSERT_MSG_EQ (copy.IsEmpty (), true, "Copy still connected");
+  NS_TEST_ASSERT_MSG_EQ (m_trace.IsEmpty (), false, "Original disconnected with its copy");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +239,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new FireTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
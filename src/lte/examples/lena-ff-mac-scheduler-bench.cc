@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the per-TTI cost of an FF MAC scheduler, which is
+// driven directly through its SAPs (no PHY, no MAC). nUes UEs are configured
+// and report a wideband CQI, but only nBacklogged of them have DL data to
+// transmit; a DL and an UL trigger are then issued for every TTI.
+// Sample usage:
+//   ./waf --run 'lena-ff-mac-scheduler-bench --scheduler=ns3::PfFfMacScheduler --nUes=2000 --nBacklogged=10'
+
+#include "ns3/command-line.h"
+#include "ns3/boolean.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/lte-fr-no-op-algorithm.h"
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * SCHED SAP user counting the resources allocated by the scheduler
+ */
+class BenchSchedSapUser : public FfMacSchedSapUser
+{
+public:
+  void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params) override
+  {
+    for (const auto& el : params.m_buildDataList)
+      {
+        nDlDcis++;
+        for (const auto& tbSize : el.m_dci.m_tbsSize)
+          {
+            dlBytes += tbSize;
+          }
+      }
+  }
+  void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params) override
+  {
+    nUlDcis += params.m_dciList.size ();
+  }
+
+  uint64_t nDlDcis {0};  //!< number of DL DCIs
+  uint64_t dlBytes {0};  //!< number of bytes allocated in DL
+  uint64_t nUlDcis {0};  //!< number of UL DCIs
+};
+
+/**
+ * CSCHED SAP user ignoring the confirmations of the scheduler
+ */
+class BenchCschedSapUser : public FfMacCschedSapUser
+{
+public:
+  void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params) override {}
+  void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params) override {}
+  void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params) override {}
+  void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params) override {}
+  void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params) override {}
+  void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params) override {}
+  void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params) override {}
+};
+
+int main (int argc, char *argv[])
+{
+  std::string scheduler = "ns3::PfFfMacScheduler";
+  uint16_t nUes = 1000;
+  uint16_t nBacklogged = 10;
+  uint32_t nTtis = 10000;
+  uint16_t bandwidth = 50;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("scheduler", "TypeId of the FF MAC scheduler", scheduler);
+  cmd.AddValue ("nUes", "number of UEs configured in the scheduler", nUes);
+  cmd.AddValue ("nBacklogged", "number of UEs with DL data to transmit", nBacklogged);
+  cmd.AddValue ("nTtis", "number of TTIs", nTtis);
+  cmd.AddValue ("bandwidth", "DL and UL bandwidth in RBs", bandwidth);
+  cmd.Parse (argc, argv);
+
+  ObjectFactory factory;
+  factory.SetTypeId (scheduler);
+  factory.Set ("HarqEnabled", BooleanValue (false));
+  Ptr<FfMacScheduler> sched = factory.Create<FfMacScheduler> ();
+
+  Ptr<LteFrNoOpAlgorithm> ffr = CreateObject<LteFrNoOpAlgorithm> ();
+  ffr->SetDlBandwidth (bandwidth);
+  ffr->SetUlBandwidth (bandwidth);
+  sched->SetLteFfrSapProvider (ffr->GetLteFfrSapProvider ());
+  ffr->SetLteFfrSapUser (sched->GetLteFfrSapUser ());
+
+  BenchSchedSapUser schedSapUser;
+  BenchCschedSapUser cschedSapUser;
+  sched->SetFfMacSchedSapUser (&schedSapUser);
+  sched->SetFfMacCschedSapUser (&cschedSapUser);
+  FfMacSchedSapProvider* schedSap = sched->GetFfMacSchedSapProvider ();
+  FfMacCschedSapProvider* cschedSap = sched->GetFfMacCschedSapProvider ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+  cellConfig.m_ulBandwidth = bandwidth;
+  cellConfig.m_dlBandwidth = bandwidth;
+  cschedSap->CschedCellConfigReq (cellConfig);
+
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiInfo;
+  cqiInfo.m_sfnSf = 0;
+  for (uint16_t rnti = 1; rnti <= nUes; rnti++)
+    {
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+      ueConfig.m_rnti = rnti;
+      ueConfig.m_reconfigureFlag = false;
+      ueConfig.m_transmissionMode = 0;
+      cschedSap->CschedUeConfigReq (ueConfig);
+
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+      lcConfig.m_rnti = rnti;
+      lcConfig.m_reconfigureFlag = false;
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 1;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = 9;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+      cschedSap->CschedLcConfigReq (lcConfig);
+
+      CqiListElement_s cqi;
+      cqi.m_rnti = rnti;
+      cqi.m_cqiType = CqiListElement_s::P10;
+      cqi.m_wbCqi.push_back (15);
+      cqiInfo.m_cqiList.push_back (cqi);
+    }
+  schedSap->SchedDlCqiInfoReq (cqiInfo);
+
+  // the backlogged UEs have enough data queued not to drain during the benchmark
+  for (uint16_t rnti = 1; rnti <= std::min (nBacklogged, nUes); rnti++)
+    {
+      FfMacSchedSapProvider::SchedDlRlcBufferReqParameters rlcBuffer;
+      rlcBuffer.m_rnti = rnti;
+      rlcBuffer.m_logicalChannelIdentity = 3;
+      rlcBuffer.m_rlcTransmissionQueueSize = 4000000000U;
+      rlcBuffer.m_rlcTransmissionQueueHolDelay = 0;
+      rlcBuffer.m_rlcRetransmissionQueueSize = 0;
+      rlcBuffer.m_rlcRetransmissionHolDelay = 0;
+      rlcBuffer.m_rlcStatusPduSize = 0;
+      schedSap->SchedDlRlcBufferReq (rlcBuffer);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t tti = 0; tti < nTtis; tti++)
+    {
+      uint16_t frameNo = 1 + (tti / 10) % 1024;
+      uint16_t subframeNo = 1 + tti % 10;
+
+      FfMacSchedSapProvider::SchedDlTriggerReqParameters dlTrigger;
+      dlTrigger.m_sfnSf = ((0x3FF & frameNo) << 4) | (0xF & subframeNo);
+      schedSap->SchedDlTriggerReq (dlTrigger);
+
+      FfMacSchedSapProvider::SchedUlTriggerReqParameters ulTrigger;
+      ulTrigger.m_sfnSf = dlTrigger.m_sfnSf;
+      schedSap->SchedUlTriggerReq (ulTrigger);
+    }
+  int64_t elapsed = time.End ();
+
+  std::cout << scheduler << ", " << nUes << " UEs, " << nBacklogged << " backlogged: "
+            << nTtis << " TTIs in " << elapsed << " ms ("
+            << 1000.0 * elapsed / nTtis << " us per TTI), "
+            << schedSapUser.nDlDcis << " DL DCIs, " << schedSapUser.dlBytes << " DL bytes, "
+            << schedSapUser.nUlDcis << " UL DCIs" << std::endl;
+
+  sched->Dispose ();
+  ffr->Dispose ();
+  return 0;
+}
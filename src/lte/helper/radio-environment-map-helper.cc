@@ -28,6 +28,7 @@
 #include <ns3/uinteger.h>
 #include <ns3/string.h>
 #include <ns3/boolean.h>
+#include <ns3/enum.h>
 #include <ns3/pointer.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/config.h>
@@ -38,9 +39,20 @@
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
 #include <ns3/lte-spectrum-value-helper.h>
-
+#include <ns3/node-list.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/antenna-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-converter.h>
+
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <limits>
+#include <thread>
 
 namespace ns3 {
 
@@ -154,6 +166,26 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("DirectComputation",
+                   "If true, the map is computed directly from the antenna gains and the "
+                   "propagation loss model of the channel, assuming every eNB transmits "
+                   "on all its RBs, instead of simulating the reception of the eNB signals",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_directComputation),
+                   MakeBooleanChecker ())
+    .AddAttribute ("NumThreads",
+                   "Number of threads used by the direct computation, "
+                   "0 means one per hardware thread",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_numThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("OutputFormat",
+                   "Format of the output file: an ASCII table, or a binary raster "
+                   "of 32-bit float SINR values",
+                   EnumValue (RadioEnvironmentMapHelper::ASCII),
+                   MakeEnumAccessor (&RadioEnvironmentMapHelper::m_outputFormat),
+                   MakeEnumChecker (RadioEnvironmentMapHelper::ASCII, "Ascii",
+                                    RadioEnvironmentMapHelper::BINARY, "Binary"))
   ;
   return tid;
 }
@@ -191,7 +223,7 @@ void
 RadioEnvironmentMapHelper::Install ()
 {
   NS_LOG_FUNCTION (this);
-  if (!m_rem.empty ())
+  if (!m_rem.empty () || m_outFile.is_open ())
     {
       NS_FATAL_ERROR ("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
@@ -207,13 +239,27 @@ RadioEnvironmentMapHelper::Install ()
       NS_ABORT_MSG_IF (m_channel == 0, "object at " << m_channelPath << " is not of type SpectrumChannel");
     }
 
-  m_outFile.open (m_outputFile.c_str ());
+  std::ios_base::openmode mode = std::ios_base::out;
+  if (m_outputFormat == BINARY)
+    {
+      mode |= std::ios_base::binary;
+    }
+  m_outFile.open (m_outputFile.c_str (), mode);
   if (!m_outFile.is_open ())
     {
       NS_FATAL_ERROR ("Can't open file " << (m_outputFile));
       return;
     }
-  
+  WriteHeader ();
+
+  if (m_directComputation)
+    {
+      // no transmission to wait for, only for the configuration of the
+      // devices to be complete
+      Simulator::ScheduleNow (&RadioEnvironmentMapHelper::ComputeDirect, this);
+      return;
+    }
+
   double startDelay = 0.0026;
 
   if (m_useDataChannel)
@@ -341,20 +387,225 @@ RadioEnvironmentMapHelper::PrintAndReset ()
           // at the end of the list can be unused
           break;
         }
-      Vector pos = it->bmm->GetPosition ();
-      NS_LOG_LOGIC ("output: " << pos.x << "\t" 
-                    << pos.y << "\t" 
-                    << pos.z << "\t" 
-                    << it->phy->GetSinr (m_noisePower));
-      m_outFile << pos.x << "\t" 
-                << pos.y << "\t" 
-                << pos.z << "\t" 
-                << it->phy->GetSinr (m_noisePower)
-                << std::endl;
+      WritePoint (it->bmm->GetPosition (), it->phy->GetSinr (m_noisePower));
       it->phy->Reset ();
     }
 }
 
+void
+RadioEnvironmentMapHelper::WriteHeader ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_outputFormat != BINARY)
+    {
+      return;
+    }
+  // "REM1", XRes and YRes as uint32_t, then XMin, XMax, YMin, YMax and Z
+  // as double, all in host byte order; the XRes * YRes float SINR values
+  // follow in the same order as the ASCII format (x outer, y inner)
+  const char magic[4] = {'R', 'E', 'M', '1'};
+  m_outFile.write (magic, sizeof (magic));
+  uint32_t res[2] = {m_xRes, m_yRes};
+  m_outFile.write (reinterpret_cast<const char *> (res), sizeof (res));
+  double bounds[5] = {m_xMin, m_xMax, m_yMin, m_yMax, m_z};
+  m_outFile.write (reinterpret_cast<const char *> (bounds), sizeof (bounds));
+}
+
+void
+RadioEnvironmentMapHelper::WritePoint (Vector pos, double sinr)
+{
+  NS_LOG_LOGIC ("output: " << pos.x << "\t"
+                << pos.y << "\t"
+                << pos.z << "\t"
+                << sinr);
+  if (m_outputFormat == BINARY)
+    {
+      float value = sinr;
+      m_outFile.write (reinterpret_cast<const char *> (&value), sizeof (value));
+    }
+  else
+    {
+      m_outFile << pos.x << "\t"
+                << pos.y << "\t"
+                << pos.z << "\t"
+                << sinr
+                << "\n";
+    }
+}
+
+std::vector<RadioEnvironmentMapHelper::RemTransmitter>
+RadioEnvironmentMapHelper::GetTransmitters () const
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<RemTransmitter> transmitters;
+  Ptr<const SpectrumModel> remSpectrumModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+    {
+      for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> ((*nodeIt)->GetDevice (i));
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          std::map<uint8_t, Ptr<ComponentCarrierBaseStation> > ccMap = enbDev->GetCcMap ();
+          for (std::map<uint8_t, Ptr<ComponentCarrierBaseStation> >::const_iterator ccIt = ccMap.begin ();
+               ccIt != ccMap.end (); ++ccIt)
+            {
+              Ptr<ComponentCarrierEnb> cc = DynamicCast<ComponentCarrierEnb> (ccIt->second);
+              Ptr<LteEnbPhy> phy = cc->GetPhy ();
+              Ptr<LteSpectrumPhy> spectrumPhy = phy->GetDownlinkSpectrumPhy ();
+              if (spectrumPhy->GetChannel () != m_channel)
+                {
+                  continue;
+                }
+              // the PSD of the control channel, which spans all the RBs
+              std::vector<int> activeRbs;
+              for (int rb = 0; rb < cc->GetDlBandwidth (); ++rb)
+                {
+                  activeRbs.push_back (rb);
+                }
+              Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (cc->GetDlEarfcn (),
+                                                                                             cc->GetDlBandwidth (),
+                                                                                             phy->GetTxPower (),
+                                                                                             activeRbs);
+              if (psd->GetSpectrumModelUid () != remSpectrumModel->GetUid ())
+                {
+                  SpectrumConverter converter (psd->GetSpectrumModel (), remSpectrumModel);
+                  psd = converter.Convert (psd);
+                }
+              RemTransmitter tx;
+              tx.mobility = spectrumPhy->GetMobility ();
+              tx.position = tx.mobility->GetPosition ();
+              tx.antenna = spectrumPhy->GetRxAntenna ();
+              tx.power = (m_rbId >= 0) ? (*psd)[m_rbId] * 180000 : Integral (*psd);
+              NS_LOG_LOGIC ("eNB at " << tx.position << " power " << tx.power << " W");
+              transmitters.push_back (tx);
+            }
+        }
+    }
+  return transmitters;
+}
+
+void
+RadioEnvironmentMapHelper::ComputeDirect ()
+{
+  NS_LOG_FUNCTION (this);
+  m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
+  m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+
+  std::vector<RemTransmitter> tx = GetTransmitters ();
+  Ptr<PropagationLossModel> propagationLoss = m_channel->GetPropagationLossModel ();
+  if (m_channel->GetSpectrumPropagationLossModel () != 0)
+    {
+      NS_LOG_WARN ("the frequency-selective loss model of the channel is ignored by the direct computation");
+    }
+  DoubleValue maxLossDb;
+  m_channel->GetAttribute ("MaxLossDb", maxLossDb);
+
+  uint32_t numThreads = m_numThreads;
+  if (numThreads == 0)
+    {
+      numThreads = std::max (1u, std::thread::hardware_concurrency ());
+    }
+
+  Ptr<MobilityModel> rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+  rxMobility->AggregateObject (buildingInfo);
+
+  // The map is computed one block of MaxPointsPerIteration points at a
+  // time. The propagation loss models are evaluated on this thread, as
+  // they may keep caches and random variables, and the reference counts
+  // of ns-3 objects are not atomic. The antenna gains and the SINR of
+  // the block are then computed by the worker threads.
+  uint32_t numPoints = m_xRes * m_yRes;
+  uint32_t blockSize = std::min (m_maxPointsPerIteration, numPoints);
+  std::vector<Vector> positions (blockSize);
+  std::vector<double> propagationGainDb (blockSize * tx.size (), 0.0);
+  std::vector<double> sinr (blockSize);
+  for (uint32_t first = 0; first < numPoints; first += blockSize)
+    {
+      uint32_t n = std::min (blockSize, numPoints - first);
+      for (uint32_t p = 0; p < n; ++p)
+        {
+          uint32_t xIndex = (first + p) / m_yRes;
+          uint32_t yIndex = (first + p) % m_yRes;
+          positions[p] = Vector (m_xMin + xIndex * m_xStep, m_yMin + yIndex * m_yStep, m_z);
+          if (propagationLoss != 0)
+            {
+              rxMobility->SetPosition (positions[p]);
+              buildingInfo->MakeConsistent (rxMobility);
+              for (uint32_t t = 0; t < tx.size (); ++t)
+                {
+                  propagationGainDb[p * tx.size () + t] = propagationLoss->CalcRxPower (0, tx[t].mobility, rxMobility);
+                }
+            }
+        }
+
+      uint32_t pointsPerThread = (n + numThreads - 1) / numThreads;
+      std::vector<std::thread> workers;
+      for (uint32_t begin = pointsPerThread; begin < n; begin += pointsPerThread)
+        {
+          workers.push_back (std::thread (&RadioEnvironmentMapHelper::ComputeSinr, this,
+                                          std::cref (tx), std::cref (positions),
+                                          std::cref (propagationGainDb), maxLossDb.Get (),
+                                          begin, std::min (begin + pointsPerThread, n),
+                                          std::ref (sinr)));
+        }
+      // the first range is computed by this thread
+      ComputeSinr (tx, positions, propagationGainDb, maxLossDb.Get (),
+                   0, std::min (pointsPerThread, n), sinr);
+      for (std::vector<std::thread>::iterator it = workers.begin (); it != workers.end (); ++it)
+        {
+          it->join ();
+        }
+
+      for (uint32_t p = 0; p < n; ++p)
+        {
+          WritePoint (positions[p], sinr[p]);
+        }
+    }
+
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::ComputeSinr (const std::vector<RemTransmitter> &tx,
+                                        const std::vector<Vector> &positions,
+                                        const std::vector<double> &propagationGainDb,
+                                        double maxLossDb, uint32_t begin, uint32_t end,
+                                        std::vector<double> &sinr) const
+{
+  uint32_t numTx = tx.size ();
+  for (uint32_t p = begin; p < end; ++p)
+    {
+      // same computation as the channel and RemSpectrumPhy, the
+      // receiving antenna being isotropic
+      double sumPower = 0;
+      double referenceSignalPower = 0;
+      for (uint32_t t = 0; t < numTx; ++t)
+        {
+          double pathLossDb = -propagationGainDb[p * numTx + t];
+          if (tx[t].antenna != 0)
+            {
+              Angles txAngles (positions[p], tx[t].position);
+              pathLossDb -= tx[t].antenna->GetGainDb (txAngles);
+            }
+          if (pathLossDb > maxLossDb)
+            {
+              continue;
+            }
+          double power = tx[t].power * std::pow (10.0, (-pathLossDb) / 10.0);
+          sumPower += power;
+          if (power > referenceSignalPower)
+            {
+              referenceSignalPower = power;
+            }
+        }
+      sinr[p] = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+    }
+}
+
 void 
 RadioEnvironmentMapHelper::Finalize ()
 {
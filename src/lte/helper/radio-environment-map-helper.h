@@ -24,7 +24,9 @@
 
 
 #include <ns3/object.h>
+#include <ns3/vector.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +37,7 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
 
 /** 
  * \ingroup lte
@@ -42,11 +45,24 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * The map is generated either by simulating the reception of the eNB
+ * signals at a grid of RemSpectrumPhy listeners (the default), or, if
+ * the DirectComputation attribute is set, by evaluating the antenna
+ * gains and the propagation loss models of the channel directly at
+ * each grid point, without any simulated transmission.
  */
 class RadioEnvironmentMapHelper : public Object
 {
 public:  
 
+  /// Format of the file the map is written to
+  enum OutputFormat_t
+  {
+    ASCII,  ///< one "x y z sinr" text line per point
+    BINARY  ///< raster of 32-bit floats, preceded by a small header
+  };
+
   RadioEnvironmentMapHelper ();
   virtual ~RadioEnvironmentMapHelper ();
   
@@ -108,6 +124,62 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /// Write the header of the output file, if the format has one.
+  void WriteHeader ();
+
+  /**
+   * Write the SINR of one point of the map to the output file.
+   *
+   * \param pos position of the point
+   * \param sinr the SINR in linear units
+   */
+  void WritePoint (Vector pos, double sinr);
+
+  /// An eNB transmitting on the channel, as seen by the direct engine.
+  struct RemTransmitter
+  {
+    /// Mobility model of the eNB.
+    Ptr<MobilityModel> mobility;
+    /// Position of the eNB, cached for the worker threads.
+    Vector position;
+    /// Antenna of the eNB, or 0 if isotropic.
+    Ptr<AntennaModel> antenna;
+    /// Transmitted power in the band (or RB) of the map, in Watts.
+    double power;
+  };
+
+  /**
+   * Scheduled by Install() when DirectComputation is set: generate the
+   * whole map without simulated transmissions, then call Finalize().
+   */
+  void ComputeDirect ();
+
+  /**
+   * Collect the LTE eNBs which transmit on the channel of the map.
+   *
+   * \return the transmitters
+   */
+  std::vector<RemTransmitter> GetTransmitters () const;
+
+  /**
+   * Compute the SINR of a range of points of a block. Runs in a worker
+   * thread: it must not touch the reference counts of shared objects.
+   *
+   * \param tx the transmitters
+   * \param positions positions of the points of the block
+   * \param propagationGainDb propagation gain of each point from each
+   *        transmitter, in dB, indexed by point * tx.size () + transmitter
+   * \param maxLossDb loss beyond which a transmitter is not received
+   * \param begin index of the first point of the range
+   * \param end index past the last point of the range
+   * \param sinr output SINR of each point of the block, in linear units
+   */
+  void ComputeSinr (const std::vector<RemTransmitter> &tx,
+                    const std::vector<Vector> &positions,
+                    const std::vector<double> &propagationGainDb,
+                    double maxLossDb, uint32_t begin, uint32_t end,
+                    std::vector<double> &sinr) const;
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -163,6 +235,10 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_directComputation;      ///< The `DirectComputation` attribute.
+  uint32_t m_numThreads;         ///< The `NumThreads` attribute.
+  OutputFormat_t m_outputFormat; ///< The `OutputFormat` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
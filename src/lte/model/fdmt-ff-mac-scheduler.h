@@ -40,11 +40,6 @@
 #define NO_SINR -5000
 
 
-/// number of HARQ processes
-#define HARQ_PROC_NUM 8
-/// HARQ DL timeout
-#define HARQ_DL_TIMEOUT 11
-
 namespace ns3 {
 
 
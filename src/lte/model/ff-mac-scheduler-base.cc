@@ -0,0 +1,721 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/ff-mac-scheduler-base.h>
+#include <algorithm>
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacSchedulerBase");
+
+NS_OBJECT_ENSURE_REGISTERED (FfMacSchedulerBase);
+
+
+FfMacSchedulerBase::FfMacSchedulerBase ()
+  : m_dlLcOrder (LCID_ORDER),
+    m_cqiTimersThreshold (1000),
+    m_harqOn (true),
+    m_dlCqiTti (0),
+    m_dlHarqTti (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FfMacSchedulerBase::~FfMacSchedulerBase ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FfMacSchedulerBase::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_ueRnti.clear ();
+  m_ueTxMode.clear ();
+  m_ueDlLcs.clear ();
+  m_ueActiveDlLcs.clear ();
+  m_ueP10Cqi.clear ();
+  m_ueA30Cqi.clear ();
+  m_dlHarqCurrentProcessId.clear ();
+  m_dlHarqProcessesStatus.clear ();
+  m_dlHarqProcessesDciBuffer.clear ();
+  m_dlHarqProcessesRlcPduListBuffer.clear ();
+  m_dlInfoListBuffered.clear ();
+  m_dlUes.clear ();
+  m_activeDlUes.clear ();
+  m_ueIndex.clear ();
+  m_freeUeIndices.clear ();
+  m_ueP10CqiExpiry.clear ();
+  m_ueA30CqiExpiry.clear ();
+  m_dlHarqProcessesTxTti.clear ();
+  FfMacScheduler::DoDispose ();
+}
+
+TypeId
+FfMacSchedulerBase::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FfMacSchedulerBase")
+    .SetParent<FfMacScheduler> ()
+    .SetGroupName("Lte")
+  ;
+  return tid;
+}
+
+
+uint32_t
+FfMacSchedulerBase::AddUe (uint16_t rnti, uint8_t txMode)
+{
+  NS_LOG_FUNCTION (this << rnti << (uint16_t) txMode);
+  NS_ASSERT_MSG (m_ueIndex.find (rnti) == m_ueIndex.end (), "UE " << rnti << " already added");
+
+  uint32_t ueIndex;
+  if (!m_freeUeIndices.empty ())
+    {
+      ueIndex = m_freeUeIndices.back ();
+      m_freeUeIndices.pop_back ();
+    }
+  else
+    {
+      ueIndex = m_ueRnti.size ();
+      m_ueRnti.resize (ueIndex + 1);
+      m_ueTxMode.resize (ueIndex + 1);
+      m_ueDlLcs.resize (ueIndex + 1);
+      m_ueActiveDlLcs.resize (ueIndex + 1);
+      m_ueP10Cqi.resize (ueIndex + 1);
+      m_ueA30Cqi.resize (ueIndex + 1);
+      m_dlHarqCurrentProcessId.resize (ueIndex + 1);
+      m_dlHarqProcessesStatus.resize (ueIndex + 1);
+      m_dlHarqProcessesDciBuffer.resize (ueIndex + 1);
+      m_dlHarqProcessesRlcPduListBuffer.resize (ueIndex + 1);
+      m_ueP10CqiExpiry.resize (ueIndex + 1);
+      m_ueA30CqiExpiry.resize (ueIndex + 1);
+      m_dlHarqProcessesTxTti.resize (ueIndex + 1);
+    }
+  m_ueIndex[rnti] = ueIndex;
+
+  m_ueRnti[ueIndex] = rnti;
+  m_ueTxMode[ueIndex] = txMode;
+  m_ueDlLcs[ueIndex].clear ();
+  m_ueActiveDlLcs[ueIndex] = 0;
+  m_ueP10CqiExpiry[ueIndex] = 0;
+  m_ueA30CqiExpiry[ueIndex] = 0;
+  // generate HARQ buffers
+  m_dlHarqCurrentProcessId[ueIndex] = 0;
+  m_dlHarqProcessesStatus[ueIndex].fill (0);
+  m_dlHarqProcessesTxTti[ueIndex].fill (m_dlHarqTti);
+  m_dlHarqProcessesDciBuffer[ueIndex].assign (HARQ_PROC_NUM, DlDciListElement_s ());
+  DlHarqRlcPduListBuffer_t& dlHarqRlcPdu = m_dlHarqProcessesRlcPduListBuffer[ueIndex];
+  dlHarqRlcPdu.resize (2);
+  dlHarqRlcPdu.at (0).assign (HARQ_PROC_NUM, std::vector<RlcPduListElement_s> ());
+  dlHarqRlcPdu.at (1).assign (HARQ_PROC_NUM, std::vector<RlcPduListElement_s> ());
+
+  return ueIndex;
+}
+
+void
+FfMacSchedulerBase::RemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  std::unordered_map<uint16_t, uint32_t>::iterator it = m_ueIndex.find (rnti);
+  if (it == m_ueIndex.end ())
+    {
+      return;
+    }
+  uint32_t ueIndex = it->second;
+  EraseUe (m_dlUes, ueIndex);
+  EraseUe (m_activeDlUes, ueIndex);
+  m_ueRnti[ueIndex] = 0;
+  m_ueDlLcs[ueIndex].clear ();
+  m_ueActiveDlLcs[ueIndex] = 0;
+  m_dlHarqProcessesDciBuffer[ueIndex].clear ();
+  m_dlHarqProcessesRlcPduListBuffer[ueIndex].clear ();
+  m_freeUeIndices.push_back (ueIndex);
+  m_ueIndex.erase (it);
+}
+
+uint32_t
+FfMacSchedulerBase::GetUeIndex (uint16_t rnti) const
+{
+  std::unordered_map<uint16_t, uint32_t>::const_iterator it = m_ueIndex.find (rnti);
+  if (it == m_ueIndex.end ())
+    {
+      return NO_UE;
+    }
+  return it->second;
+}
+
+void
+FfMacSchedulerBase::InsertUe (std::vector<uint32_t>& ues, uint32_t ueIndex)
+{
+  uint16_t rnti = m_ueRnti[ueIndex];
+  std::vector<uint32_t>::iterator it = std::lower_bound (ues.begin (), ues.end (), rnti,
+                                                         [this] (uint32_t ue, uint16_t r)
+                                                         { return m_ueRnti[ue] < r; });
+  if (it == ues.end () || *it != ueIndex)
+    {
+      ues.insert (it, ueIndex);
+    }
+}
+
+void
+FfMacSchedulerBase::EraseUe (std::vector<uint32_t>& ues, uint32_t ueIndex)
+{
+  uint16_t rnti = m_ueRnti[ueIndex];
+  std::vector<uint32_t>::iterator it = std::lower_bound (ues.begin (), ues.end (), rnti,
+                                                         [this] (uint32_t ue, uint16_t r)
+                                                         { return m_ueRnti[ue] < r; });
+  if (it != ues.end () && *it == ueIndex)
+    {
+      ues.erase (it);
+    }
+}
+
+
+bool
+FfMacSchedulerBase::IsDlLcActive (const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& lc)
+{
+  return ((lc.m_rlcTransmissionQueueSize > 0)
+          || (lc.m_rlcRetransmissionQueueSize > 0)
+          || (lc.m_rlcStatusPduSize > 0));
+}
+
+void
+FfMacSchedulerBase::NotifyDlLcActivity (uint32_t ueIndex, bool wasActive, bool isActive)
+{
+  if (wasActive == isActive)
+    {
+      return;
+    }
+  if (isActive)
+    {
+      if (m_ueActiveDlLcs[ueIndex]++ == 0)
+        {
+          InsertUe (m_activeDlUes, ueIndex);
+        }
+    }
+  else
+    {
+      NS_ASSERT (m_ueActiveDlLcs[ueIndex] > 0);
+      if (--m_ueActiveDlLcs[ueIndex] == 0)
+        {
+          EraseUe (m_activeDlUes, ueIndex);
+        }
+    }
+}
+
+bool
+FfMacSchedulerBase::SetDlRlcBufferStatus (uint32_t ueIndex, const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params)
+{
+  NS_LOG_FUNCTION (this << params.m_rnti << (uint16_t) params.m_logicalChannelIdentity);
+  std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>& lcs = m_ueDlLcs[ueIndex];
+  std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = lcs.begin (); it != lcs.end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == params.m_logicalChannelIdentity)
+        {
+          break;
+        }
+    }
+
+  bool newLc = (it == lcs.end ());
+  bool wasActive = !newLc && IsDlLcActive (*it);
+  if (newLc && lcs.empty ())
+    {
+      InsertUe (m_dlUes, ueIndex);
+    }
+  if (m_dlLcOrder == LAST_UPDATE_ORDER)
+    {
+      if (!newLc)
+        {
+          lcs.erase (it);
+        }
+      lcs.push_back (params);
+    }
+  else if (newLc)
+    {
+      it = lcs.begin ();
+      while (it != lcs.end () && (*it).m_logicalChannelIdentity < params.m_logicalChannelIdentity)
+        {
+          it++;
+        }
+      lcs.insert (it, params);
+    }
+  else
+    {
+      *it = params;
+    }
+  NotifyDlLcActivity (ueIndex, wasActive, IsDlLcActive (params));
+  return newLc;
+}
+
+void
+FfMacSchedulerBase::ReleaseDlLc (uint32_t ueIndex, uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this << m_ueRnti[ueIndex] << (uint16_t) lcid);
+  std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>& lcs = m_ueDlLcs[ueIndex];
+  std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = lcs.begin (); it != lcs.end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == lcid)
+        {
+          NotifyDlLcActivity (ueIndex, IsDlLcActive (*it), false);
+          lcs.erase (it);
+          if (lcs.empty ())
+            {
+              EraseUe (m_dlUes, ueIndex);
+            }
+          return;
+        }
+    }
+}
+
+void
+FfMacSchedulerBase::UpdateDlRlcBufferInfo (uint32_t ueIndex, uint8_t lcid, uint16_t size)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters>::iterator it;
+  for (it = m_ueDlLcs[ueIndex].begin (); it != m_ueDlLcs[ueIndex].end (); it++)
+    {
+      if ((*it).m_logicalChannelIdentity == lcid)
+        {
+          NS_LOG_INFO (this << " UE " << m_ueRnti[ueIndex] << " LC " << (uint16_t)lcid << " txqueue " << (*it).m_rlcTransmissionQueueSize << " retxqueue " << (*it).m_rlcRetransmissionQueueSize << " status " << (*it).m_rlcStatusPduSize << " decrease " << size);
+          bool wasActive = IsDlLcActive (*it);
+          // Update queues: RLC tx order Status, ReTx, Tx
+          // Update status queue
+          if (((*it).m_rlcStatusPduSize > 0) && (size >= (*it).m_rlcStatusPduSize))
+            {
+              (*it).m_rlcStatusPduSize = 0;
+            }
+          else if (((*it).m_rlcRetransmissionQueueSize > 0) && (size >= (*it).m_rlcRetransmissionQueueSize))
+            {
+              (*it).m_rlcRetransmissionQueueSize = 0;
+            }
+          else if ((*it).m_rlcTransmissionQueueSize > 0)
+            {
+              uint32_t rlcOverhead;
+              if (lcid == 1)
+                {
+                  // for SRB1 (using RLC AM) it's better to
+                  // overestimate RLC overhead rather than
+                  // underestimate it and risk unneeded
+                  // segmentation which increases delay
+                  rlcOverhead = 4;
+                }
+              else
+                {
+                  // minimum RLC overhead due to header
+                  rlcOverhead = 2;
+                }
+              // update transmission queue
+              if ((*it).m_rlcTransmissionQueueSize <= size - rlcOverhead)
+                {
+                  (*it).m_rlcTransmissionQueueSize = 0;
+                }
+              else
+                {
+                  (*it).m_rlcTransmissionQueueSize -= size - rlcOverhead;
+                }
+            }
+          NotifyDlLcActivity (ueIndex, wasActive, IsDlLcActive (*it));
+          return;
+        }
+    }
+  NS_LOG_ERROR (this << " Does not find DL RLC Buffer Report of UE " << m_ueRnti[ueIndex]);
+}
+
+
+void
+FfMacSchedulerBase::SetDlP10Cqi (uint32_t ueIndex, uint8_t cqi)
+{
+  m_ueP10Cqi[ueIndex] = cqi;
+  m_ueP10CqiExpiry[ueIndex] = m_dlCqiTti + m_cqiTimersThreshold + 1;
+}
+
+bool
+FfMacSchedulerBase::HasDlP10Cqi (uint32_t ueIndex) const
+{
+  return m_dlCqiTti < m_ueP10CqiExpiry[ueIndex];
+}
+
+void
+FfMacSchedulerBase::SetDlA30Cqi (uint32_t ueIndex, const SbMeasResult_s& sbMeasResult)
+{
+  m_ueA30Cqi[ueIndex] = sbMeasResult;
+  m_ueA30CqiExpiry[ueIndex] = m_dlCqiTti + m_cqiTimersThreshold + 1;
+}
+
+bool
+FfMacSchedulerBase::HasDlA30Cqi (uint32_t ueIndex) const
+{
+  return m_dlCqiTti < m_ueA30CqiExpiry[ueIndex];
+}
+
+void
+FfMacSchedulerBase::RefreshDlCqis (void)
+{
+  m_dlCqiTti++;
+}
+
+
+void
+FfMacSchedulerBase::CheckDlHarqTimer (uint32_t ueIndex, uint8_t harqId)
+{
+  // the timer of a HARQ process expires HARQ_DL_TIMEOUT + 1 refreshes after
+  // the last (re)transmission
+  if (m_dlHarqProcessesStatus[ueIndex].at (harqId) != 0
+      && m_dlHarqTti > m_dlHarqProcessesTxTti[ueIndex].at (harqId) + HARQ_DL_TIMEOUT)
+    {
+      NS_LOG_DEBUG (this << " Reset HARQ proc " << (uint16_t) harqId << " for RNTI " << m_ueRnti[ueIndex]);
+      m_dlHarqProcessesStatus[ueIndex].at (harqId) = 0;
+    }
+}
+
+void
+FfMacSchedulerBase::ResetDlHarqTimer (uint32_t ueIndex, uint8_t harqId)
+{
+  CheckDlHarqTimer (ueIndex, harqId);
+  m_dlHarqProcessesTxTti[ueIndex].at (harqId) = m_dlHarqTti;
+}
+
+bool
+FfMacSchedulerBase::IsDlHarqProcessAvailable (uint32_t ueIndex)
+{
+  NS_LOG_FUNCTION (this << m_ueRnti[ueIndex]);
+
+  for (uint8_t i = 0; i < HARQ_PROC_NUM; i++)
+    {
+      CheckDlHarqTimer (ueIndex, i);
+      if (m_dlHarqProcessesStatus[ueIndex].at (i) == 0)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+uint8_t
+FfMacSchedulerBase::UpdateDlHarqProcessId (uint32_t ueIndex)
+{
+  NS_LOG_FUNCTION (this << m_ueRnti[ueIndex]);
+
+  if (m_harqOn == false)
+    {
+      return (0);
+    }
+
+  uint8_t& current = m_dlHarqCurrentProcessId[ueIndex];
+  std::array<uint8_t, HARQ_PROC_NUM>& status = m_dlHarqProcessesStatus[ueIndex];
+  uint8_t i = current;
+  do
+    {
+      i = (i + 1) % HARQ_PROC_NUM;
+      CheckDlHarqTimer (ueIndex, i);
+    }
+  while ((status.at (i) != 0) && (i != current));
+  if (status.at (i) == 0)
+    {
+      current = i;
+      status.at (i) = 1;
+      m_dlHarqProcessesTxTti[ueIndex].at (i) = m_dlHarqTti;
+    }
+  else
+    {
+      NS_FATAL_ERROR ("No HARQ process available for RNTI " << m_ueRnti[ueIndex] << " check before update with IsDlHarqProcessAvailable");
+    }
+
+  return current;
+}
+
+void
+FfMacSchedulerBase::RefreshDlHarqProcesses (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_dlHarqTti++;
+}
+
+void
+FfMacSchedulerBase::StoreDlHarqTx (uint32_t ueIndex, const BuildDataListElement_s& el)
+{
+  if (m_harqOn == false)
+    {
+      return;
+    }
+  uint8_t harqId = el.m_dci.m_harqProcess;
+  // store RLC PDU list for HARQ
+  DlHarqRlcPduListBuffer_t& rlcPduBuffer = m_dlHarqProcessesRlcPduListBuffer[ueIndex];
+  for (std::size_t k = 0; k < el.m_rlcPduList.size (); k++)
+    {
+      for (std::size_t j = 0; j < el.m_rlcPduList.at (k).size (); j++)
+        {
+          rlcPduBuffer.at (j).at (harqId).push_back (el.m_rlcPduList.at (k).at (j));
+        }
+    }
+  // store DCI for HARQ
+  m_dlHarqProcessesDciBuffer[ueIndex].at (harqId) = el.m_dci;
+  // refresh timer
+  ResetDlHarqTimer (ueIndex, harqId);
+}
+
+void
+FfMacSchedulerBase::ScheduleDlHarqRetx (const std::vector<DlInfoListElement_s>& dlInfoList,
+                                        int rbgNum, std::vector<bool>& rbgMap, uint16_t& rbgAllocatedNum,
+                                        std::set<uint16_t>& rntiAllocated,
+                                        FfMacSchedSapUser::SchedDlConfigIndParameters& ret)
+{
+  NS_LOG_FUNCTION (this);
+
+  // retrieve past HARQ retx buffered
+  if (m_dlInfoListBuffered.size () > 0)
+    {
+      if (dlInfoList.size () > 0)
+        {
+          NS_LOG_INFO (this << " Received DL-HARQ feedback");
+          m_dlInfoListBuffered.insert (m_dlInfoListBuffered.end (), dlInfoList.begin (), dlInfoList.end ());
+        }
+    }
+  else
+    {
+      if (dlInfoList.size () > 0)
+        {
+          m_dlInfoListBuffered = dlInfoList;
+        }
+    }
+  if (m_harqOn == false)
+    {
+      // Ignore HARQ feedback
+      m_dlInfoListBuffered.clear ();
+    }
+  std::vector <struct DlInfoListElement_s> dlInfoListUntxed;
+  for (uint16_t i = 0; i < m_dlInfoListBuffered.size (); i++)
+    {
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find (m_dlInfoListBuffered.at (i).m_rnti);
+      if (itRnti != rntiAllocated.end ())
+        {
+          // RNTI already allocated for retx
+          continue;
+        }
+      uint8_t nLayers = m_dlInfoListBuffered.at (i).m_harqStatus.size ();
+      std::vector <bool> retx;
+      NS_LOG_INFO (this << " Processing DLHARQ feedback");
+      if (nLayers == 1)
+        {
+          retx.push_back (m_dlInfoListBuffered.at (i).m_harqStatus.at (0) == DlInfoListElement_s::NACK);
+          retx.push_back (false);
+        }
+      else
+        {
+          retx.push_back (m_dlInfoListBuffered.at (i).m_harqStatus.at (0) == DlInfoListElement_s::NACK);
+          retx.push_back (m_dlInfoListBuffered.at (i).m_harqStatus.at (1) == DlInfoListElement_s::NACK);
+        }
+      uint16_t rnti = m_dlInfoListBuffered.at (i).m_rnti;
+      uint32_t ueIndex = GetUeIndex (rnti);
+      if (ueIndex == NO_UE)
+        {
+          NS_FATAL_ERROR ("No info find in HARQ buffer for UE " << rnti);
+        }
+      if (retx.at (0) || retx.at (1))
+        {
+          // retrieve HARQ process information
+          uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
+          NS_LOG_INFO (this << " HARQ retx RNTI " << rnti << " harqId " << (uint16_t)harqId);
+          DlHarqProcessesDciBuffer_t& dciBuffer = m_dlHarqProcessesDciBuffer[ueIndex];
+          DlHarqRlcPduListBuffer_t& rlcPduBuffer = m_dlHarqProcessesRlcPduListBuffer[ueIndex];
+
+          DlDciListElement_s dci = dciBuffer.at (harqId);
+          int rv = 0;
+          if (dci.m_rv.size () == 1)
+            {
+              rv = dci.m_rv.at (0);
+            }
+          else
+            {
+              rv = (dci.m_rv.at (0) > dci.m_rv.at (1) ? dci.m_rv.at (0) : dci.m_rv.at (1));
+            }
+
+          if (rv == 3)
+            {
+              // maximum number of retx reached -> drop process
+              NS_LOG_INFO ("Maximum number of retransmissions reached -> drop process");
+              m_dlHarqProcessesStatus[ueIndex].at (harqId) = 0;
+              for (uint16_t k = 0; k < rlcPduBuffer.size (); k++)
+                {
+                  rlcPduBuffer.at (k).at (harqId).clear ();
+                }
+              continue;
+            }
+          // check the feasibility of retransmitting on the same RBGs
+          // translate the DCI to Spectrum framework
+          std::vector <int> dciRbg;
+          uint32_t mask = 0x1;
+          NS_LOG_INFO ("Original RBGs " << dci.m_rbBitmap << " rnti " << dci.m_rnti);
+          for (int j = 0; j < 32; j++)
+            {
+              if (((dci.m_rbBitmap & mask) >> j) == 1)
+                {
+                  dciRbg.push_back (j);
+                  NS_LOG_INFO ("\t" << j);
+                }
+              mask = (mask << 1);
+            }
+          bool free = true;
+          for (uint8_t j = 0; j < dciRbg.size (); j++)
+            {
+              if (rbgMap.at (dciRbg.at (j)) == true)
+                {
+                  free = false;
+                  break;
+                }
+            }
+          if (free)
+            {
+              // use the same RBGs for the retx
+              // reserve RBGs
+              for (uint8_t j = 0; j < dciRbg.size (); j++)
+                {
+                  rbgMap.at (dciRbg.at (j)) = true;
+                  NS_LOG_INFO ("RBG " << dciRbg.at (j) << " assigned");
+                  rbgAllocatedNum++;
+                }
+
+              NS_LOG_INFO (this << " Send retx in the same RBGs");
+            }
+          else
+            {
+              // find RBGs for sending HARQ retx
+              uint8_t j = 0;
+              uint8_t rbgId = (dciRbg.at (dciRbg.size () - 1) + 1) % rbgNum;
+              uint8_t startRbg = dciRbg.at (dciRbg.size () - 1);
+              std::vector <bool> rbgMapCopy = rbgMap;
+              while ((j < dciRbg.size ())&&(startRbg != rbgId))
+                {
+                  if (rbgMapCopy.at (rbgId) == false)
+                    {
+                      rbgMapCopy.at (rbgId) = true;
+                      dciRbg.at (j) = rbgId;
+                      j++;
+                    }
+                  rbgId = (rbgId + 1) % rbgNum;
+                }
+              if (j == dciRbg.size ())
+                {
+                  // find new RBGs -> update DCI map
+                  uint32_t rbgMask = 0;
+                  for (uint16_t k = 0; k < dciRbg.size (); k++)
+                    {
+                      rbgMask = rbgMask + (0x1 << dciRbg.at (k));
+                      NS_LOG_INFO (this << " New allocated RBG " << dciRbg.at (k));
+                      rbgAllocatedNum++;
+                    }
+                  dci.m_rbBitmap = rbgMask;
+                  rbgMap = rbgMapCopy;
+                  NS_LOG_INFO (this << " Move retx in RBGs " << dciRbg.size ());
+                }
+              else
+                {
+                  // HARQ retx cannot be performed on this TTI -> store it
+                  dlInfoListUntxed.push_back (m_dlInfoListBuffered.at (i));
+                  NS_LOG_INFO (this << " No resource for this retx -> buffer it");
+                }
+            }
+          // retrieve RLC PDU list for retx TBsize and update DCI
+          BuildDataListElement_s newEl;
+          for (uint8_t j = 0; j < nLayers; j++)
+            {
+              if (retx.at (j))
+                {
+                  if (j >= dci.m_ndi.size ())
+                    {
+                      // for avoiding errors in MIMO transient phases
+                      dci.m_ndi.push_back (0);
+                      dci.m_rv.push_back (0);
+                      dci.m_mcs.push_back (0);
+                      dci.m_tbsSize.push_back (0);
+                      NS_LOG_INFO (this << " layer " << (uint16_t)j << " no txed (MIMO transition)");
+                    }
+                  else
+                    {
+                      dci.m_ndi.at (j) = 0;
+                      dci.m_rv.at (j)++;
+                      dciBuffer.at (harqId).m_rv.at (j)++;
+                      NS_LOG_INFO (this << " layer " << (uint16_t)j << " RV " << (uint16_t)dci.m_rv.at (j));
+                    }
+                }
+              else
+                {
+                  // empty TB of layer j
+                  dci.m_ndi.at (j) = 0;
+                  dci.m_rv.at (j) = 0;
+                  dci.m_mcs.at (j) = 0;
+                  dci.m_tbsSize.at (j) = 0;
+                  NS_LOG_INFO (this << " layer " << (uint16_t)j << " no retx");
+                }
+            }
+          for (uint16_t k = 0; k < rlcPduBuffer.at (0).at (dci.m_harqProcess).size (); k++)
+            {
+              std::vector <struct RlcPduListElement_s> rlcPduListPerLc;
+              for (uint8_t j = 0; j < nLayers; j++)
+                {
+                  if (retx.at (j))
+                    {
+                      if (j < dci.m_ndi.size ())
+                        {
+                          NS_LOG_INFO (" layer " << (uint16_t)j << " tb size " << dci.m_tbsSize.at (j));
+                          rlcPduListPerLc.push_back (rlcPduBuffer.at (j).at (dci.m_harqProcess).at (k));
+                        }
+                    }
+                  else
+                    { // if no retx needed on layer j, push an RlcPduListElement_s object with m_size=0 to keep the size of rlcPduListPerLc vector = 2 in case of MIMO
+                      NS_LOG_INFO (" layer " << (uint16_t)j << " tb size "<<dci.m_tbsSize.at (j));
+                      RlcPduListElement_s emptyElement;
+                      emptyElement.m_logicalChannelIdentity = rlcPduBuffer.at (j).at (dci.m_harqProcess).at (k).m_logicalChannelIdentity;
+                      emptyElement.m_size = 0;
+                      rlcPduListPerLc.push_back (emptyElement);
+                    }
+                }
+
+              if (rlcPduListPerLc.size () > 0)
+                {
+                  newEl.m_rlcPduList.push_back (rlcPduListPerLc);
+                }
+            }
+          newEl.m_rnti = rnti;
+          newEl.m_dci = dci;
+          dciBuffer.at (harqId).m_rv = dci.m_rv;
+          // refresh timer
+          ResetDlHarqTimer (ueIndex, harqId);
+          ret.m_buildDataList.push_back (newEl);
+          rntiAllocated.insert (rnti);
+        }
+      else
+        {
+          // update HARQ process status
+          NS_LOG_INFO (this << " HARQ received ACK for UE " << rnti);
+          uint8_t harqId = m_dlInfoListBuffered.at (i).m_harqProcessId;
+          m_dlHarqProcessesStatus[ueIndex].at (harqId) = 0;
+          DlHarqRlcPduListBuffer_t& rlcPduBuffer = m_dlHarqProcessesRlcPduListBuffer[ueIndex];
+          for (uint16_t k = 0; k < rlcPduBuffer.size (); k++)
+            {
+              rlcPduBuffer.at (k).at (harqId).clear ();
+            }
+        }
+    }
+  m_dlInfoListBuffered.clear ();
+  m_dlInfoListBuffered = dlInfoListUntxed;
+}
+
+} // namespace ns3
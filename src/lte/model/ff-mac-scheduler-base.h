@@ -0,0 +1,293 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_SCHEDULER_BASE_H
+#define FF_MAC_SCHEDULER_BASE_H
+
+#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-sched-sap.h>
+#include <ns3/ff-mac-common.h>
+#include <array>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t;
+typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; // vector of the LCs and layers per UE
+typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t; // vector of the 8 HARQ processes per UE
+
+/**
+ * \ingroup ff-api
+ * \brief Base class for FF MAC schedulers storing the DL state of the UEs
+ * in dense per-UE arrays
+ *
+ * Each UE configured through the CSCHED SAP is assigned a UE index, which is
+ * used to access the transmission mode, the DL RLC buffer status, the DL CQIs
+ * and the DL HARQ processes of the UE; the index of a released UE is reused
+ * for the next UE that is added. The UEs having at least one DL logical
+ * channel with data to transmit are kept in an active set, sorted by RNTI,
+ * which is updated when an RLC buffer status report is received and when
+ * resources are allocated to a logical channel. Expired DL CQIs and HARQ
+ * processes are detected when they are accessed, hence a scheduler built on
+ * this class can select the UEs to serve in a TTI with a cost that depends on
+ * the number of backlogged UEs rather than on the number of attached UEs.
+ *
+ * This class also implements the processing of the DL HARQ feedback and the
+ * scheduling of the DL HARQ retransmissions.
+ */
+class FfMacSchedulerBase : public FfMacScheduler
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  FfMacSchedulerBase ();
+  virtual ~FfMacSchedulerBase ();
+
+  // inherited from Object
+  virtual void DoDispose (void);
+
+protected:
+  /// Order in which the DL logical channels of a UE are stored
+  enum DlLcOrder
+  {
+    LCID_ORDER,         ///< increasing LCID
+    LAST_UPDATE_ORDER   ///< the LC whose buffer status was last reported comes last
+  };
+
+  /// Value returned by GetUeIndex for unknown RNTIs
+  static constexpr uint32_t NO_UE = std::numeric_limits<uint32_t>::max ();
+
+  /**
+   * Add a UE and initialize its DL state.
+   *
+   * \param rnti the RNTI of the UE, which must not be already known
+   * \param txMode the transmission mode of the UE
+   * \return the UE index assigned to the UE
+   */
+  uint32_t AddUe (uint16_t rnti, uint8_t txMode);
+  /**
+   * Remove a UE and release its UE index. Nothing is done if the UE is unknown.
+   *
+   * \param rnti the RNTI of the UE
+   */
+  void RemoveUe (uint16_t rnti);
+  /**
+   * \param rnti the RNTI of a UE
+   * \return the UE index of the given UE or NO_UE if the UE is unknown
+   */
+  uint32_t GetUeIndex (uint16_t rnti) const;
+
+  /**
+   * Store the DL RLC buffer status of a logical channel. The logical channel
+   * is created if it does not exist yet.
+   *
+   * \param ueIndex the UE index of the UE the logical channel belongs to
+   * \param params the RLC buffer status
+   * \return true if the logical channel has been created
+   */
+  bool SetDlRlcBufferStatus (uint32_t ueIndex, const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& params);
+  /**
+   * Remove a DL logical channel. Nothing is done if the logical channel does
+   * not exist.
+   *
+   * \param ueIndex the UE index of the UE the logical channel belongs to
+   * \param lcid the LCID of the logical channel
+   */
+  void ReleaseDlLc (uint32_t ueIndex, uint8_t lcid);
+  /**
+   * \brief Update DL RLC buffer info
+   *
+   * Update the RLC buffer status of a logical channel after that resources
+   * have been allocated to it.
+   *
+   * \param ueIndex the UE index
+   * \param lcid the LCID
+   * \param size the size of the allocated RLC PDU
+   */
+  void UpdateDlRlcBufferInfo (uint32_t ueIndex, uint8_t lcid, uint16_t size);
+  /**
+   * \param lc the RLC buffer status of a logical channel
+   * \return true if the logical channel has data to transmit
+   */
+  static bool IsDlLcActive (const FfMacSchedSapProvider::SchedDlRlcBufferReqParameters& lc);
+
+  /**
+   * Store a P10 (wideband) DL CQI, which is valid for the next
+   * m_cqiTimersThreshold TTIs.
+   *
+   * \param ueIndex the UE index
+   * \param cqi the wideband CQI
+   */
+  void SetDlP10Cqi (uint32_t ueIndex, uint8_t cqi);
+  /**
+   * \param ueIndex the UE index
+   * \return true if a P10 DL CQI which has not expired has been received
+   */
+  bool HasDlP10Cqi (uint32_t ueIndex) const;
+  /**
+   * Store an A30 (subband) DL CQI, which is valid for the next
+   * m_cqiTimersThreshold TTIs.
+   *
+   * \param ueIndex the UE index
+   * \param sbMeasResult the subband CQIs
+   */
+  void SetDlA30Cqi (uint32_t ueIndex, const SbMeasResult_s& sbMeasResult);
+  /**
+   * \param ueIndex the UE index
+   * \return true if an A30 DL CQI which has not expired has been received
+   */
+  bool HasDlA30Cqi (uint32_t ueIndex) const;
+  /**
+   * Refresh DL CQIs. To be called at the beginning of every DL TTI; CQIs
+   * that are older than m_cqiTimersThreshold TTIs are no longer valid.
+   */
+  void RefreshDlCqis (void);
+
+  /**
+   * \brief Return the availability of free process for the UE specified
+   *
+   * \param ueIndex the UE index
+   * \return true if a HARQ process is available
+   */
+  bool IsDlHarqProcessAvailable (uint32_t ueIndex);
+  /**
+   * \brief Update and return a new process Id for the UE specified
+   *
+   * \param ueIndex the UE index
+   * \return the process id value
+   */
+  uint8_t UpdateDlHarqProcessId (uint32_t ueIndex);
+  /**
+   * \brief Refresh HARQ processes according to the timers
+   *
+   * To be called once per DL TTI. A HARQ process for which no
+   * (re)transmission took place in the last HARQ_DL_TIMEOUT TTIs is released
+   * when it is next accessed.
+   */
+  void RefreshDlHarqProcesses (void);
+  /**
+   * Process the DL HARQ feedback received and schedule the HARQ
+   * retransmissions, including the ones buffered in previous TTIs for lack
+   * of resources.
+   *
+   * \param dlInfoList the DL HARQ feedback received
+   * \param rbgNum the number of RBGs
+   * \param rbgMap the RBGs map, updated with the RBGs used by retransmissions
+   * \param rbgAllocatedNum the number of allocated RBGs, updated
+   * \param rntiAllocated the RNTIs of the UEs with a retransmission, updated
+   * \param ret the scheduling decisions, updated with the retransmissions
+   */
+  void ScheduleDlHarqRetx (const std::vector<DlInfoListElement_s>& dlInfoList,
+                           int rbgNum, std::vector<bool>& rbgMap, uint16_t& rbgAllocatedNum,
+                           std::set<uint16_t>& rntiAllocated,
+                           FfMacSchedSapUser::SchedDlConfigIndParameters& ret);
+
+  /**
+   * Store the DCI and the RLC PDUs of a new DL transmission for HARQ
+   * retransmissions and start the HARQ timer of the process.
+   *
+   * \param ueIndex the UE index
+   * \param el the new transmission
+   */
+  void StoreDlHarqTx (uint32_t ueIndex, const BuildDataListElement_s& el);
+
+  // Per-UE state, indexed by UE index
+  std::vector<uint16_t> m_ueRnti; ///< RNTI of the UEs (0 if the UE index is unused)
+  std::vector<uint8_t> m_ueTxMode; ///< txMode of the UEs
+  /// DL RLC buffer status of the logical channels of the UEs
+  std::vector<std::vector<FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> > m_ueDlLcs;
+  std::vector<uint8_t> m_ueActiveDlLcs; ///< number of DL LCs with data to transmit of the UEs
+  std::vector<uint8_t> m_ueP10Cqi; ///< last P10 DL CQI received from the UEs
+  std::vector<SbMeasResult_s> m_ueA30Cqi; ///< last A30 DL CQI received from the UEs
+  std::vector<uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
+  //HARQ status
+  // 0: process Id available
+  // x>0: process Id equal to `x` transmission count
+  std::vector<std::array<uint8_t, HARQ_PROC_NUM> > m_dlHarqProcessesStatus; ///< DL HARQ process status
+  std::vector<DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
+  std::vector<DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
+  std::vector<DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
+
+  std::vector<uint32_t> m_dlUes; ///< indices of the UEs with at least one DL LC, sorted by RNTI
+  std::vector<uint32_t> m_activeDlUes; ///< indices of the UEs with DL data to transmit, sorted by RNTI
+
+  DlLcOrder m_dlLcOrder; ///< order of the DL LCs of a UE
+  uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
+  /**
+  * m_harqOn when false inhibit the HARQ mechanisms (by default active)
+  */
+  bool m_harqOn;
+
+private:
+  /**
+   * Insert a UE in a vector of UE indices sorted by RNTI, if not already there.
+   *
+   * \param ues the vector of UE indices
+   * \param ueIndex the UE index
+   */
+  void InsertUe (std::vector<uint32_t>& ues, uint32_t ueIndex);
+  /**
+   * Remove a UE from a vector of UE indices sorted by RNTI, if it is there.
+   *
+   * \param ues the vector of UE indices
+   * \param ueIndex the UE index
+   */
+  void EraseUe (std::vector<uint32_t>& ues, uint32_t ueIndex);
+  /**
+   * Update the number of active DL LCs of a UE (and the set of active UEs)
+   * after that the buffer status of one of its LCs changed.
+   *
+   * \param ueIndex the UE index
+   * \param wasActive whether the LC had data to transmit before the change
+   * \param isActive whether the LC has data to transmit after the change
+   */
+  void NotifyDlLcActivity (uint32_t ueIndex, bool wasActive, bool isActive);
+  /**
+   * Release the given DL HARQ process if its timer expired.
+   *
+   * \param ueIndex the UE index
+   * \param harqId the HARQ process ID
+   */
+  void CheckDlHarqTimer (uint32_t ueIndex, uint8_t harqId);
+  /**
+   * Refresh the HARQ timer of a DL HARQ process, after a (re)transmission.
+   *
+   * \param ueIndex the UE index
+   * \param harqId the HARQ process ID
+   */
+  void ResetDlHarqTimer (uint32_t ueIndex, uint8_t harqId);
+
+  std::unordered_map<uint16_t, uint32_t> m_ueIndex; ///< UE index of the UEs, per RNTI
+  std::vector<uint32_t> m_freeUeIndices; ///< UE indices released
+  /// DL TTI in which the P10 DL CQI of the UEs expires
+  std::vector<uint64_t> m_ueP10CqiExpiry;
+  /// DL TTI in which the A30 DL CQI of the UEs expires
+  std::vector<uint64_t> m_ueA30CqiExpiry;
+  /// DL TTI of the last (re)transmission of the DL HARQ processes
+  std::vector<std::array<uint64_t, HARQ_PROC_NUM> > m_dlHarqProcessesTxTti;
+  uint64_t m_dlCqiTti; ///< number of DL CQI refreshes
+  uint64_t m_dlHarqTti; ///< number of DL HARQ refreshes
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_SCHEDULER_BASE_H */
@@ -24,6 +24,11 @@
 
 #include <ns3/object.h>
 
+/// Number of DL (and UL) HARQ processes of a UE
+#define HARQ_PROC_NUM 8
+/// Number of TTIs after which an unacknowledged DL HARQ process is released
+#define HARQ_DL_TIMEOUT 11
+
 
 namespace ns3 {
 
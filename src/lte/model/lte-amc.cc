@@ -30,6 +30,10 @@
 #include <ns3/double.h>
 #include "ns3/enum.h"
 #include <ns3/lte-mi-error-model.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
 
 
 namespace ns3 {
@@ -230,7 +234,62 @@ static const int TransportBlockSizeTable [110][27] = {
 };
 
 
+/**
+ * MI thresholds of the MiErrorModel AMC model, indexed by RBG size. They do
+ * not depend on the attributes of LteAmc, hence they are shared by all the
+ * instances. They are computed on demand, and each thread has its own table,
+ * so that CQI feedbacks can be created in parallel.
+ */
+static thread_local std::map<uint8_t, std::vector<double> > g_miThresholds;
+
+/**
+ * Find the lowest non-negative value for which a monotone predicate holds
+ * (i.e., a predicate that, if it holds for a value, also holds for all the
+ * larger values). Non-negative doubles are ordered like their bit patterns,
+ * hence a binary search over the bit patterns returns the exact threshold.
+ *
+ * \param holds the predicate
+ * \return the lowest value for which the predicate holds (infinity if it
+ *         does not hold for any finite value)
+ */
+template <typename Predicate>
+static double
+FindThreshold (Predicate holds)
+{
+  const double inf = std::numeric_limits<double>::infinity ();
+  if (holds (0.0))
+    {
+      return 0.0;
+    }
+  if (!holds (inf))
+    {
+      return inf;
+    }
+  uint64_t low = 0;  // the bit pattern of 0.0
+  uint64_t high;
+  std::memcpy (&high, &inf, sizeof (high));
+  while (high - low > 1)
+    {
+      uint64_t mid = low + (high - low) / 2;
+      double value;
+      std::memcpy (&value, &mid, sizeof (value));
+      if (holds (value))
+        {
+          high = mid;
+        }
+      else
+        {
+          low = mid;
+        }
+    }
+  double threshold;
+  std::memcpy (&threshold, &high, sizeof (threshold));
+  return threshold;
+}
+
+
 LteAmc::LteAmc ()
+  : m_piroThresholdsBer (0.0)
 {
 }
 
@@ -326,16 +385,70 @@ LteAmc::GetSpectralEfficiencyFromCqi (int cqi)
 }
 
 
+const std::vector<double>&
+LteAmc::GetPiroSinrThresholds (void)
+{
+  if (m_piroSinrThresholds.empty () || m_piroThresholdsBer != m_ber)
+    {
+      NS_LOG_FUNCTION (this << m_ber);
+      /*
+       * Compute the spectral efficiency from the SINR
+       *                                        SINR
+       * spectralEfficiency = log2 (1 + -------------------- )
+       *                                    -ln(5*BER)/1.5
+       * NB: SINR must be expressed in linear units
+       */
+      double gap = (-std::log (5.0 * m_ber )) / 1.5;
+      m_piroSinrThresholds.clear ();
+      for (int cqi = 1; cqi <= 15; cqi++)
+        {
+          double se = SpectralEfficiencyForCqi[cqi];
+          m_piroSinrThresholds.push_back (FindThreshold ([gap, se] (double sinr)
+                                                         {
+                                                           return se < log2 (1 + (sinr / gap));
+                                                         }));
+        }
+      m_piroThresholdsBer = m_ber;
+    }
+  return m_piroSinrThresholds;
+}
+
+const std::vector<double>&
+LteAmc::GetMiThresholds (uint8_t rbgSize)
+{
+  auto it = g_miThresholds.find (rbgSize);
+  if (it == g_miThresholds.end ())
+    {
+      NS_LOG_FUNCTION (this << (uint16_t) rbgSize);
+      std::vector<double> thresholds;
+      for (uint8_t mcs = 0; mcs <= 28; mcs++)
+        {
+          uint16_t size = (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8;
+          thresholds.push_back (FindThreshold ([size, mcs] (double mi)
+                                               {
+                                                 HarqProcessInfoList_t harqInfoList;
+                                                 return !(LteMiErrorModel::GetTbBler (mi, size, mcs, harqInfoList) > 0.1);
+                                               }));
+        }
+      it = g_miThresholds.emplace (rbgSize, std::move (thresholds)).first;
+    }
+  return it->second;
+}
+
+
 std::vector<int>
 LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
 {
   NS_LOG_FUNCTION (this);
 
   std::vector<int> cqi;
+  cqi.reserve (sinr.GetSpectrumModel ()->GetNumBands ());
   Values::const_iterator it;
   
   if (m_amcModel == PiroEW2010)
     {
+      // the CQI is the number of thresholds not exceeding the SINR
+      const std::vector<double>& sinrThresholds = GetPiroSinrThresholds ();
 
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
         {
@@ -346,22 +459,12 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
             }
           else
             {
-              /*
-              * Compute the spectral efficiency from the SINR
-              *                                        SINR
-              * spectralEfficiency = log2 (1 + -------------------- )
-              *                                    -ln(5*BER)/1.5
-              * NB: SINR must be expressed in linear units
-              */
-
-              double s = log2 ( 1 + ( sinr_ / ( (-std::log (5.0 * m_ber )) / 1.5) ));
-
-              int cqi_ = GetCqiFromSpectralEfficiency (s);
+              int cqi_ = std::upper_bound (sinrThresholds.begin (), sinrThresholds.end (), sinr_)
+                         - sinrThresholds.begin ();
 
               NS_LOG_LOGIC (" PRB =" << cqi.size ()
                                     << ", sinr = " << sinr_
                                     << " (=" << 10 * std::log10 (sinr_) << " dB)"
-                                    << ", spectral efficiency =" << s
                                     << ", CQI = " << cqi_ << ", BER = " << m_ber);
 
               cqi.push_back (cqi_);
@@ -372,7 +475,11 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
     {
       NS_LOG_DEBUG (this << " AMC-VIENNA RBG size " << (uint16_t)rbgSize);
       NS_ASSERT_MSG (rbgSize > 0, " LteAmc-Vienna: RBG size must be greater than 0");
+      // the TB error rate of MCS i exceeds 10% if and only if the MI is below
+      // the i-th threshold
+      const std::vector<double>& miThresholds = GetMiThresholds (rbgSize);
       std::vector <int> rbgMap;
+      rbgMap.reserve (rbgSize);
       int rbId = 0;
       for (it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); it++)
       {
@@ -380,13 +487,18 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
         if ((rbId % rbgSize == 0)||((it+1)==sinr.ConstValuesEnd ()))
          {
             uint8_t mcs = 0;
-            TbStats_t tbStats;
+            double mi = 0.0;
+            bool highTbler = false;
             while (mcs <= 28)
               {
-                HarqProcessInfoList_t harqInfoList;
-                tbStats = LteMiErrorModel::GetTbDecodificationStats (sinr, rbgMap, (uint16_t)GetDlTbSizeFromMcs (mcs, rbgSize) / 8, mcs, harqInfoList);
-                if (tbStats.tbler > 0.1)
+                // the MI only depends on the modulation of the MCS
+                if (mcs == 0 || mcs == MI_QPSK_MAX_ID + 1 || mcs == MI_16QAM_MAX_ID + 1)
+                  {
+                    mi = LteMiErrorModel::Mib (sinr, rbgMap, mcs);
+                  }
+                if (mi < miThresholds[mcs])
                   {
+                    highTbler = true;
                     break;
                   }
                 mcs++;
@@ -396,9 +508,9 @@ LteAmc::CreateCqiFeedbacks (const SpectrumValue& sinr, uint8_t rbgSize)
               {
                 mcs--;
               }
-            NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " TBLER " << tbStats.tbler);
+            NS_LOG_DEBUG (this << "\t RBG " << rbId << " MCS " << (uint16_t)mcs << " MI " << mi);
             int rbgCqi = 0;
-            if ((tbStats.tbler > 0.1)&&(mcs==0))
+            if (highTbler && (mcs==0))
               {
                 rbgCqi = 0; // any MCS can guarantee the 10 % of BER
               }
@@ -101,6 +101,12 @@ public:
 
   /**
    * \brief Create a message with CQI feedback
+   *
+   * The CQIs are obtained by comparing the SINR of each RB (PiroEW2010) or the
+   * MI of each RBG (MiErrorModel) against precomputed thresholds, which yields
+   * the same CQIs as evaluating the spectral efficiency or the TB error rate of
+   * every candidate CQI/MCS.
+   *
    * \param sinr the SpectrumValue vector of SINR for evaluating the CQI
    * \param rbgSize size of RB group (in RBs) for evaluating subband/wideband CQI
    * \return a vector of CQI feedbacks
@@ -118,7 +124,35 @@ public:
   int GetCqiFromSpectralEfficiency (double s);
   
 private:
-  
+
+  /**
+   * \brief Get the SINR thresholds of the PiroEW2010 model
+   *
+   * The i-th threshold is the lowest SINR (in linear units) for which the
+   * spectral efficiency exceeds the one of CQI i+1. The thresholds are
+   * computed again whenever the requested BER changes.
+   *
+   * \return the SINR thresholds of CQIs 1 to 15
+   */
+  const std::vector<double>& GetPiroSinrThresholds (void);
+
+  /**
+   * \brief Get the MI thresholds of the MiErrorModel model
+   *
+   * The i-th threshold is the lowest MI for which a TB of MCS i spanning an
+   * RBG of the given size has an error rate not exceeding 10%. The thresholds
+   * are computed the first time they are requested for an RBG size and are
+   * shared by all the LteAmc instances running on the same thread. The
+   * search does not fill the cache of LteMiErrorModel.
+   *
+   * \param rbgSize the size of the RBG (in RBs)
+   * \return the MI thresholds of MCSs 0 to 28
+   */
+  const std::vector<double>& GetMiThresholds (uint8_t rbgSize);
+
+  std::vector<double> m_piroSinrThresholds; ///< SINR thresholds of the PiroEW2010 model
+  double m_piroThresholdsBer; ///< the BER the SINR thresholds were computed for
+
   /**
    * The `Ber` attribute.
    *
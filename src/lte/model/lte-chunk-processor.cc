@@ -24,6 +24,7 @@
 #include <ns3/log.h>
 #include <ns3/spectrum-value.h>
 #include "lte-chunk-processor.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -50,7 +51,10 @@ void
 LteChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
+  if (m_sumValues != 0)
+    {
+      std::fill (m_sumValues->ValuesBegin (), m_sumValues->ValuesEnd (), 0.0);
+    }
   m_totDuration = MicroSeconds (0);
 }
 
@@ -59,11 +63,18 @@ void
 LteChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModel () != sinr.GetSpectrumModel ())
     {
+      NS_ASSERT (m_totDuration.IsZero ());
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  // weight by the raw time steps: the unit cancels out in End ()
+  double durationSteps = static_cast<double> (duration.GetTimeStep ());
+  Values::iterator sumIt = m_sumValues->ValuesBegin ();
+  for (Values::const_iterator it = sinr.ConstValuesBegin (); it != sinr.ConstValuesEnd (); ++it, ++sumIt)
+    {
+      *sumIt += (*it) * durationSteps;
+    }
   m_totDuration += duration;
 }
 
@@ -71,12 +82,13 @@ void
 LteChunkProcessor::End ()
 {
   NS_LOG_FUNCTION (this);
-  if (m_totDuration.GetSeconds () > 0)
+  if (m_totDuration.IsStrictlyPositive ())
     {
+      double totSteps = static_cast<double> (m_totDuration.GetTimeStep ());
       std::vector<LteChunkProcessorCallback>::iterator it;
       for (it = m_lteChunkProcessorCallbacks.begin (); it != m_lteChunkProcessorCallbacks.end (); it++)
         {
-          (*it)((*m_sumValues) / m_totDuration.GetSeconds ());
+          (*it)((*m_sumValues) / totSteps);
         }
     }
   else
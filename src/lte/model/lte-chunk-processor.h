@@ -64,7 +64,8 @@ public:
     * \brief Clear internal variables
     *
     * This function clears internal variables in the beginning of
-    * calculation
+    * calculation. The buffer used to collect SpectrumValues is
+    * reused across calculations.
     */
   virtual void Start ();
 
@@ -72,6 +73,8 @@ public:
     * \brief Collect SpectrumValue and duration of signal
     *
     * Passed values are collected in m_sumValues and m_totDuration variables.
+    * Values are accumulated in place, i.e., no temporary SpectrumValue is
+    * allocated.
     *
     * \param sinr the SINR
     * \param duration the duration
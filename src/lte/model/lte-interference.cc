@@ -75,7 +75,16 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   if (m_receiving == false)
     {
       NS_LOG_LOGIC ("first signal");
-      m_rxSignal = rxPsd->Copy ();
+      if (m_rxSignal != 0 && m_rxSignal->GetSpectrumModel () == rxPsd->GetSpectrumModel ())
+        {
+          // reuse the buffer of the previous RX
+          *m_rxSignal = *rxPsd;
+        }
+      else
+        {
+          m_rxSignal = rxPsd->Copy ();
+        }
+      m_allRbsStale = true;
       m_lastChangeTime = Now ();
       m_receiving = true;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
@@ -99,6 +108,7 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
       // make sure they use orthogonal resource blocks
       NS_ASSERT (Sum ((*rxPsd) * (*m_rxSignal)) == 0.0);
       (*m_rxSignal) += (*rxPsd);
+      MarkStaleRbs (*rxPsd);
     }
 }
 
@@ -156,6 +166,7 @@ LteInterference::DoAddSignal (Ptr<const SpectrumValue> spd)
   NS_LOG_FUNCTION (this << *spd);
   ConditionallyEvaluateChunk ();
   (*m_allSignals) += (*spd);
+  MarkStaleRbs (*spd);
 }
 
 void
@@ -167,6 +178,7 @@ LteInterference::DoSubtractSignal (Ptr<const SpectrumValue> spd, uint32_t signal
   if (deltaSignalId > 0)
     {   
       (*m_allSignals) -= (*spd);
+      MarkStaleRbs (*spd);
     }
   else
     {
@@ -188,17 +200,18 @@ LteInterference::ConditionallyEvaluateChunk ()
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+      // only the RBs affected by the signals added or removed since the last
+      // evaluation need to be updated
+      UpdateStaleRbs ();
 
-      SpectrumValue sinr = (*m_rxSignal) / interf;
       Time duration = Now () - m_lastChangeTime;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (*m_sinr, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (interf, duration);
+          (*it)->EvaluateChunk (*m_interf, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
         {
@@ -217,6 +230,11 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // reset m_allSignals (will reset if already set previously)
   // this is needed since this method can potentially change the SpectrumModel
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_interf = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_isStaleRb.assign (noisePsd->GetSpectrumModel ()->GetNumBands (), 0);
+  m_staleRbs.clear ();
+  m_allRbsStale = true;
   if (m_receiving == true)
     {
       // abort rx
@@ -227,6 +245,57 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   m_lastSignalIdBeforeReset = m_lastSignalId;
 }
 
+void
+LteInterference::MarkStaleRbs (const SpectrumValue& spd)
+{
+  if (m_allRbsStale || !m_receiving)
+    {
+      // all the RBs are recomputed at the first evaluation of the next RX
+      return;
+    }
+  std::size_t rb = 0;
+  for (Values::const_iterator it = spd.ConstValuesBegin (); it != spd.ConstValuesEnd (); ++it, ++rb)
+    {
+      if (*it != 0.0 && !m_isStaleRb[rb])
+        {
+          m_isStaleRb[rb] = 1;
+          m_staleRbs.push_back (rb);
+        }
+    }
+}
+
+void
+LteInterference::UpdateRb (std::size_t rb)
+{
+  (*m_interf)[rb] = (*m_allSignals)[rb] - (*m_rxSignal)[rb] + (*m_noise)[rb];
+  (*m_sinr)[rb] = (*m_rxSignal)[rb] / (*m_interf)[rb];
+}
+
+void
+LteInterference::UpdateStaleRbs ()
+{
+  if (m_allRbsStale)
+    {
+      for (std::size_t rb = 0; rb < m_isStaleRb.size (); rb++)
+        {
+          UpdateRb (rb);
+        }
+      m_allRbsStale = false;
+    }
+  else
+    {
+      for (std::size_t rb : m_staleRbs)
+        {
+          UpdateRb (rb);
+        }
+    }
+  for (std::size_t rb : m_staleRbs)
+    {
+      m_isStaleRb[rb] = 0;
+    }
+  m_staleRbs.clear ();
+}
+
 void
 LteInterference::AddRsPowerChunkProcessor (Ptr<LteChunkProcessor> p)
 {
@@ -28,6 +28,7 @@
 #include <ns3/spectrum-value.h>
 
 #include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -129,6 +130,26 @@ protected:
    */
   virtual void DoSubtractSignal (Ptr<const SpectrumValue> spd, uint32_t signalId);
 
+  /**
+   * Mark the RBs used by the given signal as RBs whose interference and SINR
+   * have to be recomputed before the next chunk is evaluated
+   *
+   * @param spd the power spectral density of the signal
+   */
+  void MarkStaleRbs (const SpectrumValue& spd);
+
+  /**
+   * Recompute the interference and the SINR of the given RB
+   *
+   * @param rb the index of the RB
+   */
+  void UpdateRb (std::size_t rb);
+
+  /**
+   * Recompute the interference and the SINR of the stale RBs
+   */
+  void UpdateStaleRbs ();
+
   bool m_receiving {false}; ///< are we receiving?
 
   Ptr<SpectrumValue> m_rxSignal {nullptr}; /**< stores the power spectral density of
@@ -143,6 +164,21 @@ protected:
 
   Ptr<const SpectrumValue> m_noise {nullptr}; ///< the noise value
 
+  Ptr<SpectrumValue> m_interf {nullptr}; /**< the interference plus noise
+                                          * perceived by the signal being RX;
+                                          * only up to date for the RBs that
+                                          * are not stale
+                                          */
+
+  Ptr<SpectrumValue> m_sinr {nullptr}; /**< the SINR of the signal being RX;
+                                        * only up to date for the RBs that
+                                        * are not stale
+                                        */
+
+  std::vector<uint8_t> m_isStaleRb; ///< whether each RB is stale
+  std::vector<std::size_t> m_staleRbs; ///< the indices of the stale RBs
+  bool m_allRbsStale {true}; ///< whether all the RBs are stale
+
   Time m_lastChangeTime {Seconds(0)}; /**< the time of the last change in
                                        * m_TotalPower
                                        */
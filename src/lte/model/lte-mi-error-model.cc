@@ -35,6 +35,8 @@
 #include <ns3/pointer.h>
 #include <stdint.h>
 #include <cmath>
+#include <cstring>
+#include <algorithm>
 #include "stdlib.h"
 #include <ns3/lte-mi-error-model.h>
 
@@ -331,83 +333,137 @@ static const double cEcrTable [9][38] = {
 };
 
 
-double 
-LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// Uniformly spaced MI map of a modulation
+struct MiMap
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  const double *mi;      ///< MI values
+  const double *axis;    ///< SINR values (linear), uniformly spaced
+  uint16_t size;         ///< number of values
+  double scalingCoeff;   ///< (size - 1) / (axis[size - 1] - axis[0])
+};
+
+/// MI map QPSK (uniform grid)
+static const MiMap MiMapQpsk = {MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE,
+                                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0])};
+/// MI map 16QAM (uniform grid)
+static const MiMap MiMap16qam = {MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE,
+                                 (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0])};
+/// MI map 64QAM (uniform grid)
+static const MiMap MiMap64qam = {MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE,
+                                 (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0])};
+
+/**
+ * \brief get the MI corresponding to the given SINR
+ * \param sinrLin the SINR (linear)
+ * \param miMap the MI map of the modulation in use
+ * \return the MI
+ */
+static inline double
+GetMiFromSinr (double sinrLin, const MiMap& miMap)
+{
+  if (sinrLin > miMap.axis[miMap.size-1])
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
+      return 1;
+    }
+  // since the values in the axis are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  double sinrIndexDouble = (sinrLin - miMap.axis[0]) * miMap.scalingCoeff + 1;
+  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+  NS_ASSERT_MSG (sinrIndex < miMap.size, "MI map out of data");
+  return miMap.mi[sinrIndex];
+}
 
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
+/**
+ * Parameters of the BLER curves (see bEcrTable and cEcrTable) for every CB size
+ * and ECR, where missing values are replaced by the values of the lowest CB size
+ * including the CB (for removing CB size quantization errors).
+ */
+struct BlerCurveParams
+{
+  BlerCurveParams ();
+  double b[9][38];  ///< b parameter of the BLER curve
+  double c[9][38];  ///< c parameter of the BLER curve
+};
+
+BlerCurveParams::BlerCurveParams ()
+{
+  for (int cbIndex = 0; cbIndex < 9; cbIndex++)
+    {
+      for (int ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
+          double bValue = bEcrTable[cbIndex][ecrId];
+          int i = cbIndex;
+          while ((i<9)&&(bValue<0))
             {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
+              bValue = bEcrTable[i++][ecrId];
             }
-          else // 64-QAM
+          double cValue = cEcrTable[cbIndex][ecrId];
+          i = cbIndex;
+          while ((i<9)&&(cValue<0))
             {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
+              cValue = cEcrTable[i++][ecrId];
             }
+          b[cbIndex][ecrId] = bValue;
+          c[cbIndex][ecrId] = cValue;
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+    }
+}
+
+/// BLER curve parameters
+static const BlerCurveParams g_blerCurveParams;
+
+/// Size of the cache of the BLER of first transmissions of TBs
+static const uint16_t TB_BLER_CACHE_SIZE = 512;
+
+/// Entry of the cache of the BLER of first transmissions of TBs
+struct TbBlerCacheEntry
+{
+  bool valid;     ///< whether the entry is valid
+  uint8_t mcs;    ///< MCS of the TB
+  uint16_t size;  ///< size of the TB in bytes
+  double mi;      ///< MI of the TB
+  double tbler;   ///< BLER of the TB
+};
+
+/**
+ * Direct-mapped cache of the BLER of first transmissions of TBs. The BLER only
+ * depends on the MCS, the size and the MI of the TB, and the MI of a TB is the
+ * mean of values taken from the MI maps, hence the same key is frequently
+ * found, e.g., when the channel is flat or does not change over time. Each
+ * thread has its own cache, so that receptions can be evaluated in parallel.
+ */
+static thread_local TbBlerCacheEntry g_tbBlerCache[TB_BLER_CACHE_SIZE];
+
+/**
+ * \param mcs the MCS of the TB
+ * \param size the size of the TB in bytes
+ * \param mi the MI of the TB
+ * \return the entry of the TB BLER cache to use for the given key
+ */
+static TbBlerCacheEntry&
+GetTbBlerCacheEntry (uint8_t mcs, uint16_t size, double mi)
+{
+  uint64_t miBits;
+  std::memcpy (&miBits, &mi, sizeof (miBits));
+  uint64_t h = (miBits ^ (miBits >> 29) ^ (static_cast<uint64_t> (size) << 5) ^ mcs) * 0x9e3779b97f4a7c15ULL;
+  return g_tbBlerCache[(h >> 32) % TB_BLER_CACHE_SIZE];
+}
+
+double 
+LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+
+  const MiMap& miMap = (mcs <= MI_QPSK_MAX_ID ? MiMapQpsk
+                        : (mcs <= MI_16QAM_MAX_ID ? MiMap16qam : MiMap64qam));
+  double MI;
+  double MIsum = 0.0;
+
+  for (uint32_t i = 0; i < map.size (); i++)
+    {
+      double sinrLin = sinr[map[i]];
+      MI = GetMiFromSinr (sinrLin, miMap);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -432,28 +488,9 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  b = g_blerCurveParams.b[cbIndex][ecrId];
+  c = g_blerCurveParams.c[cbIndex][ecrId];
+
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
   double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
   NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
@@ -461,49 +498,26 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 }
 
 
-
 double
 LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 {
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
+      MI = GetMiFromSinr (*sinrIt, MiMapQpsk);
       MIsum += MI;
       sinrIt++;
       rb++;
     }
   MI = MIsum / rb;
-  // return to the effective SINR value
-  int j = 0;
+  // return to the effective SINR value (the MI map is strictly increasing)
+  int j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
   double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
-    }
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
       esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
@@ -531,12 +545,9 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
   double esirnDb = 10*log10 (esinr); 
 //   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
+  uint16_t i = std::lower_bound (PdcchPcfichBlerCurveXaxis, PdcchPcfichBlerCurveXaxis + PDCCH_PCFICH_CURVE_SIZE, esirnDb)
+               - PdcchPcfichBlerCurveXaxis;
   double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
   if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
     {
       errorRate = 0.0;
@@ -554,11 +565,35 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib(sinr, map, mcs);
+  TbStats_t ret;
+  ret.mi = Mib (sinr, map, mcs);
+  if (!miHistory.empty ())
+    {
+      ret.tbler = GetTbBler (ret.mi, size, mcs, miHistory);
+      return ret;
+    }
+  // first transmission: the error rate only depends on MCS, size and MI
+  TbBlerCacheEntry& entry = GetTbBlerCacheEntry (mcs, size, ret.mi);
+  if (entry.valid && entry.mcs == mcs && entry.size == size && entry.mi == ret.mi)
+    {
+      NS_LOG_LOGIC (" Error rate " << entry.tbler << " (cached)");
+      ret.tbler = entry.tbler;
+      return ret;
+    }
+  ret.tbler = GetTbBler (ret.mi, size, mcs, miHistory);
+  entry = {true, mcs, size, ret.mi, ret.tbler};
+  return ret;
+}
+
+double
+LteMiErrorModel::GetTbBler (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
@@ -733,10 +768,7 @@ LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std:
     }
 
   NS_LOG_LOGIC (" Error rate " << errorRate);
-  TbStats_t ret;
-  ret.tbler = errorRate;
-  ret.mi = tbMi;
-  return ret;
+  return errorRate;
 }
 
 
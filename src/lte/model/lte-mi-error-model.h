@@ -102,6 +102,11 @@ public:
 
   /**
    * \brief run the error-model algorithm for the specified TB
+   *
+   * The error rates of first transmissions are cached (the cache is keyed by
+   * the MCS, the size and the MI of the TB), so that the BLER curves are not
+   * evaluated again for TBs received over an unchanged channel.
+   *
    * \param sinr the perceived sinr values in the whole bandwidth in Watt
    * \param map the active RBs for the TB
    * \param size the size in bytes of the TB
@@ -109,7 +114,23 @@ public:
    * \param miHistory MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
+
+  /**
+   * \brief run the error-model algorithm for the specified TB, given its MI
+   *
+   * This is the part of GetTbDecodificationStats that follows the evaluation
+   * of the MI of the TB; it is useful to callers that evaluate the same TB
+   * with several MCSs of the same modulation (e.g., the AMC module). Unlike
+   * GetTbDecodificationStats, it does not use the cache of the error rates.
+   *
+   * \param mi the MI of the TB
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \param miHistory MI of past transmissions (in case of retx)
+   * \return the TB error rate
+   */
+  static double GetTbBler (double mi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -212,12 +212,15 @@ LtePdcp::DoReceivePdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
 
-  // Receiver timestamp
-  PdcpTag pdcpTag;
-  Time delay;
-  p->FindFirstMatchingByteTag (pdcpTag);
-  delay = Simulator::Now() - pdcpTag.GetSenderTimestamp ();
-  m_rxPdu(m_rnti, m_lcid, p->GetSize (), delay.GetNanoSeconds ());
+  // Receiver timestamp, only looked up for the trace
+  if (!m_rxPdu.IsEmpty ())
+    {
+      PdcpTag pdcpTag;
+      Time delay;
+      p->FindFirstMatchingByteTag (pdcpTag);
+      delay = Simulator::Now() - pdcpTag.GetSenderTimestamp ();
+      m_rxPdu(m_rnti, m_lcid, p->GetSize (), delay.GetNanoSeconds ());
+    }
 
   LtePdcpHeader pdcpHeader;
   p->RemoveHeader (pdcpHeader);
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <map>
+#include <deque>
 
 namespace ns3 {
 
@@ -119,16 +120,18 @@ private:
      */
     TxPdu (const Ptr<Packet> &pdu, const Time &time) :
       m_pdu (pdu),
-      m_waitingSince (time)
+      m_waitingSince (time),
+      m_offset (0)
     { }
 
     TxPdu () = delete;
 
     Ptr<Packet> m_pdu;           ///< PDU
     Time        m_waitingSince;  ///< Layer arrival time
+    uint32_t    m_offset;        ///< Bytes of the PDU already segmented
   };
 
-  std::vector < TxPdu > m_txonBuffer; ///< Transmission buffer
+  std::deque < TxPdu > m_txonBuffer; ///< Transmission buffer
 
   /// RetxPdu structure
   struct RetxPdu
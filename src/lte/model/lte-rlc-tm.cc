@@ -165,7 +165,7 @@ LteRlcTm::DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << rxPduParams.p->GetSize ());
 
-  m_rxPdu (m_rnti, m_lcid, rxPduParams.p->GetSize (), 0);
+  NS_TRACED_CALLBACK_FIRE (m_rxPdu, m_rnti, m_lcid, rxPduParams.p->GetSize (), 0);
 
   // 5.1.1.2 Receive operations 
   // 5.1.1.2.1  General
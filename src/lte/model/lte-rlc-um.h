@@ -26,6 +26,7 @@
 
 #include <ns3/event-id.h>
 #include <map>
+#include <deque>
 
 namespace ns3 {
 
@@ -109,16 +110,18 @@ private:
      */
     TxPdu (const Ptr<Packet> &pdu, const Time &time) :
       m_pdu (pdu),
-      m_waitingSince (time)
+      m_waitingSince (time),
+      m_offset (0)
     { }
 
     TxPdu () = delete;
 
     Ptr<Packet> m_pdu;           ///< PDU
     Time        m_waitingSince;  ///< Layer arrival time
+    uint32_t    m_offset;        ///< Bytes of the PDU already segmented
   };
 
-  std::vector < TxPdu > m_txBuffer; ///< Transmission buffer
+  std::deque < TxPdu > m_txBuffer; ///< Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
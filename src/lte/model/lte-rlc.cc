@@ -171,6 +171,33 @@ LteRlc::GetLteMacSapUser ()
   return m_macSapUser;
 }
 
+Ptr<Packet>
+LteRlc::BuildDataField (const std::vector<SduSegment> &dataField)
+{
+  NS_ASSERT_MSG (!dataField.empty (), "Empty data field");
+  Ptr<Packet> packet;
+  for (std::vector<SduSegment>::const_iterator it = dataField.begin (); it != dataField.end (); ++it)
+    {
+      NS_LOG_LOGIC ("Adding SDU/segment to packet, length = " << it->m_size);
+      bool fullSdu = (it->m_offset == 0) && (it->m_size == it->m_sdu->GetSize ());
+      if (packet == 0)
+        {
+          // the first segment becomes the PDU, so it must not share the
+          // Packet object with the SDU
+          packet = fullSdu ? it->m_sdu->Copy () : it->m_sdu->CreateFragment (it->m_offset, it->m_size);
+        }
+      else if (fullSdu)
+        {
+          packet->AddAtEnd (it->m_sdu);
+        }
+      else
+        {
+          packet->AddAtEnd (it->m_sdu->CreateFragment (it->m_offset, it->m_size));
+        }
+    }
+  return packet;
+}
+
 
 
 ////////////////////////////////////////
@@ -27,6 +27,7 @@
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/nstime.h"
+#include <vector>
 
 #include "ns3/object.h"
 
@@ -144,6 +145,25 @@ protected:
   LteRlcSapUser* m_rlcSapUser; ///< RLC SAP user
   LteRlcSapProvider* m_rlcSapProvider; ///< RLC SAP provider
 
+  /**
+   * \brief Byte range of an RLC SDU mapped to the data field of an RLC PDU
+   */
+  struct SduSegment
+  {
+    Ptr<Packet> m_sdu;  ///< RLC SDU
+    uint32_t m_offset;  ///< offset of the segment in the SDU
+    uint32_t m_size;    ///< size of the segment
+  };
+
+  /**
+   * Build the data field of an RLC PDU. The SDUs are left untouched and
+   * only the returned packet is allocated.
+   *
+   * \param dataField the SDU segments, in transmission order
+   * \return the packet holding the concatenated SDU segments
+   */
+  static Ptr<Packet> BuildDataField (const std::vector<SduSegment> &dataField);
+
   // Interface forwarded by LteMacSapUser
   /**
    * Notify transmit opportunity
@@ -1064,7 +1064,10 @@ LteSpectrumPhy::EndRxData ()
 
                   if (!m_ltePhyRxDataEndOkCallback.IsNull ())
                     {
-                      m_ltePhyRxDataEndOkCallback (*j);
+                      // the burst is shared with the other receivers of
+                      // the signal, hand over a private copy of the packet
+                      // since the upper layers will remove its headers
+                      m_ltePhyRxDataEndOkCallback ((*j)->Copy ());
                     }
                 }
               else
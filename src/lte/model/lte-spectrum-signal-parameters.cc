@@ -39,7 +39,8 @@ LteSpectrumSignalParameters::LteSpectrumSignalParameters (const LteSpectrumSigna
   : SpectrumSignalParameters (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  packetBurst = p.packetBurst->Copy ();
+  // the burst is shared by all the receivers, see packetBurst
+  packetBurst = p.packetBurst;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -61,10 +62,8 @@ LteSpectrumSignalParametersDataFrame::LteSpectrumSignalParametersDataFrame (cons
 {
   NS_LOG_FUNCTION (this << &p);
   cellId = p.cellId;
-  if (p.packetBurst)
-    {
-      packetBurst = p.packetBurst->Copy ();
-    }
+  // the burst is shared by all the receivers, see packetBurst
+  packetBurst = p.packetBurst;
   ctrlMsgList = p.ctrlMsgList;
 }
 
@@ -54,7 +54,9 @@ struct LteSpectrumSignalParameters : public SpectrumSignalParameters
   LteSpectrumSignalParameters (const LteSpectrumSignalParameters& p);
 
   /**
-   * The packet burst being transmitted with this signal
+   * The packet burst being transmitted with this signal. The burst is
+   * not copied by Copy (): all the receivers of the signal share it with
+   * the transmitter, so it must be treated as read-only.
    */
   Ptr<PacketBurst> packetBurst;
 };
@@ -85,7 +87,9 @@ struct LteSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
   LteSpectrumSignalParametersDataFrame (const LteSpectrumSignalParametersDataFrame& p);
   
   /**
-  * The packet burst being transmitted with this signal
+  * The packet burst being transmitted with this signal. The burst is
+  * not copied by Copy (): all the receivers of the signal share it with
+  * the transmitter, so it must be treated as read-only.
   */
   Ptr<PacketBurst> packetBurst;
   
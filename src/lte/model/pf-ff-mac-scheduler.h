@@ -24,7 +24,7 @@
 #include <ns3/lte-common.h>
 #include <ns3/ff-mac-csched-sap.h>
 #include <ns3/ff-mac-sched-sap.h>
-#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-base.h>
 #include <vector>
 #include <map>
 #include <ns3/nstime.h>
@@ -36,18 +36,9 @@
 #define NO_SINR -5000
 
 
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
-
 namespace ns3 {
 
 
-typedef std::vector < uint8_t > DlHarqProcessesStatus_t;
-typedef std::vector < uint8_t > DlHarqProcessesTimer_t;
-typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t;
-typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; // vector of the LCs and layers per UE
-typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t; // vector of the 8 HARQ processes per UE
-
 typedef std::vector < UlDciListElement_s > UlHarqProcessesDciBuffer_t;
 typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
 
@@ -66,10 +57,12 @@ struct pfsFlowPerf_t
  * \ingroup ff-api
  * \brief Implements the SCHED SAP and CSCHED SAP for a Proportional Fair scheduler
  *
- * This class implements the interface defined by the FfMacScheduler abstract class
+ * This class implements the interface defined by the FfMacScheduler abstract class.
+ * The DL state of the UEs is stored by FfMacSchedulerBase: in every TTI, only the
+ * UEs with DL data to transmit are evaluated for each RBG.
  */
 
-class PfFfMacScheduler : public FfMacScheduler
+class PfFfMacScheduler : public FfMacSchedulerBase
 {
 public:
   /**
@@ -135,6 +128,18 @@ private:
    */
   void DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
 
+  /**
+   * Add a UE and create its UL HARQ buffers and flow statistics. As in the map-based
+   * implementation, the LC configuration and the RLC buffer status reports of
+   * a UE that is not configured yet are stored: the UE is then added with
+   * transmission mode 0, which is updated when the UE is configured.
+   *
+   * \param rnti the RNTI of the UE, which must not be already known
+   * \param txMode the transmission mode of the UE
+   * \return the UE index assigned to the UE
+   */
+  uint32_t AddUeState (uint16_t rnti, uint8_t txMode);
+
   /**
    * \brief CSched LC config request
    *
@@ -246,14 +251,6 @@ private:
    */
   int GetRbgSize (int dlbandwidth);
 
-  /**
-   * \brief LC active per flow
-   *
-   * \param rnti the RNTI
-   * \returns the LC active per flow
-   */
-  unsigned int LcActivePerFlow (uint16_t rnti);
-
   /**
    * \brief Estimate UL SINR
    *
@@ -263,19 +260,9 @@ private:
    */
   double EstimateUlSinr (uint16_t rnti, uint16_t rb);
 
-  /// Refresh DL CQI maps
-  void RefreshDlCqiMaps (void);
   /// Refresh UL CQI maps
   void RefreshUlCqiMaps (void);
 
-  /**
-   * \brief Update DL RCL buffer info
-   *
-   * \param rnti the RNTI
-   * \param lcid the LCID
-   * \param size the size
-   */
-  void UpdateDlRlcBufferInfo (uint16_t rnti, uint8_t lcid, uint16_t size);
   /**
    * \brief Update UL RCL buffer info
    *
@@ -285,63 +272,44 @@ private:
   void UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size);
 
   /**
-  * \brief Update and return a new process Id for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t UpdateHarqProcessId (uint16_t rnti);
-
-  /**
-  * \brief Return the availability of free process for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t HarqProcessAvailability (uint16_t rnti);
-
+   * \brief Get the DL statistics of a UE, after applying the updates of the
+   * average throughput of the TTIs in which nothing was transmitted to the UE
+   *
+   * \param ueIndex the UE index
+   * \returns the DL statistics of the UE
+   */
+  pfsFlowPerf_t& GetDlFlowStats (uint32_t ueIndex);
   /**
-  * \brief Refresh HARQ processes according to the timers
-  *
-  */
-  void RefreshHarqProcesses ();
+   * \brief Update the average throughput with the bytes transmitted in the last TTI
+   *
+   * \param stats the statistics of a UE
+   */
+  void UpdateAveragedThroughput (pfsFlowPerf_t& stats);
 
   Ptr<LteAmc> m_amc; ///< AMC
 
   /**
-   * Vectors of UE's LC info
-  */
-  std::map <LteFlowId_t, FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
-
-
-  /**
-  * Map of UE statistics (per RNTI basis) in downlink
+  * UE statistics (per UE index) in downlink
   */
-  std::map <uint16_t, pfsFlowPerf_t> m_flowStatsDl;
-
+  std::vector <pfsFlowPerf_t> m_flowStatsDl;
   /**
-  * Map of UE statistics (per RNTI basis)
+  * Whether the DL statistics of the UEs (per UE index) have been initialized
   */
-  std::map <uint16_t, pfsFlowPerf_t> m_flowStatsUl;
-
-
+  std::vector <bool> m_hasFlowStatsDl;
   /**
-  * Map of UE's DL CQI P01 received
+  * Number of updates of the average throughput applied to the DL statistics
+  * of the UEs (per UE index)
   */
-  std::map <uint16_t,uint8_t> m_p10CqiRxed;
+  std::vector <uint64_t> m_flowStatsDlUpdates;
   /**
-  * Map of UE's timers on DL CQI P01 received
+  * Number of TTIs in which the DL average throughputs have been updated
   */
-  std::map <uint16_t,uint32_t> m_p10CqiTimers;
+  uint64_t m_dlThroughputUpdates;
 
   /**
-  * Map of UE's DL CQI A30 received
-  */
-  std::map <uint16_t,SbMeasResult_s> m_a30CqiRxed;
-  /**
-  * Map of UE's timers on DL CQI A30 received
+  * Map of UE statistics (per RNTI basis)
   */
-  std::map <uint16_t,uint32_t> m_a30CqiTimers;
+  std::map <uint16_t, pfsFlowPerf_t> m_flowStatsUl;
 
   /**
   * Map of previous allocated UE per RBG
@@ -381,25 +349,7 @@ private:
 
   uint16_t m_nextRntiUl; ///< RNTI of the next user to be served next scheduling in UL
 
-  uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
-
-  std::map <uint16_t,uint8_t> m_uesTxMode; ///< txMode of the UEs
-
   // HARQ attributes
-  /**
-  * m_harqOn when false inhibit the HARQ mechanisms (by default active)
-  */
-  bool m_harqOn;
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer
-  std::map <uint16_t, DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-  std::map <uint16_t, DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
-  std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
-
   std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
   //HARQ status
   // 0: process Id available
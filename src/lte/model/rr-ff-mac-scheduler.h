@@ -24,25 +24,16 @@
 
 #include <ns3/ff-mac-csched-sap.h>
 #include <ns3/ff-mac-sched-sap.h>
-#include <ns3/ff-mac-scheduler.h>
+#include <ns3/ff-mac-scheduler-base.h>
 #include <vector>
 #include <map>
 #include <ns3/lte-common.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
 
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
-
 namespace ns3 {
 
 
-typedef std::vector < uint8_t > DlHarqProcessesStatus_t;
-typedef std::vector < uint8_t > DlHarqProcessesTimer_t;
-typedef std::vector < DlDciListElement_s > DlHarqProcessesDciBuffer_t;
-typedef std::vector < std::vector <struct RlcPduListElement_s> > RlcPduList_t; // vector of the LCs and layers per UE
-typedef std::vector < RlcPduList_t > DlHarqRlcPduListBuffer_t; // vector of the 8 HARQ processes per UE
-
 typedef std::vector < UlDciListElement_s > UlHarqProcessesDciBuffer_t;
 typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
 
@@ -53,10 +44,12 @@ typedef std::vector < uint8_t > UlHarqProcessesStatus_t;
  * \ingroup ff-api
  * \brief Implements the SCHED SAP and CSCHED SAP for a Round Robin scheduler
  *
- * This class implements the interface defined by the FfMacScheduler abstract class
+ * This class implements the interface defined by the FfMacScheduler abstract class.
+ * The DL state of the UEs is stored by FfMacSchedulerBase: in every TTI, only the
+ * UEs with DL data to transmit are visited by the round robin.
  */
 
-class RrFfMacScheduler : public FfMacScheduler
+class RrFfMacScheduler : public FfMacSchedulerBase
 {
 public:
   /**
@@ -119,6 +112,18 @@ private:
    */
   void DoCschedUeConfigReq (const struct FfMacCschedSapProvider::CschedUeConfigReqParameters& params);
 
+  /**
+   * Add a UE and create its UL HARQ buffers. As in the map-based
+   * implementation, the LC configuration and the RLC buffer status reports of
+   * a UE that is not configured yet are stored: the UE is then added with
+   * transmission mode 0, which is updated when the UE is configured.
+   *
+   * \param rnti the RNTI of the UE, which must not be already known
+   * \param txMode the transmission mode of the UE
+   * \return the UE index assigned to the UE
+   */
+  uint32_t AddUeState (uint16_t rnti, uint8_t txMode);
+
   /**
    * \brief CSched LC config request
    * \param params FfMacCschedSapProvider::CschedLcConfigReqParameters
@@ -215,26 +220,9 @@ private:
    */
   int GetRbgSize (int dlbandwidth);
 
-  /**
-   * \brief Sort RLC buffer request function
-   * \param i FfMacSchedSapProvider::SchedDlRlcBufferReqParameters
-   * \param j FfMacSchedSapProvider::SchedDlRlcBufferReqParameters
-   * \returns true if
-   */
-  static bool SortRlcBufferReq (FfMacSchedSapProvider::SchedDlRlcBufferReqParameters i,FfMacSchedSapProvider::SchedDlRlcBufferReqParameters j);
-
-  /// Refresh DL CQI maps function
-  void RefreshDlCqiMaps (void);
   /// Refresh UL CQI maps function
   void RefreshUlCqiMaps (void);
 
-  /**
-   * \brief Update DL RLC buffer info function
-   * \param rnti the RNTI
-   * \param lcid the LCID
-   * \param size the size
-   */
-  void UpdateDlRlcBufferInfo (uint16_t rnti, uint8_t lcid, uint16_t size);
   /**
    * \brief Update UL RLC buffer info function
    * \param rnti the RNTI
@@ -242,44 +230,8 @@ private:
    */
   void UpdateUlRlcBufferInfo (uint16_t rnti, uint16_t size);
 
-  /**
-  * \brief Update and return a new process Id for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t UpdateHarqProcessId (uint16_t rnti);
-
-  /**
-  * \brief Return the availability of free process for the RNTI specified
-  *
-  * \param rnti the RNTI of the UE to be updated
-  * \return the process id  value
-  */
-  uint8_t HarqProcessAvailability (uint16_t rnti);
-
-  /**
-  * \brief Refresh HARQ processes according to the timers
-  *
-  */
-  void RefreshHarqProcesses ();
-
   Ptr<LteAmc> m_amc; ///< AMC
 
-  /**
-   * Vectors of UE's RLC info
-  */
-  std::list <FfMacSchedSapProvider::SchedDlRlcBufferReqParameters> m_rlcBufferReq;
-
-  /**
-  * Map of UE's DL CQI P01 received
-  */
-  std::map <uint16_t,uint8_t> m_p10CqiRxed;
-  /**
-  * Map of UE's timers on DL CQI P01 received
-  */
-  std::map <uint16_t,uint32_t> m_p10CqiTimers;
-
   /**
   * Map of previous allocated UE per RBG
   * (used to retrieve info from UL-CQI)
@@ -318,27 +270,7 @@ private:
   uint16_t m_nextRntiDl; ///< RNTI of the next user to be served next scheduling in DL
   uint16_t m_nextRntiUl; ///< RNTI of the next user to be served next scheduling in UL
 
-  uint32_t m_cqiTimersThreshold; ///< # of TTIs for which a CQI can be considered valid
-
-  std::map <uint16_t,uint8_t> m_uesTxMode; ///< txMode of the UEs
-  
-
-
   // HARQ attributes
-  /**
-  * m_harqOn when false inhibit the HARQ mechanisms (by default active)
-  */
-  bool m_harqOn;
-  std::map <uint16_t, uint8_t> m_dlHarqCurrentProcessId; ///< DL HARQ current process ID
-  //HARQ status
-  // 0: process Id available
-  // x>0: process Id equal to `x` transmission count
-  std::map <uint16_t, DlHarqProcessesStatus_t> m_dlHarqProcessesStatus; ///< DL HARQ process status
-  std::map <uint16_t, DlHarqProcessesTimer_t> m_dlHarqProcessesTimer; ///< DL HARQ process timer
-  std::map <uint16_t, DlHarqProcessesDciBuffer_t> m_dlHarqProcessesDciBuffer; ///< DL HARQ process DCI buffer
-  std::map <uint16_t, DlHarqRlcPduListBuffer_t> m_dlHarqProcessesRlcPduListBuffer; ///< DL HARQ process RLC PDU list buffer
-  std::vector <DlInfoListElement_s> m_dlInfoListBuffered; ///< HARQ retx buffered
-
   std::map <uint16_t, uint8_t> m_ulHarqCurrentProcessId; ///< UL HARQ current process ID
   //HARQ status
   // 0: process Id available
@@ -38,8 +38,6 @@
 #define NO_SINR -5000
 
 
-#define HARQ_PROC_NUM 8
-#define HARQ_DL_TIMEOUT 11
 
 namespace ns3 {
 
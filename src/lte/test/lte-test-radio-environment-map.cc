@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/radio-environment-map-helper.h>
+
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteRadioEnvironmentMapTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Compare the REM computed with DirectComputation against the REM
+ * obtained by simulating the transmissions of the eNBs.
+ *
+ * Two eNBs transmit on the DL channel and the map covers both cells. The
+ * direct engine is run with 1 and with several threads; every point must
+ * have the same SINR as with the simulated engine, within the precision of
+ * the ASCII output.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param numThreads the number of threads of the direct engine
+   */
+  LteRadioEnvironmentMapTestCase (uint32_t numThreads);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Build the scenario, generate a REM and read it back
+   *
+   * \param directComputation whether the REM is computed directly
+   * \param numThreads the number of threads of the direct engine
+   * \param filename the file the REM is written to
+   * \return the lines of the REM, as (x, y, z, SINR) tuples
+   */
+  std::vector<std::vector<double> > GenerateRem (bool directComputation, uint32_t numThreads,
+                                                 std::string filename);
+
+  uint32_t m_numThreads; ///< the number of threads of the direct engine
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase (uint32_t numThreads)
+  : TestCase ("REM with DirectComputation and " + std::to_string (numThreads) + " thread(s)"),
+    m_numThreads (numThreads)
+{
+}
+
+std::vector<std::vector<double> >
+LteRadioEnvironmentMapTestCase::GenerateRem (bool directComputation, uint32_t numThreads,
+                                             std::string filename)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 30));
+  positionAlloc->Add (Vector (500, 0, 30));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  // the DL channel is the first channel created by the LteHelper
+  Ptr<RadioEnvironmentMapHelper> remHelper = CreateObject<RadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("ChannelPath", StringValue ("/ChannelList/0"));
+  remHelper->SetAttribute ("OutputFile", StringValue (filename));
+  remHelper->SetAttribute ("XMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (700.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (10));
+  remHelper->SetAttribute ("YMin", DoubleValue (-200.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (200.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (5));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("DirectComputation", BooleanValue (directComputation));
+  remHelper->SetAttribute ("NumThreads", UintegerValue (numThreads));
+  remHelper->Install ();
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<std::vector<double> > rem;
+  std::ifstream file (filename);
+  double x, y, z, sinr;
+  while (file >> x >> y >> z >> sinr)
+    {
+      rem.push_back ({x, y, z, sinr});
+    }
+  return rem;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  std::vector<std::vector<double> > simulated =
+    GenerateRem (false, 1, CreateTempDirFilename ("rem-simulated.out"));
+  std::vector<std::vector<double> > direct =
+    GenerateRem (true, m_numThreads, CreateTempDirFilename ("rem-direct.out"));
+
+  NS_TEST_ASSERT_MSG_EQ (simulated.size (), 50, "Wrong number of points in the simulated REM");
+  NS_TEST_ASSERT_MSG_EQ (direct.size (), simulated.size (), "Wrong number of points in the direct REM");
+  for (std::size_t i = 0; i < simulated.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (direct[i][0], simulated[i][0], 1e-6, "Wrong x coordinate of point " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (direct[i][1], simulated[i][1], 1e-6, "Wrong y coordinate of point " << i);
+      // the ASCII output has 6 significant digits
+      NS_TEST_ASSERT_MSG_EQ_TOL (direct[i][3], simulated[i][3], simulated[i][3] * 1e-5,
+                                 "Wrong SINR at (" << simulated[i][0] << ", " << simulated[i][1] << ")");
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the REM helper.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase (1), TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapTestCase (4), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup mpi
+ *
+ * Four HalfDuplexIdealPhy devices share a MultiModelSpectrumRemoteChannel.
+ * Nodes 0 and 1 are placed on logical processor 0, nodes 2 and 3 on
+ * logical processor 1.  Every node transmits one packet and every phy
+ * reports the time and the power at which each signal reaches it.
+ *
+ *                 -------   -------
+ *                  RANK 0    RANK 1
+ *                 ------- | -------
+ *                         |
+ *          n0   n1        |       n2   n3
+ *         x=0  x=5        |     x=100 x=105
+ *
+ * With --sequential, all the nodes are created on the same logical
+ * processor and share a MultiModelSpectrumChannel: the output must be
+ * the same as the one of the distributed run.
+ *
+ * Logical processor 1 creates an additional SpectrumModel before the one
+ * used by the phys, so that the UIDs of the models differ between ranks.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/isotropic-antenna-model.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/multi-model-spectrum-remote-channel.h"
+
+#include <cmath>
+#include <iomanip>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumDistributedIdealPhy");
+
+/**
+ * HalfDuplexIdealPhy printing the time and the power of the signals
+ * it receives.
+ */
+class ReportingIdealPhy : public HalfDuplexIdealPhy
+{
+public:
+  void StartRx (Ptr<SpectrumSignalParameters> params) override
+  {
+    double rxPowerW = Integral (*params->psd);
+    std::cout << "TEST : node " << GetDevice ()->GetNode ()->GetId ()
+              << " starts receiving from node " << params->txPhy->GetDevice ()->GetNode ()->GetId ()
+              << " at " << Simulator::Now ().GetNanoSeconds () << " ns, power "
+              << std::fixed << std::setprecision (6) << 10 * std::log10 (rxPowerW) + 30
+              << " dBm" << std::endl;
+    HalfDuplexIdealPhy::StartRx (params);
+  }
+};
+
+/**
+ * Report the end of a successful reception.
+ *
+ * \param [in] node The receiving node.
+ * \param [in] p The received packet.
+ */
+void
+RxEndOk (uint32_t node, Ptr<const Packet> p)
+{
+  std::cout << "TEST : node " << node << " received a packet of " << p->GetSize ()
+            << " bytes at " << Simulator::Now ().GetNanoSeconds () << " ns" << std::endl;
+}
+
+/**
+ * Send a broadcast packet.
+ *
+ * \param [in] dev The transmitting device.
+ */
+void
+Send (Ptr<NetDevice> dev)
+{
+  dev->Send (Create<Packet> (100), dev->GetBroadcast (), 0x800);
+}
+
+int
+main (int argc, char *argv[])
+{
+  bool nullmsg = false;
+  bool sequential = false;
+  bool testing = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+  cmd.AddValue ("sequential", "Run all the nodes in a single process", sequential);
+  cmd.AddValue ("test", "Enable regression test output", testing);
+  cmd.Parse (argc, argv);
+
+  uint32_t systemId = 0;
+  Ptr<SpectrumChannel> channel;
+  if (sequential)
+    {
+      channel = CreateObject<MultiModelSpectrumChannel> ();
+    }
+  else
+    {
+      // Distributed simulation setup; by default use granted time window algorithm.
+      if (nullmsg)
+        {
+          GlobalValue::Bind ("SimulatorImplementationType",
+                             StringValue ("ns3::NullMessageSimulatorImpl"));
+        }
+      else
+        {
+          GlobalValue::Bind ("SimulatorImplementationType",
+                             StringValue ("ns3::DistributedSimulatorImpl"));
+        }
+
+      MpiInterface::Enable (&argc, &argv);
+
+      systemId = MpiInterface::GetSystemId ();
+      if (MpiInterface::GetSize () != 2)
+        {
+          std::cout << "This simulation requires 2 and only 2 logical processors." << std::endl;
+          MpiInterface::Disable ();
+          return 1;
+        }
+      channel = CreateObject<MultiModelSpectrumRemoteChannel> ();
+    }
+
+  if (systemId == 1)
+    {
+      Create<SpectrumModel> (std::vector<double> {5.9e9, 5.91e9});
+    }
+  std::vector<double> centerFrequencies;
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      centerFrequencies.push_back (2.4e9 + i * 1e6);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (centerFrequencies);
+
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (model);
+  (*txPsd) = 1e-11;  // -7 dBm over 20 MHz
+  Ptr<SpectrumValue> noisePsd = Create<SpectrumValue> (model);
+  (*noisePsd) = 4e-21;
+
+  channel->AddSpectrumPropagationLossModel (CreateObject<FriisSpectrumPropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  const std::vector<double> positions {0, 5, 100, 105};
+  std::vector<Ptr<NetDevice> > devices;
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      uint32_t nodeSystemId = (sequential || i < 2) ? 0 : 1;
+      Ptr<Node> node = CreateObject<Node> (nodeSystemId);
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (positions[i], 0, 0));
+      node->AggregateObject (mobility);
+
+      Ptr<AlohaNoackNetDevice> dev = CreateObject<AlohaNoackNetDevice> ();
+      dev->SetAddress (Mac48Address::Allocate ());
+      dev->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+
+      Ptr<ReportingIdealPhy> phy = CreateObject<ReportingIdealPhy> ();
+      phy->SetMobility (mobility);
+      phy->SetDevice (dev);
+      phy->SetTxPowerSpectralDensity (txPsd);
+      phy->SetNoisePowerSpectralDensity (noisePsd);
+      phy->SetChannel (channel);
+      phy->SetAntenna (CreateObject<IsotropicAntennaModel> ());
+      channel->AddRx (phy);
+      phy->TraceConnectWithoutContext ("RxEndOk", MakeBoundCallback (&RxEndOk, node->GetId ()));
+
+      dev->SetPhy (phy);
+      node->AddDevice (dev);
+      phy->SetGenericPhyTxEndCallback (MakeCallback (&AlohaNoackNetDevice::NotifyTransmissionEnd, dev));
+      phy->SetGenericPhyRxStartCallback (MakeCallback (&AlohaNoackNetDevice::NotifyReceptionStart, dev));
+      phy->SetGenericPhyRxEndOkCallback (MakeCallback (&AlohaNoackNetDevice::NotifyReceptionEndOk, dev));
+      dev->SetGenericPhyTxStartCallback (MakeCallback (&HalfDuplexIdealPhy::StartTx, phy));
+
+      devices.push_back (dev);
+      if (nodeSystemId == systemId)
+        {
+          Simulator::Schedule (MilliSeconds (1 + 10 * i), &Send, dev);
+        }
+    }
+
+  // the null-message algorithm advances by the lookahead, i.e., the
+  // propagation delay between the ranks: keep the simulation short
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  if (!sequential)
+    {
+      MpiInterface::Disable ();
+    }
+  return 0;
+}
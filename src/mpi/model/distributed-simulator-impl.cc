@@ -187,7 +187,7 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
           for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
             {
               Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
-              // only works for p2p links currently
+              // other channels are registered with MpiInterface::AddRemoteChannel ()
               if (!localNetDevice->IsPointToPoint ())
                 {
                   continue;
@@ -227,6 +227,25 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
                 }
             }
         }
+
+      const MpiInterface::RemoteChannelList &remoteChannels = MpiInterface::GetRemoteChannels ();
+      for (MpiInterface::RemoteChannelList::const_iterator iter = remoteChannels.begin ();
+           iter != remoteChannels.end ();
+           ++iter)
+        {
+          for (uint32_t systemId = 0; systemId < MpiInterface::GetSize (); ++systemId)
+            {
+              if (systemId == MpiInterface::GetSystemId ())
+                {
+                  continue;
+                }
+              Time delay = iter->second (systemId);
+              if (delay < m_lookAhead)
+                {
+                  m_lookAhead = delay;
+                }
+            }
+        }
     }
 
   // m_lookAhead is now set
@@ -215,6 +215,7 @@ GrantedTimeWindowMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, ui
   std::list<SentBuffer>::reverse_iterator i = g_pendingTx.rbegin (); // Points to the last element
 
   uint32_t serializedSize = p->GetSerializedSize ();
+  NS_ASSERT_MSG (serializedSize + 16 <= MAX_MPI_MSG_SIZE, "Packet too large for an MPI message");
   uint8_t* buffer =  new uint8_t[serializedSize + 16];
   i->SetBuffer (buffer);
   // Add the time, dest node and dest device
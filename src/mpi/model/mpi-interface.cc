@@ -38,12 +38,14 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("MpiInterface");
 
 ParallelCommunicationInterface* MpiInterface::g_parallelCommunicationInterface = 0;
+MpiInterface::RemoteChannelList MpiInterface::g_remoteChannels;
 
 void
 MpiInterface::Destroy ()
 {
   NS_ASSERT (g_parallelCommunicationInterface);
   g_parallelCommunicationInterface->Destroy ();
+  g_remoteChannels.clear ();
 }
 
 uint32_t
@@ -134,6 +136,19 @@ MpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t node, uint
   g_parallelCommunicationInterface->SendPacket (p, rxTime, node, dev);
 }
 
+void
+MpiInterface::AddRemoteChannel (Ptr<Channel> channel, RemoteDelayCallback delay)
+{
+  NS_LOG_FUNCTION (channel);
+  g_remoteChannels.push_back (std::make_pair (channel, delay));
+}
+
+const MpiInterface::RemoteChannelList &
+MpiInterface::GetRemoteChannels (void)
+{
+  return g_remoteChannels;
+}
+
 MPI_Comm 
 MpiInterface::GetCommunicator()
 {
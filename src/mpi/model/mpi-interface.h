@@ -29,6 +29,11 @@
 
 #include <ns3/nstime.h>
 #include <ns3/packet.h>
+#include <ns3/channel.h>
+#include <ns3/callback.h>
+
+#include <utility>
+#include <vector>
 
 #include "mpi.h"
 
@@ -139,6 +144,34 @@ public:
    */
   static void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
 
+  /**
+   * Callback returning the smallest delay of a channel between a node
+   * of this rank and a node of a remote rank, or Time::Max () if the
+   * channel does not connect the two ranks.
+   */
+  typedef Callback<Time, uint32_t> RemoteDelayCallback;
+  /** Container for the channels registered with AddRemoteChannel (). */
+  typedef std::vector<std::pair<Ptr<Channel>, RemoteDelayCallback> > RemoteChannelList;
+
+  /**
+   * \brief Register a channel, other than a point-to-point link, which
+   * connects nodes of different ranks.
+   *
+   * The parallel simulators bound the lookahead towards each remote
+   * rank with the delay returned by the callback, which is invoked
+   * once, when the simulation starts.
+   *
+   * \param channel The channel, for instance a wireless channel.
+   * \param delay The callback returning the delay towards a remote rank.
+   */
+  static void AddRemoteChannel (Ptr<Channel> channel, RemoteDelayCallback delay);
+  /**
+   * \brief Get the channels registered with AddRemoteChannel ().
+   *
+   * \return The remote channels.
+   */
+  static const RemoteChannelList & GetRemoteChannels (void);
+
   /**
    * \brief Return the communicator used to run ns-3.
    *
@@ -161,6 +194,9 @@ private:
    * Static instance of the instantiated parallel controller.
    */
   static ParallelCommunicationInterface* g_parallelCommunicationInterface;
+
+  /** The channels registered with AddRemoteChannel (). */
+  static RemoteChannelList g_remoteChannels;
 };
 
 } // namespace ns3
@@ -92,9 +92,10 @@ private:
 
 /**
  * maximum MPI message size for easy
- * buffer creation
+ * buffer creation; large enough for the
+ * power spectral density of a wireless signal
  */
-const uint32_t NULL_MESSAGE_MAX_MPI_MSG_SIZE = 2000;
+const uint32_t NULL_MESSAGE_MAX_MPI_MSG_SIZE = 65536;
 
 NullMessageSentBuffer::NullMessageSentBuffer ()
 {
@@ -273,6 +274,7 @@ NullMessageMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, uint32_t
 
   uint32_t serializedSize = p->GetSerializedSize ();
   uint32_t bufferSize = serializedSize + ( 2 * sizeof (uint64_t) ) + ( 2 * sizeof (uint32_t) );
+  NS_ASSERT_MSG (bufferSize <= NULL_MESSAGE_MAX_MPI_MSG_SIZE, "Packet too large for an MPI message");
   uint8_t* buffer =  new uint8_t[bufferSize];
   iter->SetBuffer (buffer);
   // Add the time, dest node and dest device
@@ -41,6 +41,7 @@
 #include <ns3/ptr.h>
 #include <ns3/pointer.h>
 #include <ns3/assert.h>
+#include <ns3/abort.h>
 #include <ns3/log.h>
 
 #include <cmath>
@@ -159,7 +160,7 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
           for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
             {
               Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
-              // only works for p2p links currently
+              // other channels are registered with MpiInterface::AddRemoteChannel ()
               if (!localNetDevice->IsPointToPoint ())
                 {
                   continue;
@@ -201,6 +202,34 @@ NullMessageSimulatorImpl::CalculateLookAhead (void)
               remoteChannelBundle->AddChannel (channel, delay.Get () );
             }
         }
+
+      const MpiInterface::RemoteChannelList &remoteChannels = MpiInterface::GetRemoteChannels ();
+      for (MpiInterface::RemoteChannelList::const_iterator iter = remoteChannels.begin ();
+           iter != remoteChannels.end ();
+           ++iter)
+        {
+          for (uint32_t systemId = 0; systemId < MpiInterface::GetSize (); ++systemId)
+            {
+              if (systemId == MpiInterface::GetSystemId ())
+                {
+                  continue;
+                }
+              Time delay = iter->second (systemId);
+              if (delay == Time::Max ())
+                {
+                  continue;
+                }
+              NS_ABORT_MSG_UNLESS (delay.IsStrictlyPositive (),
+                                   "Channel " << iter->first->GetId () << " has no delay towards rank " << systemId);
+
+              Ptr<RemoteChannelBundle> remoteChannelBundle = RemoteChannelBundleManager::Find (systemId);
+              if (!remoteChannelBundle)
+                {
+                  remoteChannelBundle = RemoteChannelBundleManager::Add (systemId);
+                }
+              remoteChannelBundle->AddChannel (iter->first, delay);
+            }
+        }
     }
 
   // Completed setup of remote channel bundles.  Setup send and receive buffers.
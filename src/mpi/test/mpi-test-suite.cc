@@ -126,9 +126,12 @@ static MpiTestSuite g_mpiEmpty2    ("mpi-example-empty-2",     "simple-distribut
 static MpiTestSuite g_mpiEmpty3    ("mpi-example-empty-3",     "simple-distributed-empty-node", NS_TEST_SOURCEDIR, 3);
 static MpiTestSuite g_mpiSimple2   ("mpi-example-simple-2",    "simple-distributed", NS_TEST_SOURCEDIR, 2);
 static MpiTestSuite g_mpiThird2    ("mpi-example-third-2",     "third-distributed", NS_TEST_SOURCEDIR, 2);
+static MpiTestSuite g_mpiSpectrum1 ("mpi-example-spectrum-1-sequential", "spectrum-distributed-ideal-phy", NS_TEST_SOURCEDIR, 1, "--sequential");
+static MpiTestSuite g_mpiSpectrum2 ("mpi-example-spectrum-2",  "spectrum-distributed-ideal-phy", NS_TEST_SOURCEDIR, 2);
 
 /* Tests using NullMessageSimulatorImpl */
 static MpiTestSuite g_mpiSimple2NullMsg ("mpi-example-simple-2-nullmsg",    "simple-distributed", NS_TEST_SOURCEDIR, 2, "--nullmsg");
 static MpiTestSuite g_mpiEmpty2NullMsg  ("mpi-example-empty-2-nullmsg",     "simple-distributed-empty-node", NS_TEST_SOURCEDIR, 2, "-nullmsg");
 static MpiTestSuite g_mpiEmpty3NullMsg  ("mpi-example-empty-3-nullmsg",     "simple-distributed-empty-node", NS_TEST_SOURCEDIR, 3, "-nullmsg");
+static MpiTestSuite g_mpiSpectrum2NullMsg ("mpi-example-spectrum-2-nullmsg", "spectrum-distributed-ideal-phy", NS_TEST_SOURCEDIR, 2, "--nullmsg");
 
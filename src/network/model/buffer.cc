@@ -20,6 +20,7 @@
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-gauge.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
@@ -49,6 +50,9 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
+/// The memory allocated for the data of all the buffers, including the pooled one
+static MemoryGauge g_bufferDataGauge ("network", "Buffer::Data");
+
 
 uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
@@ -75,21 +79,26 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+/// The memory kept in the free lists for reuse
+static MemoryGauge g_freeListGauge ("network", "Buffer::FreeList");
+thread_local Buffer::FreeList *Buffer::g_freeList = 0;
+thread_local struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
   NS_LOG_FUNCTION (this);
   if (IS_INITIALIZED (g_freeList))
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
+      for (uint32_t sizeClass = 0; sizeClass < SIZE_CLASSES; sizeClass++)
         {
-          Buffer::Deallocate (*i);
+          for (Buffer::FreeList::iterator i = g_freeList[sizeClass].begin ();
+               i != g_freeList[sizeClass].end (); i++)
+            {
+              g_freeListGauge.Remove ((*i)->m_size - 1 + sizeof (struct Buffer::Data));
+              Buffer::Deallocate (*i);
+            }
         }
-      delete g_freeList;
+      delete [] g_freeList;
       g_freeList = DESTROYED;
     }
 }
@@ -100,18 +109,21 @@ Buffer::Recycle (struct Buffer::Data *data)
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
   NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
+  uint32_t sizeClass = GetSizeClass (data->m_size);
+  /* feed into the free list of its size class. Only storage which
+   * was allocated with exactly the size of its class is pooled. */
+  if (sizeClass == SIZE_CLASSES ||
+      data->m_size != (MIN_CLASS_SIZE << sizeClass) ||
       IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+      g_freeList[sizeClass].size () > 1000)
     {
       Buffer::Deallocate (data);
     }
   else
     {
       NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
+      g_freeList[sizeClass].push_back (data);
+      g_freeListGauge.Add (data->m_size - 1 + sizeof (struct Buffer::Data));
     }
 }
 
@@ -119,23 +131,23 @@ Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
-  /* try to find a buffer correctly sized. */
+  /* try to find a buffer of the right size class. */
   if (IS_UNINITIALIZED (g_freeList))
     {
-      g_freeList = new Buffer::FreeList ();
+      g_freeList = new Buffer::FreeList [SIZE_CLASSES];
+      // make sure the destructor of this thread's lists gets registered
+      (void)&g_localStaticDestructor;
     }
   else if (IS_INITIALIZED (g_freeList))
     {
-      while (!g_freeList->empty ()) 
+      uint32_t sizeClass = GetSizeClass (dataSize);
+      if (sizeClass != SIZE_CLASSES && !g_freeList[sizeClass].empty ())
         {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
+          struct Buffer::Data *data = g_freeList[sizeClass].back ();
+          g_freeList[sizeClass].pop_back ();
+          g_freeListGauge.Remove (data->m_size - 1 + sizeof (struct Buffer::Data));
+          data->m_count = 1;
+          return data;
         }
     }
   struct Buffer::Data *data = Buffer::Allocate (dataSize);
@@ -159,17 +171,33 @@ Buffer::Create (uint32_t size)
 }
 #endif /* BUFFER_FREE_LIST */
 
+uint32_t
+Buffer::GetSizeClass (uint32_t size)
+{
+  uint32_t sizeClass = 0;
+  uint32_t classSize = MIN_CLASS_SIZE;
+  while (classSize < size && sizeClass < SIZE_CLASSES)
+    {
+      classSize <<= 1;
+      sizeClass++;
+    }
+  return sizeClass;
+}
+
 struct Buffer::Data *
 Buffer::Allocate (uint32_t reqSize)
 {
   NS_LOG_FUNCTION (reqSize);
-  if (reqSize == 0) 
+  uint32_t sizeClass = GetSizeClass (reqSize);
+  if (sizeClass != SIZE_CLASSES)
     {
-      reqSize = 1;
+      /* round up to the size class so that the storage can be pooled */
+      reqSize = MIN_CLASS_SIZE << sizeClass;
     }
   NS_ASSERT (reqSize >= 1);
   uint32_t size = reqSize - 1 + sizeof (struct Buffer::Data);
   uint8_t *b = new uint8_t [size];
+  g_bufferDataGauge.Add (size);
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
   data->m_size = reqSize;
   data->m_count = 1;
@@ -181,6 +209,7 @@ Buffer::Deallocate (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  g_bufferDataGauge.Remove (data->m_size - 1 + sizeof (struct Buffer::Data));
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
   delete [] buf;
 }
@@ -244,7 +273,7 @@ void
 Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
-  m_data = Buffer::Create (0);
+  m_data = Buffer::Create (g_recommendedStart);
   m_start = std::min (m_data->m_size, g_recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
@@ -262,8 +291,7 @@ Buffer::operator = (Buffer const&o)
   if (m_data != o.m_data) 
     {
       // not assignment to self.
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (--m_data->m_count == 0)
         {
           Recycle (m_data);
         }
@@ -285,8 +313,7 @@ Buffer::~Buffer ()
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (--m_data->m_count == 0)
     {
       Recycle (m_data);
     }
@@ -310,7 +337,12 @@ Buffer::AddAtStart (uint32_t start)
 {
   NS_LOG_FUNCTION (this << start);
   NS_ASSERT (CheckInternalState ());
+#ifdef NS3_ATOMIC_REFCOUNT
+  // another thread may be extending the dirty area of a shared buffer
+  bool isDirty = m_data->m_count > 1;
+#else
   bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
   if (m_start >= start && !isDirty)
     {
       /* enough space in the buffer and not dirty. 
@@ -328,8 +360,7 @@ Buffer::AddAtStart (uint32_t start)
       uint32_t newSize = GetInternalSize () + start;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data + start, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0)
+      if (--m_data->m_count == 0)
         {
           Buffer::Recycle (m_data);
         }
@@ -355,7 +386,11 @@ Buffer::AddAtEnd (uint32_t end)
 {
   NS_LOG_FUNCTION (this << end);
   NS_ASSERT (CheckInternalState ());
+#ifdef NS3_ATOMIC_REFCOUNT
+  bool isDirty = m_data->m_count > 1;
+#else
   bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
   if (GetInternalEnd () + end <= m_data->m_size && !isDirty)
     {
       /* enough space in buffer and not dirty
@@ -373,8 +408,7 @@ Buffer::AddAtEnd (uint32_t end)
       uint32_t newSize = GetInternalSize () + end;
       struct Buffer::Data *newData = Buffer::Create (newSize);
       memcpy (newData->m_data, m_data->m_data + m_start, GetInternalSize ());
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (--m_data->m_count == 0)
         {
           Buffer::Recycle (m_data);
         }
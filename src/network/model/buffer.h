@@ -23,6 +23,9 @@
 #include <stdint.h>
 #include <vector>
 #include <ostream>
+#ifdef NS3_ATOMIC_REFCOUNT
+#include <atomic>
+#endif
 #include "ns3/assert.h"
 
 #define BUFFER_FREE_LIST 1
@@ -38,10 +41,16 @@ namespace ns3 {
  * automatically adjusted to hold any data prepended
  * or appended by the user. Its implementation is optimized
  * to ensure that the number of buffer resizes is minimized,
- * by creating new Buffers of the maximum size ever used.
- * The correct maximum size is learned at runtime during use by 
+ * by reserving in new Buffers the maximum header space ever used.
+ * The correct header space is learned at runtime during use by 
  * recording the maximum size of each packet.
  *
+ * The underlying data storage is rounded up to a power-of-two size
+ * class (64 bytes to 8 KiB) and recycled through per-thread free
+ * lists, one per size class, so that small buffers such as those of
+ * control frames are served from the smallest class without hitting
+ * the heap.
+ *
  * \internal
  * The implementation of the Buffer class uses a COW (Copy On Write)
  * technique to ensure that the underlying data buffer which holds
@@ -663,7 +672,11 @@ private:
      * The reference count of an instance of this data structure.
      * Each buffer which references an instance holds a count.
      */
+#ifdef NS3_ATOMIC_REFCOUNT
+    std::atomic<uint32_t> m_count;
+#else
     uint32_t m_count;
+#endif
     /**
      * the size of the m_data field below.
      */
@@ -790,6 +803,19 @@ private:
    */
   uint32_t m_end;
 
+  /**
+   * \brief Get the size class of a buffer data storage
+   * \param size the requested storage size
+   * \returns the index of the smallest size class which can hold
+   *          size bytes, or SIZE_CLASSES if size is too large to be pooled.
+   */
+  static uint32_t GetSizeClass (uint32_t size);
+
+  /// Storage size of the smallest size class, in bytes.
+  static const uint32_t MIN_CLASS_SIZE = 64;
+  /// Number of size classes: MIN_CLASS_SIZE, 2*MIN_CLASS_SIZE, ... 8192 bytes.
+  static const uint32_t SIZE_CLASSES = 8;
+
 #ifdef BUFFER_FREE_LIST
   /// Container for buffer data
   typedef std::vector<struct Buffer::Data*> FreeList;
@@ -798,9 +824,8 @@ private:
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+  static thread_local FreeList *g_freeList; //!< Per-thread buffer data containers, one per size class
+  static thread_local struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
@@ -25,6 +25,7 @@
 #include "application.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/object-vector.h"
 #include "ns3/uinteger.h"
 #include "ns3/log.h"
@@ -144,6 +145,7 @@ Ptr<NetDevice>
 Node::GetDevice (uint32_t index) const
 {
   NS_LOG_FUNCTION (this << index);
+  DefaultSimulatorImpl::NotifyAccess (m_id);
   NS_ASSERT_MSG (index < m_devices.size (), "Device index " << index <<
                  " is out of range (only have " << m_devices.size () << " devices).");
   return m_devices[index];
@@ -170,6 +172,7 @@ Ptr<Application>
 Node::GetApplication (uint32_t index) const
 {
   NS_LOG_FUNCTION (this << index);
+  DefaultSimulatorImpl::NotifyAccess (m_id);
   NS_ASSERT_MSG (index < m_applications.size (), "Application index " << index <<
                  " is out of range (only have " << m_applications.size () << " applications).");
   return m_applications[index];
@@ -304,6 +307,7 @@ Node::ReceiveFromDevice (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16
                          const Address &from, const Address &to, NetDevice::PacketType packetType, bool promiscuous)
 {
   NS_LOG_FUNCTION (this << device << packet << protocol << &from << &to << packetType << promiscuous);
+  DefaultSimulatorImpl::NotifyAccess (m_id);
   NS_ASSERT_MSG (Simulator::GetContext () == GetId (), "Received packet with erroneous context ; " <<
                  "make sure the channels in use are correctly updating events context " <<
                  "when transferring events from one node to another.");
@@ -29,11 +29,55 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include <cstring>
+#include <vector>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+namespace {
+
+/**
+ * \ingroup packet
+ * Size of the data area of the TagData structs which are recycled.
+ * It fits the serialized size of the packet tags used by the models.
+ */
+const size_t SMALL_TAG_DATA_SIZE = 24;
+
+/**
+ * \ingroup packet
+ * Maximum number of TagData structs kept for reuse.
+ */
+const size_t TAG_DATA_FREE_LIST_MAX = 1000;
+
+/**
+ * \ingroup packet
+ * List of the TagData structs released, freed at exit.
+ */
+class TagDataFreeList : public std::vector<PacketTagList::TagData *>
+{
+public:
+  TagDataFreeList ()
+    : m_alive (true)
+  {
+  }
+  ~TagDataFreeList ()
+  {
+    for (iterator i = begin (); i != end (); i++)
+      {
+        std::free (*i);
+      }
+    // packets destroyed after this list free their tags directly
+    m_alive = false;
+  }
+  bool m_alive; //!< Whether the list can still be used
+};
+
+/// TagData structs released, of size SMALL_TAG_DATA_SIZE, one list per thread
+thread_local TagDataFreeList g_tagDataFreeList;
+
+} // unnamed namespace
+
 PacketTagList::TagData *
 PacketTagList::CreateTagData (size_t dataSize)
 {
@@ -43,14 +87,46 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  void * p;
+  if (dataSize <= SMALL_TAG_DATA_SIZE)
+    {
+      if (!g_tagDataFreeList.empty ())
+        {
+          p = g_tagDataFreeList.back ();
+          g_tagDataFreeList.pop_back ();
+        }
+      else
+        {
+          p = std::malloc (sizeof (TagData) + SMALL_TAG_DATA_SIZE - 1);
+        }
+    }
+  else
+    {
+      p = std::malloc (sizeof (TagData) + dataSize - 1);
+    }
+  // The matching frees are in FreeTagData
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
   return tag;
 }
 
+void
+PacketTagList::FreeTagData (TagData * tag)
+{
+  bool small = tag->size <= SMALL_TAG_DATA_SIZE;
+  tag->~TagData ();
+  if (small && g_tagDataFreeList.m_alive
+      && g_tagDataFreeList.size () < TAG_DATA_FREE_LIST_MAX)
+    {
+      g_tagDataFreeList.push_back (tag);
+    }
+  else
+    {
+      std::free (tag);
+    }
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -194,8 +270,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
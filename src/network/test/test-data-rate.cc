@@ -129,6 +129,13 @@ DataRateTestCase1::SingleTest (std::string rate, size_t nBits, Time correctTime)
 void
 DataRateTestCase1::DoRun ()
 {
+#ifdef NS3_TIME_RESOLUTION
+  if (Time::FIXED_RESOLUTION != Time::FS)
+    {
+      // these durations need a femtosecond resolution
+      return;
+    }
+#endif
   if (Time::GetResolution () != Time::FS)
     {
       Time::SetResolution (Time::FS);
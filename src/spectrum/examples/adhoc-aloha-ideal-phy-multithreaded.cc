@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Clusters of ALOHA nodes sharing a single spectrum channel, run with
+// the MultithreadedSimulatorImpl: each cluster is a partition, and the
+// lookahead is the propagation delay between the closest clusters.
+//
+// The clusters are placed along the x axis, 'distance' meters apart;
+// in each cluster, every node sends packets to the next one.  Every
+// signal reaches all the nodes, so the channel spans all the partitions.
+//
+// Since the partitions share the channel and the packets, ns-3 must be
+// configured with --enable-atomic-refcount to use more than one thread.
+// Compare, for instance:
+//
+//   ./waf --run "adhoc-aloha-ideal-phy-multithreaded --threads=0"
+//   ./waf --run "adhoc-aloha-ideal-phy-multithreaded --threads=8"
+//
+// where --threads=0 runs the DefaultSimulatorImpl.  The number of
+// packets received must be the same in all the runs.
+
+#include <iostream>
+#include <vector>
+
+#include <ns3/core-module.h>
+#include <ns3/network-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/applications-module.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-helper.h>
+#include <ns3/wifi-spectrum-value-helper.h>
+#include <ns3/adhoc-aloha-noack-ideal-phy-helper.h>
+#include <ns3/multithreaded-simulator-impl.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("AdhocAlohaMultithreaded");
+
+/// The bytes received by each node; each entry is only written by the partition of its node
+static std::vector<uint64_t> g_rxBytes;
+
+void
+ReceivePacket (Ptr<Socket> socket)
+{
+  Ptr<Packet> packet;
+  while ((packet = socket->Recv ()))
+    {
+      g_rxBytes[socket->GetNode ()->GetId ()] += packet->GetSize ();
+    }
+}
+
+int main (int argc, char** argv)
+{
+  uint32_t clusters = 8;
+  uint32_t nodesPerCluster = 10;
+  double distance = 300;
+  double simTime = 2;
+  uint32_t threads = 1;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("clusters", "Number of clusters, and of partitions", clusters);
+  cmd.AddValue ("nodesPerCluster", "Number of nodes in each cluster", nodesPerCluster);
+  cmd.AddValue ("distance", "Distance between the clusters [m]", distance);
+  cmd.AddValue ("simTime", "Simulation time [s]", simTime);
+  cmd.AddValue ("threads", "Number of threads (0 runs the DefaultSimulatorImpl)", threads);
+  cmd.Parse (argc, argv);
+
+  if (threads > 0)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType",
+                         StringValue ("ns3::MultithreadedSimulatorImpl"));
+    }
+
+  NodeContainer nodes;
+  nodes.Create (clusters * nodesPerCluster);
+  g_rxBytes.assign (nodes.GetN (), 0);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      uint32_t cluster = i / nodesPerCluster;
+      uint32_t index = i % nodesPerCluster;
+      positionAlloc->Add (Vector (cluster * distance, index, 0.0));
+      MultithreadedSimulatorImpl::SetPartition (nodes.Get (i)->GetId (), cluster);
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  SpectrumChannelHelper channelHelper = SpectrumChannelHelper::Default ();
+  Ptr<SpectrumChannel> channel = channelHelper.Create ();
+
+  WifiSpectrumValue5MhzFactory sf;
+  Ptr<SpectrumValue> txPsd = sf.CreateTxPowerSpectralDensity (0.1, 1);
+  // thermal noise at room temperature
+  Ptr<SpectrumValue> noisePsd = sf.CreateConstant (1.381e-23 * 290);
+
+  AdhocAlohaNoackIdealPhyHelper deviceHelper;
+  deviceHelper.SetChannel (channel);
+  deviceHelper.SetTxPowerSpectralDensity (txPsd);
+  deviceHelper.SetNoisePowerSpectralDensity (noisePsd);
+  deviceHelper.SetPhyAttribute ("Rate", DataRateValue (DataRate ("1Mbps")));
+  NetDeviceContainer devices = deviceHelper.Install (nodes);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (nodes);
+
+  TypeId tid = TypeId::LookupByName ("ns3::PacketSocketFactory");
+  std::vector<Ptr<Socket> > sinks;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      uint32_t peer = (i / nodesPerCluster) * nodesPerCluster + (i + 1) % nodesPerCluster;
+      PacketSocketAddress socket;
+      socket.SetSingleDevice (devices.Get (i)->GetIfIndex ());
+      socket.SetPhysicalAddress (devices.Get (peer)->GetAddress ());
+      socket.SetProtocol (1);
+
+      OnOffHelper onoff ("ns3::PacketSocketFactory", Address (socket));
+      onoff.SetConstantRate (DataRate ("20kbps"));
+      onoff.SetAttribute ("PacketSize", UintegerValue (125));
+      ApplicationContainer apps = onoff.Install (nodes.Get (i));
+      apps.Start (Seconds (0.1 + 0.0037 * i));
+      apps.Stop (Seconds (simTime));
+
+      Ptr<Socket> sink = Socket::CreateSocket (nodes.Get (i), tid);
+      sink->Bind ();
+      sink->SetRecvCallback (MakeCallback (&ReceivePacket));
+      sinks.push_back (sink);
+    }
+
+  if (threads > 0)
+    {
+      Time lookahead = channel->GetMinimumPropagationDelay ();
+      std::cout << "lookahead " << lookahead.As (Time::NS) << std::endl;
+      Ptr<SimulatorImpl> impl = Simulator::GetImplementation ();
+      impl->SetAttribute ("Lookahead", TimeValue (lookahead));
+      impl->SetAttribute ("NumThreads", UintegerValue (threads));
+    }
+
+  Simulator::Stop (Seconds (simTime));
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+
+  uint64_t rxBytes = 0;
+  for (uint32_t i = 0; i < g_rxBytes.size (); i++)
+    {
+      rxBytes += g_rxBytes[i];
+    }
+  std::cout << "received " << rxBytes << " bytes, "
+            << Simulator::GetImplementation ()->GetEventCount () << " events in "
+            << elapsed << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -220,8 +220,22 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
   NS_ASSERT (txParams->txPhy);
   NS_ASSERT (txParams->psd);
-  Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
-  m_txSigParamsTrace (txParamsTrace);
+  // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
+  NS_TRACED_CALLBACK_FIRE (m_txSigParamsTrace, txParams->Copy ());
+
+  DeliverSignal (txParams, Seconds (0));
+}
+
+bool
+MultiModelSpectrumChannel::IsLocal (Ptr<SpectrumPhy> phy) const
+{
+  return true;
+}
+
+void
+MultiModelSpectrumChannel::DeliverSignal (Ptr<SpectrumSignalParameters> txParams, Time elapsed)
+{
+  NS_LOG_FUNCTION (this << txParams << elapsed);
 
   Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
@@ -267,7 +281,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
-          if ((*rxPhyIterator) != txParams->txPhy)
+          if ((*rxPhyIterator) != txParams->txPhy && IsLocal (*rxPhyIterator))
             {
               NS_LOG_LOGIC ("copying signal parameters " << txParams);
               Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
@@ -305,9 +319,9 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                     }                    
                   NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
                   // Gain trace
-                  m_gainTrace (txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+                  NS_TRACED_CALLBACK_FIRE (m_gainTrace, txMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
                   // Pathloss trace
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
+                  NS_TRACED_CALLBACK_FIRE (m_pathLossTrace, txParams->txPhy, *rxPhyIterator, pathLossDb);
                   if (pathLossDb > m_maxLossDb)
                     {
                       // beyond range
@@ -326,14 +340,24 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
                     }
                 }
+              NS_ASSERT_MSG (delay >= elapsed, "the signal reached the channel after the receiver");
+              delay -= elapsed;
 
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
                 {
                   // the receiver has a NetDevice, so we expect that it is attached to a Node
                   uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
+                  if (m_independentRx)
+                    {
+                      Simulator::ScheduleIndependent (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                                      rxParams, *rxPhyIterator);
+                    }
+                  else
+                    {
+                      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                                      rxParams, *rxPhyIterator);
+                    }
                 }
               else
                 {
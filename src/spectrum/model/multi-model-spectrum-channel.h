@@ -128,6 +128,26 @@ public:
 protected:
   void DoDispose ();
 
+  /**
+   * Deliver a signal to the receivers attached to the channel, after
+   * the propagation delay.
+   *
+   * \param txParams The signal parameters.
+   * \param elapsed The part of the propagation delay which has already
+   * elapsed, for a signal transmitted by another simulation process.
+   */
+  void DeliverSignal (Ptr<SpectrumSignalParameters> txParams, Time elapsed);
+
+  /**
+   * Check whether the signals must be delivered to a receiver.  All the
+   * receivers are local, unless the channel spans several simulation
+   * processes.
+   *
+   * \param phy A receiver attached to the channel.
+   * \return true if this process delivers the signals to the receiver.
+   */
+  virtual bool IsLocal (Ptr<SpectrumPhy> phy) const;
+
 private:
   /**
    * This method checks if m_rxSpectrumModelInfoMap contains an entry
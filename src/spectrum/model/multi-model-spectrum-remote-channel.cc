@@ -0,0 +1,479 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/simulator.h>
+#include <ns3/node.h>
+#include <ns3/net-device.h>
+#include <ns3/header.h>
+#include <ns3/mobility-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/antenna-model.h>
+#include <ns3/mpi-interface.h>
+#include <ns3/mpi-receiver.h>
+#include "half-duplex-ideal-phy-signal-parameters.h"
+#include "multi-model-spectrum-remote-channel.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultiModelSpectrumRemoteChannel");
+
+NS_OBJECT_ENSURE_REGISTERED (MultiModelSpectrumRemoteChannel);
+
+/**
+ * \ingroup spectrum
+ *
+ * The header of a signal forwarded to another rank by a
+ * MultiModelSpectrumRemoteChannel: the fields of the base
+ * SpectrumSignalParameters.  The technology-specific part of the
+ * parameters follows the header.
+ */
+class SpectrumRemoteSignalHeader : public Header
+{
+public:
+  /** The kind of signal parameters. */
+  enum Kind
+  {
+    BASE = 0,         //!< SpectrumSignalParameters
+    HALF_DUPLEX = 1,  //!< HalfDuplexIdealPhySignalParameters
+    SERIALIZER = 2    //!< Parameters with a serializer set by the user
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  virtual TypeId GetInstanceTypeId (void) const;
+  virtual void Print (std::ostream &os) const;
+  virtual uint32_t GetSerializedSize (void) const;
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
+  /**
+   * Write a double, bit by bit.
+   *
+   * \param i The buffer iterator.
+   * \param value The value.
+   */
+  static void WriteDouble (Buffer::Iterator &i, double value);
+  /**
+   * Read a double written by WriteDouble ().
+   *
+   * \param i The buffer iterator.
+   * \return The value.
+   */
+  static double ReadDouble (Buffer::Iterator &i);
+
+  uint8_t m_kind;               //!< The kind of signal parameters.
+  uint32_t m_txNode;            //!< The node of the transmitter.
+  uint32_t m_txDevice;          //!< The device index of the transmitter.
+  int64_t m_txTime;             //!< The start of the transmission.
+  int64_t m_duration;           //!< The duration of the signal.
+  std::vector<double> m_bands;  //!< The limits (fl, fc, fh) of the bands of the spectrum model.
+  std::vector<double> m_psd;    //!< The power spectral density.
+};
+
+NS_OBJECT_ENSURE_REGISTERED (SpectrumRemoteSignalHeader);
+
+TypeId
+SpectrumRemoteSignalHeader::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SpectrumRemoteSignalHeader")
+    .SetParent<Header> ()
+    .SetGroupName ("Spectrum")
+    .AddConstructor<SpectrumRemoteSignalHeader> ()
+  ;
+  return tid;
+}
+
+TypeId
+SpectrumRemoteSignalHeader::GetInstanceTypeId (void) const
+{
+  return GetTypeId ();
+}
+
+void
+SpectrumRemoteSignalHeader::Print (std::ostream &os) const
+{
+  os << "kind=" << (uint32_t) m_kind << " tx=" << m_txNode << "/" << m_txDevice
+     << " txTime=" << m_txTime << " duration=" << m_duration
+     << " bands=" << m_psd.size ();
+}
+
+uint32_t
+SpectrumRemoteSignalHeader::GetSerializedSize (void) const
+{
+  return 1 + 4 + 4 + 8 + 8 + 4 + 8 * (m_bands.size () + m_psd.size ());
+}
+
+void
+SpectrumRemoteSignalHeader::Serialize (Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+  i.WriteU8 (m_kind);
+  i.WriteU32 (m_txNode);
+  i.WriteU32 (m_txDevice);
+  i.WriteU64 (m_txTime);
+  i.WriteU64 (m_duration);
+  NS_ASSERT (m_bands.size () == 3 * m_psd.size ());
+  i.WriteU32 (m_psd.size ());
+  for (std::size_t band = 0; band < m_psd.size (); band++)
+    {
+      WriteDouble (i, m_bands[3 * band]);
+      WriteDouble (i, m_bands[3 * band + 1]);
+      WriteDouble (i, m_bands[3 * band + 2]);
+      WriteDouble (i, m_psd[band]);
+    }
+}
+
+uint32_t
+SpectrumRemoteSignalHeader::Deserialize (Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+  m_kind = i.ReadU8 ();
+  m_txNode = i.ReadU32 ();
+  m_txDevice = i.ReadU32 ();
+  m_txTime = i.ReadU64 ();
+  m_duration = i.ReadU64 ();
+  m_psd.resize (i.ReadU32 ());
+  m_bands.resize (3 * m_psd.size ());
+  for (std::size_t band = 0; band < m_psd.size (); band++)
+    {
+      m_bands[3 * band] = ReadDouble (i);
+      m_bands[3 * band + 1] = ReadDouble (i);
+      m_bands[3 * band + 2] = ReadDouble (i);
+      m_psd[band] = ReadDouble (i);
+    }
+  return GetSerializedSize ();
+}
+
+void
+SpectrumRemoteSignalHeader::WriteDouble (Buffer::Iterator &i, double value)
+{
+  // the ranks share the same representation of a double
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  i.WriteU64 (bits);
+}
+
+double
+SpectrumRemoteSignalHeader::ReadDouble (Buffer::Iterator &i)
+{
+  uint64_t bits = i.ReadU64 ();
+  double value;
+  std::memcpy (&value, &bits, sizeof (value));
+  return value;
+}
+
+/**
+ * \ingroup spectrum
+ *
+ * \param model A spectrum model.
+ * \return The limits (fl, fc, fh) of the bands of the spectrum model.
+ */
+static std::vector<double>
+GetBandLimits (Ptr<const SpectrumModel> model)
+{
+  std::vector<double> limits;
+  limits.reserve (3 * model->GetNumBands ());
+  for (Bands::const_iterator it = model->Begin (); it != model->End (); ++it)
+    {
+      limits.push_back (it->fl);
+      limits.push_back (it->fc);
+      limits.push_back (it->fh);
+    }
+  return limits;
+}
+
+
+TypeId
+MultiModelSpectrumRemoteChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultiModelSpectrumRemoteChannel")
+    .SetParent<MultiModelSpectrumChannel> ()
+    .SetGroupName ("Spectrum")
+    .AddConstructor<MultiModelSpectrumRemoteChannel> ()
+  ;
+  return tid;
+}
+
+MultiModelSpectrumRemoteChannel::MultiModelSpectrumRemoteChannel ()
+  : m_setup (false)
+{
+  NS_LOG_FUNCTION (this);
+  MpiInterface::AddRemoteChannel (this, MakeCallback (&MultiModelSpectrumRemoteChannel::GetRemoteDelay, this));
+}
+
+MultiModelSpectrumRemoteChannel::~MultiModelSpectrumRemoteChannel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultiModelSpectrumRemoteChannel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_phys.clear ();
+  m_devicePhys.clear ();
+  m_models.clear ();
+  m_gateways.clear ();
+  m_remoteDelays.clear ();
+  m_serialize = MakeNullCallback<Ptr<Packet>, Ptr<const SpectrumSignalParameters> > ();
+  m_deserialize = MakeNullCallback<Ptr<SpectrumSignalParameters>, Ptr<Packet> > ();
+  MultiModelSpectrumChannel::DoDispose ();
+}
+
+void
+MultiModelSpectrumRemoteChannel::SetSignalSerializer (SerializeSignalCallback serialize,
+                                                      DeserializeSignalCallback deserialize)
+{
+  NS_LOG_FUNCTION (this);
+  m_serialize = serialize;
+  m_deserialize = deserialize;
+}
+
+void
+MultiModelSpectrumRemoteChannel::AddRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+  MultiModelSpectrumChannel::AddRx (phy);
+  if (std::find (m_phys.begin (), m_phys.end (), phy) == m_phys.end ())
+    {
+      NS_ASSERT_MSG (!m_setup, "Receivers must be added before the simulation starts");
+      m_phys.push_back (phy);
+    }
+  else if (m_setup)
+    {
+      // the receiver switched to another spectrum model
+      m_models.insert (std::make_pair (GetBandLimits (phy->GetRxSpectrumModel ()), phy->GetRxSpectrumModel ()));
+    }
+}
+
+bool
+MultiModelSpectrumRemoteChannel::IsLocal (Ptr<SpectrumPhy> phy) const
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  return device == 0 || device->GetNode ()->GetSystemId () == MpiInterface::GetSystemId ();
+}
+
+void
+MultiModelSpectrumRemoteChannel::Setup (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_setup = true;
+
+  for (std::vector<Ptr<SpectrumPhy> >::const_iterator it = m_phys.begin (); it != m_phys.end (); ++it)
+    {
+      m_models.insert (std::make_pair (GetBandLimits ((*it)->GetRxSpectrumModel ()), (*it)->GetRxSpectrumModel ()));
+      Ptr<NetDevice> device = (*it)->GetDevice ();
+      if (device != 0)
+        {
+          m_devicePhys[std::make_pair (device->GetNode ()->GetId (), device->GetIfIndex ())] = *it;
+        }
+    }
+
+  // The first device of each rank, in the same order on all the ranks,
+  // receives the signals sent to that rank.
+  uint32_t systemId = MpiInterface::GetSystemId ();
+  for (std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> >::const_iterator it = m_devicePhys.begin ();
+       it != m_devicePhys.end ();
+       ++it)
+    {
+      Ptr<NetDevice> device = it->second->GetDevice ();
+      uint32_t rank = device->GetNode ()->GetSystemId ();
+      if (m_gateways.find (rank) != m_gateways.end ())
+        {
+          continue;
+        }
+      m_gateways[rank] = device;
+      if (rank == systemId)
+        {
+          NS_ABORT_MSG_IF (device->GetObject<MpiReceiver> () != 0,
+                           "Device " << device->GetIfIndex () << " of node " << device->GetNode ()->GetId ()
+                           << " already receives MPI messages");
+          Ptr<MpiReceiver> receiver = CreateObject<MpiReceiver> ();
+          receiver->SetReceiveCallback (MakeCallback (&MultiModelSpectrumRemoteChannel::ReceiveRemote, this));
+          device->AggregateObject (receiver);
+        }
+    }
+
+  for (std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> >::const_iterator local = m_devicePhys.begin ();
+       local != m_devicePhys.end ();
+       ++local)
+    {
+      if (local->second->GetDevice ()->GetNode ()->GetSystemId () != systemId)
+        {
+          continue;
+        }
+      for (std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> >::const_iterator remote = m_devicePhys.begin ();
+           remote != m_devicePhys.end ();
+           ++remote)
+        {
+          uint32_t rank = remote->second->GetDevice ()->GetNode ()->GetSystemId ();
+          if (rank == systemId)
+            {
+              continue;
+            }
+          Ptr<MobilityModel> localMobility = local->second->GetMobility ();
+          Ptr<MobilityModel> remoteMobility = remote->second->GetMobility ();
+          NS_ABORT_MSG_IF (m_propagationDelay == 0 || localMobility == 0 || remoteMobility == 0,
+                           "A remote spectrum channel needs a propagation delay model and the mobility of the receivers");
+          Time delay = m_propagationDelay->GetDelay (localMobility, remoteMobility);
+          std::map<uint32_t, Time>::iterator it = m_remoteDelays.find (rank);
+          if (it == m_remoteDelays.end ())
+            {
+              m_remoteDelays[rank] = delay;
+            }
+          else
+            {
+              it->second = Min (it->second, delay);
+            }
+        }
+    }
+}
+
+Time
+MultiModelSpectrumRemoteChannel::GetRemoteDelay (uint32_t systemId)
+{
+  NS_LOG_FUNCTION (this << systemId);
+  if (!m_setup)
+    {
+      Setup ();
+    }
+  std::map<uint32_t, Time>::const_iterator it = m_remoteDelays.find (systemId);
+  if (it == m_remoteDelays.end ())
+    {
+      return Time::Max ();
+    }
+  NS_LOG_LOGIC ("delay towards rank " << systemId << " " << it->second);
+  return it->second;
+}
+
+void
+MultiModelSpectrumRemoteChannel::StartTx (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  if (!m_setup)
+    {
+      Setup ();
+    }
+
+  // the local receivers
+  MultiModelSpectrumChannel::StartTx (params);
+
+  if (m_remoteDelays.empty ())
+    {
+      return;
+    }
+
+  SpectrumRemoteSignalHeader header;
+  Ptr<Packet> packet;
+  Ptr<HalfDuplexIdealPhySignalParameters> halfDuplexParams;
+  if (!m_serialize.IsNull () && (packet = m_serialize (params)) != 0)
+    {
+      header.m_kind = SpectrumRemoteSignalHeader::SERIALIZER;
+    }
+  else if ((halfDuplexParams = DynamicCast<HalfDuplexIdealPhySignalParameters> (params)) != 0)
+    {
+      header.m_kind = SpectrumRemoteSignalHeader::HALF_DUPLEX;
+      packet = halfDuplexParams->data->Copy ();
+    }
+  else
+    {
+      header.m_kind = SpectrumRemoteSignalHeader::BASE;
+      packet = Create<Packet> ();
+    }
+
+  Ptr<NetDevice> device = params->txPhy->GetDevice ();
+  NS_ASSERT_MSG (device != 0, "A remote spectrum channel needs transmitters attached to a device");
+  header.m_txNode = device->GetNode ()->GetId ();
+  header.m_txDevice = device->GetIfIndex ();
+  header.m_txTime = Simulator::Now ().GetTimeStep ();
+  header.m_duration = params->duration.GetTimeStep ();
+  header.m_bands = GetBandLimits (params->psd->GetSpectrumModel ());
+  header.m_psd.assign (params->psd->ConstValuesBegin (), params->psd->ConstValuesEnd ());
+  packet->AddHeader (header);
+
+  for (std::map<uint32_t, Time>::const_iterator it = m_remoteDelays.begin (); it != m_remoteDelays.end (); ++it)
+    {
+      Ptr<NetDevice> gateway = m_gateways[it->first];
+      NS_LOG_LOGIC ("forwarding to rank " << it->first << " after " << it->second);
+      MpiInterface::SendPacket (packet, Simulator::Now () + it->second,
+                                gateway->GetNode ()->GetId (), gateway->GetIfIndex ());
+    }
+}
+
+void
+MultiModelSpectrumRemoteChannel::ReceiveRemote (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+  SpectrumRemoteSignalHeader header;
+  packet->RemoveHeader (header);
+
+  Ptr<SpectrumSignalParameters> params;
+  switch (header.m_kind)
+    {
+    case SpectrumRemoteSignalHeader::SERIALIZER:
+      NS_ABORT_MSG_IF (m_deserialize.IsNull (), "No signal serializer on this rank");
+      params = m_deserialize (packet);
+      break;
+    case SpectrumRemoteSignalHeader::HALF_DUPLEX:
+      {
+        Ptr<HalfDuplexIdealPhySignalParameters> halfDuplexParams = Create<HalfDuplexIdealPhySignalParameters> ();
+        halfDuplexParams->data = packet;
+        params = halfDuplexParams;
+      }
+      break;
+    default:
+      params = Create<SpectrumSignalParameters> ();
+      break;
+    }
+
+  std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> >::const_iterator phy =
+    m_devicePhys.find (std::make_pair (header.m_txNode, header.m_txDevice));
+  NS_ASSERT_MSG (phy != m_devicePhys.end (), "Unknown transmitter " << header.m_txDevice << " of node " << header.m_txNode);
+  params->txPhy = phy->second;
+  params->txAntenna = phy->second->GetRxAntenna ();
+  params->duration = TimeStep (header.m_duration);
+
+  // The UIDs of the spectrum models depend on the order in which each rank
+  // creates them, hence the models are matched by their bands
+  std::map<std::vector<double>, Ptr<const SpectrumModel> >::iterator model = m_models.find (header.m_bands);
+  if (model == m_models.end ())
+    {
+      Bands bands (header.m_psd.size ());
+      for (std::size_t band = 0; band < bands.size (); band++)
+        {
+          bands[band].fl = header.m_bands[3 * band];
+          bands[band].fc = header.m_bands[3 * band + 1];
+          bands[band].fh = header.m_bands[3 * band + 2];
+        }
+      NS_LOG_LOGIC ("new spectrum model with " << bands.size () << " bands");
+      model = m_models.insert (std::make_pair (header.m_bands, Create<SpectrumModel> (bands))).first;
+    }
+  params->psd = Create<SpectrumValue> (model->second);
+  NS_ASSERT (params->psd->GetValuesN () == header.m_psd.size ());
+  std::copy (header.m_psd.begin (), header.m_psd.end (), params->psd->ValuesBegin ());
+
+  DeliverSignal (params, Simulator::Now () - TimeStep (header.m_txTime));
+}
+
+} // namespace ns3
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This object is a spectrum channel whose devices are spread over
+// several simulator objects.  It delivers the signals to the local
+// receivers, and forwards them with an MPI Send operation to the
+// simulators of the other receivers.
+
+#ifndef MULTI_MODEL_SPECTRUM_REMOTE_CHANNEL_H
+#define MULTI_MODEL_SPECTRUM_REMOTE_CHANNEL_H
+
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/callback.h>
+#include <ns3/packet.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief A MultiModelSpectrumChannel spanning several MPI ranks
+ *
+ * Every rank builds the whole topology, as usual with the distributed
+ * simulators, and attaches all the devices to its own instance of the
+ * channel.  A signal transmitted by a local device is delivered to the
+ * local receivers only, and sent once to every other rank which has
+ * receivers on the channel.  The remote rank delivers it to its own
+ * receivers, with the same propagation loss and delay as a sequential
+ * simulation would apply.
+ *
+ * The signal reaches a remote rank after the smallest propagation
+ * delay between a device of the sending rank and a device of the
+ * remote rank.  The channel registers this delay with
+ * MpiInterface::AddRemoteChannel () as the lookahead between the two
+ * ranks, so the ranks should group nodes which are close to each
+ * other.  The channel thus requires a propagation delay model, whose
+ * delay only depends on the positions of the nodes, and nodes whose
+ * positions do not get closer to the other ranks during the
+ * simulation.
+ *
+ * A forwarded power spectral density carries the bands of its spectrum
+ * model, since the UID of a model depends on the order in which each
+ * rank creates its models.  The receiving rank uses the model of a
+ * local receiver having the same bands, or creates a new model.
+ *
+ * The base SpectrumSignalParameters and the
+ * HalfDuplexIdealPhySignalParameters are forwarded as they are; the
+ * transmit antenna of a forwarded signal is the antenna of the
+ * transmitting SpectrumPhy.  The parameters of other technologies
+ * need a serializer, set with SetSignalSerializer (); without one,
+ * their signals reach the other ranks as base SpectrumSignalParameters,
+ * i.e., as interference that cannot be received.
+ */
+class MultiModelSpectrumRemoteChannel : public MultiModelSpectrumChannel
+{
+public:
+  /**
+   * \brief Get the TypeId
+   *
+   * \return The TypeId for this class
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Constructor
+   */
+  MultiModelSpectrumRemoteChannel ();
+
+  /**
+   * \brief Destructor
+   */
+  ~MultiModelSpectrumRemoteChannel ();
+
+  /**
+   * Callback serializing the technology-specific part of the signal
+   * parameters into a packet.  It returns 0 if it does not support the
+   * parameters.
+   */
+  typedef Callback<Ptr<Packet>, Ptr<const SpectrumSignalParameters> > SerializeSignalCallback;
+  /**
+   * Callback creating the signal parameters from a packet produced by
+   * the SerializeSignalCallback.  The channel then fills in the fields
+   * of the base SpectrumSignalParameters.
+   */
+  typedef Callback<Ptr<SpectrumSignalParameters>, Ptr<Packet> > DeserializeSignalCallback;
+
+  /**
+   * Set the serializer of the signal parameters of a technology, such
+   * as the parameters of a data frame.
+   *
+   * \param serialize The callback serializing the parameters.
+   * \param deserialize The callback creating the parameters on the remote rank.
+   */
+  void SetSignalSerializer (SerializeSignalCallback serialize,
+                            DeserializeSignalCallback deserialize);
+
+  /**
+   * Get the smallest propagation delay between a device of this rank
+   * and a device of another rank.
+   *
+   * \param systemId The remote rank.
+   * \return The delay, or Time::Max () if no device of the channel
+   * belongs to the remote rank.
+   */
+  Time GetRemoteDelay (uint32_t systemId);
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+protected:
+  void DoDispose ();
+  virtual bool IsLocal (Ptr<SpectrumPhy> phy) const;
+
+private:
+  /**
+   * Find the devices of every rank, compute the delays between the
+   * ranks, and set up the reception of the remote signals.  Invoked
+   * when the simulation starts.
+   */
+  void Setup (void);
+
+  /**
+   * Deliver a signal forwarded by another rank to the local receivers.
+   *
+   * \param packet The forwarded signal.
+   */
+  void ReceiveRemote (Ptr<Packet> packet);
+
+  std::vector<Ptr<SpectrumPhy> > m_phys;                     //!< The phys attached to the channel.
+  std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> > m_devicePhys; //!< The phys by node and device index.
+  std::map<std::vector<double>, Ptr<const SpectrumModel> > m_models; //!< The spectrum models, by band limits.
+  std::map<uint32_t, Ptr<NetDevice> > m_gateways;             //!< The device receiving the signals of each rank.
+  std::map<uint32_t, Time> m_remoteDelays;                    //!< The delay towards each remote rank.
+  bool m_setup;                                               //!< Whether Setup () was invoked.
+  SerializeSignalCallback m_serialize;                        //!< The serializer of the signal parameters.
+  DeserializeSignalCallback m_deserialize;                    //!< The deserializer of the signal parameters.
+};
+
+} // namespace ns3
+
+#endif /* MULTI_MODEL_SPECTRUM_REMOTE_CHANNEL_H */
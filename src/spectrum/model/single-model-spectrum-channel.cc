@@ -86,8 +86,8 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_ASSERT_MSG (txParams->psd, "NULL txPsd");
   NS_ASSERT_MSG (txParams->txPhy, "NULL txPhy");
 
-  Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
-  m_txSigParamsTrace (txParamsTrace);
+  // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
+  NS_TRACED_CALLBACK_FIRE (m_txSigParamsTrace, txParams->Copy ());
 
   // just a sanity check routine. We might want to remove it to save some computational load -- one "if" statement  ;-)
   if (m_spectrumModel == 0)
@@ -147,9 +147,9 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                 }                    
               NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
               // Gain trace
-              m_gainTrace (senderMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
+              NS_TRACED_CALLBACK_FIRE (m_gainTrace, senderMobility, receiverMobility, txAntennaGain, rxAntennaGain, propagationGainDb, pathLossDb);
               // Pathloss trace
-              m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
+              NS_TRACED_CALLBACK_FIRE (m_pathLossTrace, txParams->txPhy, *rxPhyIterator, pathLossDb);
               if ( pathLossDb > m_maxLossDb)
                 {
                   // beyond range
@@ -175,7 +175,14 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
             {
               // the receiver has a NetDevice, so we expect that it is attached to a Node
               uint32_t dstNode =  netDev->GetNode ()->GetId ();
-              Simulator::ScheduleWithContext (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator);
+              if (m_independentRx)
+                {
+                  Simulator::ScheduleIndependent (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator);
+                }
+              else
+                {
+                  Simulator::ScheduleWithContext (dstNode, delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, *rxPhyIterator);
+                }
             }
           else
             {
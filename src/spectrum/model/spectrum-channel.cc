@@ -20,7 +20,11 @@
 
 #include <ns3/log.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/pointer.h>
+#include <ns3/node.h>
+#include <ns3/multithreaded-simulator-impl.h>
+#include <algorithm>
 
 #include "spectrum-channel.h"
 
@@ -70,6 +74,17 @@ SpectrumChannel::GetTypeId (void)
                    MakeDoubleAccessor (&SpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
 
+    .AddAttribute ("IndependentRx",
+                   "If true, the receptions of a signal by the nodes are "
+                   "scheduled as independent events, which the "
+                   "DefaultSimulatorImpl may execute in parallel when they "
+                   "happen at the same time (see its BatchThreads attribute). "
+                   "Enable it only if the receiving PHYs, and the trace sinks "
+                   "they invoke, only touch the state of their own node.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&SpectrumChannel::m_independentRx),
+                   MakeBooleanChecker ())
+
     .AddAttribute ("PropagationLossModel",
                    "A pointer to the propagation loss model attached to this channel.",
                    PointerValue (0),
@@ -155,5 +170,40 @@ SpectrumChannel::GetPropagationLossModel ()
   return m_propagationLoss;
 }
 
+Time
+SpectrumChannel::GetMinimumPropagationDelay (void) const
+{
+  NS_LOG_FUNCTION (this);
+  // GetDevice () is not cheap on every channel: look the devices up once
+  std::vector<Ptr<MobilityModel> > mobility;
+  std::vector<uint32_t> partition;
+  for (std::size_t i = 0; i < GetNDevices (); i++)
+    {
+      Ptr<Node> node = GetDevice (i)->GetNode ();
+      mobility.push_back (node->GetObject<MobilityModel> ());
+      partition.push_back (MultithreadedSimulatorImpl::GetPartition (node->GetId ()));
+    }
+
+  Time minDelay = Time::Max ();
+  for (std::size_t i = 0; i < mobility.size (); i++)
+    {
+      for (std::size_t j = i + 1; j < mobility.size (); j++)
+        {
+          if (partition[i] == partition[j])
+            {
+              continue;
+            }
+          if (m_propagationDelay == 0 || mobility[i] == 0 || mobility[j] == 0)
+            {
+              // the signal is delivered without delay
+              return Seconds (0);
+            }
+          minDelay = std::min (minDelay, m_propagationDelay->GetDelay (mobility[i], mobility[j]));
+        }
+    }
+  NS_LOG_LOGIC ("minimum delay between partitions " << minDelay);
+  return minDelay;
+}
+
 
 } // namespace
@@ -101,6 +101,23 @@ public:
    */
   Ptr<PropagationLossModel> GetPropagationLossModel (void);
 
+  /**
+   * Get the smallest propagation delay between two devices attached to
+   * this channel whose nodes belong to different partitions of the
+   * MultithreadedSimulatorImpl.  The result is a valid Lookahead for
+   * that simulator as long as the nodes do not get closer to each other
+   * and the channel is the only link between the partitions.
+   *
+   * The delay is computed with the positions of the nodes when the
+   * method is called, so it requires a propagation delay model whose
+   * delay only depends on them, such as
+   * ConstantSpeedPropagationDelayModel.
+   *
+   * \returns the minimum delay, zero if there is no propagation delay
+   * model, or Time::Max () if all the devices belong to a single partition.
+   */
+  Time GetMinimumPropagationDelay (void) const;
+
   /**
    * Used by attached PHY instances to transmit signals on the channel
    *
@@ -183,6 +200,11 @@ protected:
    */
   double m_maxLossDb;
 
+  /**
+   * Whether the receptions are scheduled as independent events.
+   */
+  bool m_independentRx;
+
   /**
    * Single-frequency propagation loss model to be used with this channel.
    */
@@ -420,6 +420,20 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Set each component of *this to the SINR of a signal, i.e., compute
+   * signal / (allSignals - signal + noise) in a single pass and without
+   * the temporary SpectrumValue instances that the operators would create.
+   * *this takes the SpectrumModel of the arguments.
+   *
+   * @param signal the PSD of the signal of interest
+   * @param allSignals the sum of the PSDs of all the signals, signal included
+   * @param noise the noise PSD
+   *
+   * @return this instance
+   */
+  SpectrumValue& AssignSinr (const SpectrumValue& signal, const SpectrumValue& allSignals, const SpectrumValue& noise);
+
 
 
   /**
@@ -33,6 +33,7 @@
 #include <ns3/simulator.h>
 #include "ns3/mobility-model.h"
 #include "ns3/pointer.h"
+#include "ns3/memory-gauge.h"
 
 namespace ns3 {
 
@@ -40,6 +41,9 @@ NS_LOG_COMPONENT_DEFINE ("ThreeGppChannelModel");
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppChannelModel);
 
+/// The memory used by the channel realizations of all the ThreeGppChannelModel
+static MemoryGauge g_channelMapGauge ("spectrum", "ThreeGppChannelModel::m_channelMap");
+
 //Table 7.5-3: Ray offset angles within a cluster, given for rms angle spread normalized to 1.
 static const double offSetAlpha[20] = {
   0.0447,-0.0447,0.1413,-0.1413,0.2492,-0.2492,0.3715,-0.3715,0.5129,-0.5129,0.6797,-0.6797,0.8844,-0.8844,1.1481,-1.1481,1.5195,-1.5195,2.1551,-2.1551
@@ -180,6 +184,13 @@ void
 ThreeGppChannelModel::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  if (MemoryGauge::IsEnabled ())
+    {
+      for (const auto & entry : m_channelMap)
+        {
+          g_channelMapGauge.Remove (GetChannelMatrixBytes (entry.second));
+        }
+    }
   m_channelMap.clear ();
   if (m_channelConditionModel)
     {
@@ -947,6 +958,20 @@ ThreeGppChannelModel::GetThreeGppTable (Ptr<const ChannelCondition> channelCondi
   return table3gpp;
 }
 
+int64_t
+ThreeGppChannelModel::GetChannelMatrixBytes (Ptr<const ThreeGppChannelMatrix> channelMatrix)
+{
+  // the map node holds the key, the pointer and the link to the next node
+  return sizeof (std::pair<const uint32_t, Ptr<ThreeGppChannelMatrix> >) + sizeof (void *)
+         + sizeof (ThreeGppChannelMatrix)
+         + GetHeapBytes (channelMatrix->m_channel)
+         + GetHeapBytes (channelMatrix->m_delay)
+         + GetHeapBytes (channelMatrix->m_angle)
+         + GetHeapBytes (channelMatrix->m_nonSelfBlocking)
+         + GetHeapBytes (channelMatrix->m_norRvAngles)
+         + GetHeapBytes (channelMatrix->m_clusterPhase);
+}
+
 bool
 ThreeGppChannelModel::ChannelMatrixNeedsUpdate (Ptr<const ThreeGppChannelMatrix> channelMatrix, Ptr<const ChannelCondition> channelCondition) const
 {
@@ -1034,6 +1059,14 @@ ThreeGppChannelModel::GetChannel (Ptr<const MobilityModel> aMob,
       channelMatrix->m_nodeIds = std::make_pair (aMob->GetObject<Node> ()->GetId (), bMob->GetObject<Node> ()->GetId ());
 
       // store or replace the channel matrix in the channel map
+      if (MemoryGauge::IsEnabled ())
+        {
+          if (update)
+            {
+              g_channelMapGauge.Remove (GetChannelMatrixBytes (m_channelMap[channelId]));
+            }
+          g_channelMapGauge.Add (GetChannelMatrixBytes (channelMatrix));
+        }
       m_channelMap[channelId] = channelMatrix;
     }
 
@@ -1487,11 +1520,8 @@ ThreeGppChannelModel::GetNewChannel (Vector locUT, Ptr<const ChannelCondition> c
           double sigXprLinear = pow (10, table3gpp->m_sigXpr / 10); // convert to linear
 
           temp.push_back (std::pow (10, (m_normalRv->GetValue () * sigXprLinear + uXprLinear) / 10));
-          DoubleVector temp3; // used to store the PHI valuse
-          for (uint8_t pInd = 0; pInd < 4; pInd++)
-            {
-              temp3.push_back (m_uniformRv->GetValue (-1 * M_PI, M_PI));
-            }
+          DoubleVector temp3 (4); // used to store the PHI valuse
+          m_uniformRv->GetValues (temp3.data (), temp3.size (), -1 * M_PI, M_PI);
           temp2.push_back (temp3);
         }
       crossPolarizationPowerRatios.push_back (temp);
@@ -2009,9 +2039,17 @@ ThreeGppChannelModel::CalcAttenuationOfBlockage (Ptr<ThreeGppChannelModel::Three
 void
 ThreeGppChannelModel::Shuffle (double * first, double * last) const
 {
+  if (last - first < 2)
+    {
+      return;
+    }
+  // draw all the uniforms at once, in the order GetInteger (0, i) would
+  DoubleVector u (last - first - 1);
+  m_uniformRvShuffle->GetValues (u.data (), u.size (), 0, 1);
   for (auto i = (last - first) - 1; i > 0; --i)
     {
-      std::swap (first[i], first[m_uniformRvShuffle->GetInteger (0, i)]);
+      auto j = static_cast<uint32_t> (u[u.size () - i] * (i + 1));
+      std::swap (first[i], first[j]);
     }
 }
 
@@ -255,6 +255,14 @@ private:
    */
   bool ChannelMatrixNeedsUpdate (Ptr<const ThreeGppChannelMatrix> channelMatrix, Ptr<const ChannelCondition> channelCondition) const;
 
+  /**
+   * Estimate the memory used by an entry of the channel map,
+   * for the "spectrum" MemoryGauge of the channel map
+   * \param channelMatrix channel matrix
+   * \return the number of bytes of the matrix and of its map node
+   */
+  static int64_t GetChannelMatrixBytes (Ptr<const ThreeGppChannelMatrix> channelMatrix);
+
   std::unordered_map<uint32_t, Ptr<ThreeGppChannelMatrix> > m_channelMap; //!< map containing the channel realizations
   Time m_updatePeriod; //!< the channel update period
   double m_frequency; //!< the operating frequency
@@ -30,6 +30,7 @@
 #include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/memory-gauge.h"
 #include <map>
 
 namespace ns3 {
@@ -38,6 +39,9 @@ NS_LOG_COMPONENT_DEFINE ("ThreeGppSpectrumPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (ThreeGppSpectrumPropagationLossModel);
 
+/// The memory used by the long term components of all the ThreeGppSpectrumPropagationLossModel
+static MemoryGauge g_longTermMapGauge ("spectrum", "ThreeGppSpectrumPropagationLossModel::m_longTermMap");
+
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel ()
 {
   NS_LOG_FUNCTION (this);
@@ -53,6 +57,13 @@ void
 ThreeGppSpectrumPropagationLossModel::DoDispose ()
 {
   m_deviceAntennaMap.clear ();
+  if (MemoryGauge::IsEnabled ())
+    {
+      for (const auto & entry : m_longTermMap)
+        {
+          g_longTermMapGauge.Remove (GetLongTermBytes (entry.second));
+        }
+    }
   m_longTermMap.clear ();
   m_channelModel->Dispose ();
   m_channelModel = nullptr;
@@ -226,6 +237,17 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain (Ptr<SpectrumValue> tx
   return tempPsd;
 }
 
+int64_t
+ThreeGppSpectrumPropagationLossModel::GetLongTermBytes (Ptr<const LongTerm> longTerm)
+{
+  // the map node holds the key, the pointer and the link to the next node
+  return sizeof (std::pair<const uint32_t, Ptr<const LongTerm> >) + sizeof (void *)
+         + sizeof (LongTerm)
+         + GetHeapBytes (longTerm->m_longTerm)
+         + GetHeapBytes (longTerm->m_sW)
+         + GetHeapBytes (longTerm->m_uW);
+}
+
 PhasedArrayModel::ComplexVector
 ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
                                                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
@@ -289,6 +311,14 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm (uint32_t aId, uint32_t bId,
       longTermItem->m_sW = sW;
       longTermItem->m_uW = uW;
 
+      if (MemoryGauge::IsEnabled ())
+        {
+          if (update)
+            {
+              g_longTermMapGauge.Remove (GetLongTermBytes (m_longTermMap[longTermId]));
+            }
+          g_longTermMapGauge.Add (GetLongTermBytes (longTermItem));
+        }
       m_longTermMap[longTermId] = longTermItem;
     }
 
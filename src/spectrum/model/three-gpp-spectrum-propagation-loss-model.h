@@ -148,6 +148,14 @@ private:
   */
   double GetFrequency () const;
 
+  /**
+   * Estimate the memory used by an entry of the long term map,
+   * for the "spectrum" MemoryGauge of the long term map
+   * \param longTerm the long term component
+   * \return the number of bytes of the component and of its map node
+   */
+  static int64_t GetLongTermBytes (Ptr<const LongTerm> longTerm);
+
   /**
    * Looks for the long term component in m_longTermMap. If found, checks
    * whether it has to be updated. If not found or if it has to be updated,
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks WifiPhy::CalculateTxDuration with and without
+// the TX duration cache. The workload mimics the durations computed during
+// frame exchanges: control frames (ACK, BlockAck, RTS, CTS), data frames
+// and A-MPDUs of growing size, sent with a number of HT/VHT/HE TXVECTORs.
+// Sample usage:  ./ns3 run 'wifi-tx-duration-bench --n=200 --cacheSize=1024'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/ht-phy.h"
+#include "ns3/vht-phy.h"
+#include "ns3/he-phy.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Build the set of TXVECTORs used by the benchmark.
+ *
+ * \return the set of TXVECTORs
+ */
+static std::vector<WifiTxVector>
+GetTxVectors (void)
+{
+  std::vector<WifiTxVector> txVectors;
+
+  for (uint8_t mcs = 0; mcs < 8; mcs++)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (HtPhy::GetHtMcs (mcs));
+      txVector.SetPreambleType (WIFI_PREAMBLE_HT_MF);
+      txVector.SetChannelWidth (40);
+      txVector.SetGuardInterval (800);
+      txVector.SetNss (1);
+      txVectors.push_back (txVector);
+    }
+  for (uint8_t mcs = 0; mcs < 10; mcs++)
+    {
+      WifiTxVector txVector;
+      txVector.SetMode (VhtPhy::GetVhtMcs (mcs));
+      txVector.SetPreambleType (WIFI_PREAMBLE_VHT_SU);
+      txVector.SetChannelWidth (80);
+      txVector.SetGuardInterval (400);
+      txVector.SetNss (2);
+      txVectors.push_back (txVector);
+    }
+  for (uint8_t mcs = 0; mcs < 12; mcs++)
+    {
+      for (uint16_t width : {20, 80, 160})
+        {
+          WifiTxVector txVector;
+          txVector.SetMode (HePhy::GetHeMcs (mcs));
+          txVector.SetPreambleType (WIFI_PREAMBLE_HE_SU);
+          txVector.SetChannelWidth (width);
+          txVector.SetGuardInterval (800);
+          txVector.SetNss (2);
+          txVectors.push_back (txVector);
+        }
+    }
+  return txVectors;
+}
+
+/**
+ * Compute the TX durations of the benchmark workload.
+ *
+ * \param txVectors the set of TXVECTORs
+ * \param n the number of times the workload is repeated
+ * \param [out] checksum the sum of all the computed durations
+ * \return the elapsed wall clock time in milliseconds
+ */
+static int64_t
+RunBench (const std::vector<WifiTxVector>& txVectors, uint32_t n, Time& checksum)
+{
+  // ACK, CTS, RTS, Compressed BlockAck, Multi-STA BlockAck, data frames
+  const std::vector<uint32_t> sizes {14, 20, 32, 56, 112, 1536, 3072};
+  const uint32_t ampduSubframeSize = 1542;
+
+  checksum = Seconds (0);
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < n; i++)
+    {
+      for (const auto& txVector : txVectors)
+        {
+          for (const auto size : sizes)
+            {
+              checksum += WifiPhy::CalculateTxDuration (size, txVector, WIFI_PHY_BAND_5GHZ);
+            }
+          for (uint32_t ampduSize = ampduSubframeSize; ampduSize <= 64 * ampduSubframeSize;
+               ampduSize += ampduSubframeSize)
+            {
+              checksum += WifiPhy::CalculateTxDuration (ampduSize, txVector, WIFI_PHY_BAND_5GHZ);
+            }
+        }
+    }
+  return time.End ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100;
+  uint32_t cacheSize = 4096;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("n", "number of times the workload is repeated", n);
+  cmd.AddValue ("cacheSize", "capacity of the TX duration cache", cacheSize);
+  cmd.Parse (argc, argv);
+
+  std::vector<WifiTxVector> txVectors = GetTxVectors ();
+  WifiTxDurationCache& cache = WifiPhy::GetTxDurationCache ();
+  Time uncachedChecksum;
+  Time cachedChecksum;
+
+  cache.SetCapacity (0);
+  int64_t uncached = RunBench (txVectors, n, uncachedChecksum);
+
+  cache.Clear ();
+  cache.SetCapacity (cacheSize);
+  int64_t cached = RunBench (txVectors, n, cachedChecksum);
+
+  std::cout << "uncached: " << uncached << " ms" << std::endl
+            << "cached (capacity " << cacheSize << "): " << cached << " ms, "
+            << cache.GetHits () << " hits, " << cache.GetMisses () << " misses" << std::endl;
+
+  if (uncachedChecksum != cachedChecksum)
+    {
+      std::cerr << "TX durations differ: " << uncachedChecksum << " vs " << cachedChecksum << std::endl;
+      return 1;
+    }
+  return 0;
+}
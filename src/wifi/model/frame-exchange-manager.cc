@@ -510,7 +510,7 @@ Time
 FrameExchangeManager::GetTxDuration (uint32_t ppduPayloadSize, Mac48Address receiver,
                                      const WifiTxParameters& txParams) const
 {
-  return m_phy->CalculateTxDuration (ppduPayloadSize, txParams.m_txVector, m_phy->GetPhyBand ());
+  return txParams.CalculateTxDuration (ppduPayloadSize, m_phy->GetPhyBand ());
 }
 
 void
@@ -248,7 +248,7 @@ HePhy::GetSigBDuration (const WifiTxVector& txVector) const
       double numDataBitsPerSymbol = GetSigBMode (txVector).GetDataRate (20, 800, 1) * symbolDuration.GetNanoSeconds () / 1e9;
       double numSymbols = ceil ((commonFieldSize + userSpecificFieldSize) / numDataBitsPerSymbol);
 
-      return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+      return GetSymbolsDuration (symbolDuration, numSymbols);
     }
   else
     {
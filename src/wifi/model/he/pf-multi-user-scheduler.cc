@@ -0,0 +1,723 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "pf-multi-user-scheduler.h"
+#include "ns3/wifi-protection.h"
+#include "ns3/wifi-acknowledgment.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-mac-queue.h"
+#include "he-frame-exchange-manager.h"
+#include "he-configuration.h"
+#include "he-phy.h"
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PfMultiUserScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (PfMultiUserScheduler);
+
+TypeId
+PfMultiUserScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::PfMultiUserScheduler")
+    .SetParent<MultiUserScheduler> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<PfMultiUserScheduler> ()
+    .AddAttribute ("NStations",
+                   "The maximum number of stations that can be granted an RU in a DL MU OFDMA transmission",
+                   UintegerValue (4),
+                   MakeUintegerAccessor (&PfMultiUserScheduler::m_nStations),
+                   MakeUintegerChecker<uint8_t> (1, 74))
+    .AddAttribute ("EnableTxopSharing",
+                   "If enabled, allow A-MPDUs of different TIDs in a DL MU PPDU.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&PfMultiUserScheduler::m_enableTxopSharing),
+                   MakeBooleanChecker ())
+    .AddAttribute ("ForceDlOfdma",
+                   "If enabled, return DL_MU_TX even if no DL MU PPDU could be built.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PfMultiUserScheduler::m_forceDlOfdma),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UseCentral26TonesRus",
+                   "If enabled, central 26-tone RUs are allocated, too, when the "
+                   "selected RU type is at least 52 tones.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&PfMultiUserScheduler::m_useCentral26TonesRus),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RateExponent",
+                   "The exponent of the data rate of a station in the proportional fair metric.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&PfMultiUserScheduler::m_rateExponent),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("ThroughputExponent",
+                   "The exponent of the average throughput of a station in the proportional "
+                   "fair metric. Setting this attribute to zero makes the scheduler serve "
+                   "the stations with the highest data rate first.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&PfMultiUserScheduler::m_throughputExponent),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("AveragingTime",
+                   "The time constant of the exponentially weighted moving average of "
+                   "the throughput achieved by each station.",
+                   TimeValue (MilliSeconds (100)),
+                   MakeTimeAccessor (&PfMultiUserScheduler::m_averagingTime),
+                   MakeTimeChecker (NanoSeconds (1)))
+  ;
+  return tid;
+}
+
+PfMultiUserScheduler::PfMultiUserScheduler ()
+  : m_round (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+PfMultiUserScheduler::~PfMultiUserScheduler ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+}
+
+void
+PfMultiUserScheduler::DoInitialize (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_apMac != nullptr);
+  m_apMac->TraceConnectWithoutContext ("AssociatedSta",
+                                       MakeCallback (&PfMultiUserScheduler::NotifyStationAssociated, this));
+  m_apMac->TraceConnectWithoutContext ("DeAssociatedSta",
+                                       MakeCallback (&PfMultiUserScheduler::NotifyStationDeassociated, this));
+  for (const auto& ac : wifiAcList)
+    {
+      Ptr<WifiMacQueue> queue = m_apMac->GetQosTxop (ac.first)->GetWifiMacQueue ();
+      queue->TraceConnectWithoutContext ("Enqueue",
+                                         MakeCallback (&PfMultiUserScheduler::NotifyEnqueue, this));
+      queue->TraceConnectWithoutContext ("Dequeue",
+                                         MakeCallback (&PfMultiUserScheduler::NotifyDequeue, this));
+    }
+  MultiUserScheduler::DoInitialize ();
+}
+
+void
+PfMultiUserScheduler::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (auto& backlog : m_backlog)
+    {
+      backlog.clear ();
+    }
+  m_staInfo.clear ();
+  m_candidates.clear ();
+  m_rus.clear ();
+  m_central26TonesRus.clear ();
+  m_txParams.Clear ();
+  m_apMac->TraceDisconnectWithoutContext ("AssociatedSta",
+                                          MakeCallback (&PfMultiUserScheduler::NotifyStationAssociated, this));
+  m_apMac->TraceDisconnectWithoutContext ("DeAssociatedSta",
+                                          MakeCallback (&PfMultiUserScheduler::NotifyStationDeassociated, this));
+  for (const auto& ac : wifiAcList)
+    {
+      Ptr<QosTxop> qosTxop = m_apMac->GetQosTxop (ac.first);
+      if (qosTxop != nullptr && qosTxop->GetWifiMacQueue () != nullptr)
+        {
+          qosTxop->GetWifiMacQueue ()->TraceDisconnectWithoutContext ("Enqueue",
+                                                                      MakeCallback (&PfMultiUserScheduler::NotifyEnqueue, this));
+          qosTxop->GetWifiMacQueue ()->TraceDisconnectWithoutContext ("Dequeue",
+                                                                      MakeCallback (&PfMultiUserScheduler::NotifyDequeue, this));
+        }
+    }
+  MultiUserScheduler::DoDispose ();
+}
+
+std::size_t
+PfMultiUserScheduler::GetNBackloggedStations (AcIndex ac) const
+{
+  // the AcIndex comparison operators only accept QoS ACs
+  NS_ASSERT (static_cast<uint8_t> (ac) < AC_BE_NQOS);
+  return m_backlog[ac].size ();
+}
+
+MultiUserScheduler::TxFormat
+PfMultiUserScheduler::SelectTxFormat (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<const WifiMacQueueItem> mpdu = m_edca->PeekNextMpdu ();
+
+  if (mpdu != 0 && !GetWifiRemoteStationManager ()->GetHeSupported (mpdu->GetHeader ().GetAddr1 ()))
+    {
+      return SU_TX;
+    }
+
+  return TrySendingDlMuPpdu ();
+}
+
+void
+PfMultiUserScheduler::NotifyStationAssociated (uint16_t aid, Mac48Address address)
+{
+  NS_LOG_FUNCTION (this << aid << address);
+
+  if (!GetWifiRemoteStationManager ()->GetHeSupported (address))
+    {
+      return;
+    }
+
+  auto staIt = m_staInfo.find (address);
+  if (staIt != m_staInfo.end ())
+    {
+      // the station re-associated
+      staIt->second.aid = aid;
+      return;
+    }
+
+  StaInfo& sta = m_staInfo[address];
+  sta.aid = aid;
+  sta.address = address;
+  sta.rate = 0.0;
+  sta.avgThroughput = 0.0;
+  sta.lastUpdate = Simulator::Now ();
+  sta.lastVisit = m_round;
+  sta.backlogIndex.fill (NOT_BACKLOGGED);
+
+  // frames addressed to the station may have been queued before the association
+  for (const auto& ac : wifiAcList)
+    {
+      Ptr<WifiMacQueue> queue = m_apMac->GetQosTxop (ac.first)->GetWifiMacQueue ();
+      sta.nMpdus[ac.first] = queue->GetNPackets (ac.second.GetLowTid (), address)
+                             + queue->GetNPackets (ac.second.GetHighTid (), address);
+      if (sta.nMpdus[ac.first] > 0)
+        {
+          AddToBacklog (sta, ac.first);
+        }
+    }
+}
+
+void
+PfMultiUserScheduler::NotifyStationDeassociated (uint16_t aid, Mac48Address address)
+{
+  NS_LOG_FUNCTION (this << aid << address);
+
+  auto staIt = m_staInfo.find (address);
+  if (staIt == m_staInfo.end () || staIt->second.aid != aid)
+    {
+      return;
+    }
+
+  for (const auto& ac : wifiAcList)
+    {
+      RemoveFromBacklog (staIt->second, ac.first);
+    }
+  m_staInfo.erase (staIt);
+}
+
+void
+PfMultiUserScheduler::NotifyEnqueue (Ptr<const WifiMacQueueItem> item)
+{
+  const WifiMacHeader& hdr = item->GetHeader ();
+  if (!hdr.IsQosData ())
+    {
+      return;
+    }
+
+  auto staIt = m_staInfo.find (hdr.GetAddr1 ());
+  if (staIt == m_staInfo.end ())
+    {
+      return;
+    }
+
+  AcIndex ac = QosUtilsMapTidToAc (hdr.GetQosTid ());
+  if (staIt->second.nMpdus[ac]++ == 0)
+    {
+      AddToBacklog (staIt->second, ac);
+    }
+}
+
+void
+PfMultiUserScheduler::NotifyDequeue (Ptr<const WifiMacQueueItem> item)
+{
+  const WifiMacHeader& hdr = item->GetHeader ();
+  if (!hdr.IsQosData ())
+    {
+      return;
+    }
+
+  auto staIt = m_staInfo.find (hdr.GetAddr1 ());
+  if (staIt == m_staInfo.end ())
+    {
+      return;
+    }
+
+  AcIndex ac = QosUtilsMapTidToAc (hdr.GetQosTid ());
+  NS_ASSERT (staIt->second.nMpdus[ac] > 0);
+  if (--staIt->second.nMpdus[ac] == 0)
+    {
+      RemoveFromBacklog (staIt->second, ac);
+    }
+}
+
+void
+PfMultiUserScheduler::AddToBacklog (StaInfo& sta, AcIndex ac)
+{
+  if (sta.backlogIndex[ac] != NOT_BACKLOGGED)
+    {
+      return;
+    }
+  sta.backlogIndex[ac] = m_backlog[ac].size ();
+  m_backlog[ac].push_back (&sta);
+}
+
+void
+PfMultiUserScheduler::RemoveFromBacklog (StaInfo& sta, AcIndex ac)
+{
+  std::size_t index = sta.backlogIndex[ac];
+  if (index == NOT_BACKLOGGED)
+    {
+      return;
+    }
+  NS_ASSERT (index < m_backlog[ac].size () && m_backlog[ac][index] == &sta);
+  // move the last station of the backlog in place of the removed one
+  StaInfo* last = m_backlog[ac].back ();
+  m_backlog[ac][index] = last;
+  last->backlogIndex[ac] = index;
+  m_backlog[ac].pop_back ();
+  sta.backlogIndex[ac] = NOT_BACKLOGGED;
+}
+
+double
+PfMultiUserScheduler::GetAvgThroughput (const StaInfo& sta) const
+{
+  Time elapsed = Simulator::Now () - sta.lastUpdate;
+  return sta.avgThroughput * std::exp (-elapsed.GetSeconds () / m_averagingTime.GetSeconds ());
+}
+
+double
+PfMultiUserScheduler::GetPfMetric (const StaInfo& sta) const
+{
+  if (sta.rate == 0.0)
+    {
+      // serve first the stations for which no data rate is known yet
+      return std::numeric_limits<double>::max ();
+    }
+  // the average throughput is lower bounded to 1 bps to avoid dividing by zero
+  return std::pow (sta.rate, m_rateExponent)
+         / std::pow (std::max (GetAvgThroughput (sta), 1.0), m_throughputExponent);
+}
+
+MultiUserScheduler::TxFormat
+PfMultiUserScheduler::TrySendingDlMuPpdu (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_staInfo.empty ())
+    {
+      NS_LOG_DEBUG ("No HE stations associated: return SU_TX");
+      return TxFormat::SU_TX;
+    }
+
+  AcIndex primaryAc = m_edca->GetAccessCategory ();
+  uint8_t currTid = wifiAcList.at (primaryAc).GetHighTid ();
+
+  Ptr<const WifiMacQueueItem> mpdu = m_edca->PeekNextMpdu ();
+
+  if (mpdu != nullptr && mpdu->GetHeader ().IsQosData ())
+    {
+      currTid = mpdu->GetHeader ().GetQosTid ();
+    }
+
+  // determine the list of TIDs to check and collect the stations for which
+  // frames of the corresponding ACs are queued
+  std::vector<uint8_t> tids;
+  std::vector<std::pair<double, StaInfo*>> backlogged;
+  m_round++;
+
+  for (auto acIt = wifiAcList.find (primaryAc); acIt != wifiAcList.end (); acIt++)
+    {
+      if (!m_enableTxopSharing && acIt->first != primaryAc)
+        {
+          break;
+        }
+
+      uint8_t firstTid = (acIt->first == primaryAc ? currTid : acIt->second.GetHighTid ());
+      tids.push_back (firstTid);
+      if (m_enableTxopSharing)
+        {
+          tids.push_back (acIt->second.GetOtherTid (firstTid));
+        }
+
+      for (StaInfo* sta : m_backlog[acIt->first])
+        {
+          if (sta->lastVisit != m_round)
+            {
+              sta->lastVisit = m_round;
+              backlogged.push_back ({GetPfMetric (*sta), sta});
+            }
+        }
+    }
+
+  NS_LOG_DEBUG (backlogged.size () << " backlogged stations out of " << m_staInfo.size ());
+
+  m_candidates.clear ();
+
+  if (backlogged.empty ())
+    {
+      if (m_forceDlOfdma)
+        {
+          NS_LOG_DEBUG ("The AP does not have frames to transmit to HE stations: return NO_TX");
+          return NO_TX;
+        }
+      NS_LOG_DEBUG ("The AP does not have frames to transmit to HE stations: return SU_TX");
+      return SU_TX;
+    }
+
+  std::size_t count = std::min (static_cast<std::size_t> (m_nStations), backlogged.size ());
+  std::size_t nCentral26TonesRus;
+  HeRu::RuType ruType = HeRu::GetEqualSizedRusForStations (m_apMac->GetWifiPhy ()->GetChannelWidth (), count,
+                                                           nCentral26TonesRus);
+  NS_ASSERT (count >= 1);
+
+  if (!m_useCentral26TonesRus)
+    {
+      nCentral26TonesRus = 0;
+    }
+
+  Ptr<HeConfiguration> heConfiguration = m_apMac->GetHeConfiguration ();
+  NS_ASSERT (heConfiguration != 0);
+
+  m_txParams.Clear ();
+  m_txParams.m_txVector.SetPreambleType (WIFI_PREAMBLE_HE_MU);
+  m_txParams.m_txVector.SetChannelWidth (m_apMac->GetWifiPhy ()->GetChannelWidth ());
+  m_txParams.m_txVector.SetGuardInterval (heConfiguration->GetGuardInterval ().GetNanoSeconds ());
+  m_txParams.m_txVector.SetBssColor (heConfiguration->GetBssColor ());
+
+  // The TXOP limit can be exceeded by the TXOP holder if it does not transmit more
+  // than one Data or Management frame in the TXOP and the frame is not in an A-MPDU
+  // consisting of more than one MPDU (Sec. 10.22.2.8 of 802.11-2016).
+  // For the moment, we are considering just one MPDU per receiver.
+  Time actualAvailableTime = (m_initialFrame ? Time::Min () : m_availableTime);
+
+  // stations are extracted in decreasing order of PF metric (ties are broken by
+  // AID) until an enough number of stations is identified
+  auto compare = [] (const std::pair<double, StaInfo*>& a, const std::pair<double, StaInfo*>& b)
+    {
+      return a.first < b.first || (a.first == b.first && a.second->aid > b.second->aid);
+    };
+  std::make_heap (backlogged.begin (), backlogged.end (), compare);
+
+  while (!backlogged.empty ()
+         && m_candidates.size () < std::min (static_cast<std::size_t> (m_nStations), count + nCentral26TonesRus))
+    {
+      std::pop_heap (backlogged.begin (), backlogged.end (), compare);
+      StaInfo* sta = backlogged.back ().second;
+      backlogged.pop_back ();
+
+      NS_LOG_DEBUG ("Next candidate STA (MAC=" << sta->address << ", AID=" << sta->aid << ")");
+
+      HeRu::RuType currRuType = (m_candidates.size () < count ? ruType : HeRu::RU_26_TONE);
+
+      // check if the AP has at least one frame to be sent to the current station
+      for (uint8_t tid : tids)
+        {
+          AcIndex ac = QosUtilsMapTidToAc (tid);
+          NS_ASSERT (ac >= primaryAc);
+          // skip the TIDs of the ACs for which no frame is queued
+          if (sta->nMpdus[ac] == 0)
+            {
+              continue;
+            }
+          // check that a BA agreement is established with the receiver for the
+          // considered TID, since ack sequences for DL MU PPDUs require block ack
+          if (m_apMac->GetQosTxop (ac)->GetBaAgreementEstablished (sta->address, tid))
+            {
+              mpdu = m_apMac->GetQosTxop (ac)->PeekNextMpdu (tid, sta->address);
+
+              // we only check if the first frame of the current TID meets the size
+              // and duration constraints. We do not explore the queues further.
+              if (mpdu != 0)
+                {
+                  // Use a temporary TX vector including only the STA-ID of the
+                  // candidate station to check if the MPDU meets the size and time limits.
+                  // An RU of the computed size is tentatively assigned to the candidate
+                  // station, so that the TX duration can be correctly computed.
+                  WifiTxVector suTxVector = GetWifiRemoteStationManager ()->GetDataTxVector (mpdu->GetHeader ()),
+                               txVectorCopy = m_txParams.m_txVector;
+
+                  // keep track of the data rate for the computation of the PF metric
+                  sta->rate = suTxVector.GetMode ().GetDataRate (suTxVector);
+
+                  m_txParams.m_txVector.SetHeMuUserInfo (sta->aid,
+                                                         {{currRuType, 1, false},
+                                                          suTxVector.GetMode (),
+                                                          suTxVector.GetNss ()});
+
+                  if (!m_heFem->TryAddMpdu (mpdu, m_txParams, actualAvailableTime))
+                    {
+                      NS_LOG_DEBUG ("Adding the peeked frame violates the time constraints");
+                      m_txParams.m_txVector = txVectorCopy;
+                    }
+                  else
+                    {
+                      // the frame meets the constraints
+                      NS_LOG_DEBUG ("Adding candidate STA (MAC=" << sta->address << ", AID="
+                                    << sta->aid << ") TID=" << +tid);
+                      m_candidates.push_back ({sta, mpdu});
+                      break;    // terminate the for loop
+                    }
+                }
+              else
+                {
+                  NS_LOG_DEBUG ("No frames to send to " << sta->address << " with TID=" << +tid);
+                }
+            }
+        }
+    }
+
+  if (m_candidates.empty ())
+    {
+      if (m_forceDlOfdma)
+        {
+          NS_LOG_DEBUG ("The AP does not have suitable frames to transmit: return NO_TX");
+          return NO_TX;
+        }
+      NS_LOG_DEBUG ("The AP does not have suitable frames to transmit: return SU_TX");
+      return SU_TX;
+    }
+
+  return TxFormat::DL_MU_TX;
+}
+
+MultiUserScheduler::DlMuInfo
+PfMultiUserScheduler::ComputeDlMuInfo (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_candidates.empty ())
+    {
+      return DlMuInfo ();
+    }
+
+  uint16_t bw = m_apMac->GetWifiPhy ()->GetChannelWidth ();
+
+  // compute how many stations can be granted an RU and the RU size
+  std::size_t nRusAssigned = m_txParams.GetPsduInfoMap ().size ();
+  std::size_t nCentral26TonesRus;
+  HeRu::RuType ruType = HeRu::GetEqualSizedRusForStations (bw, nRusAssigned, nCentral26TonesRus);
+
+  NS_LOG_DEBUG (nRusAssigned << " stations are being assigned a " << ruType << " RU");
+
+  if (!m_useCentral26TonesRus || m_candidates.size () == nRusAssigned)
+    {
+      nCentral26TonesRus = 0;
+    }
+  else
+    {
+      nCentral26TonesRus = std::min (m_candidates.size () - nRusAssigned, nCentral26TonesRus);
+      NS_LOG_DEBUG (nCentral26TonesRus << " stations are being assigned a 26-tones RU");
+    }
+
+  DlMuInfo dlMuInfo;
+
+  // We have to update the TXVECTOR
+  dlMuInfo.txParams.m_txVector.SetPreambleType (m_txParams.m_txVector.GetPreambleType ());
+  dlMuInfo.txParams.m_txVector.SetChannelWidth (m_txParams.m_txVector.GetChannelWidth ());
+  dlMuInfo.txParams.m_txVector.SetGuardInterval (m_txParams.m_txVector.GetGuardInterval ());
+  dlMuInfo.txParams.m_txVector.SetBssColor (m_txParams.m_txVector.GetBssColor ());
+
+  auto candidateIt = m_candidates.begin (); // iterator over the list of candidate receivers
+
+  for (std::size_t i = 0; i < nRusAssigned + nCentral26TonesRus; i++)
+    {
+      NS_ASSERT (candidateIt != m_candidates.end ());
+
+      uint16_t staId = candidateIt->first->aid;
+      // AssignRuIndices will be called below to set RuSpec
+      dlMuInfo.txParams.m_txVector.SetHeMuUserInfo (staId,
+                                                    {{(i < nRusAssigned ? ruType : HeRu::RU_26_TONE), 1, false},
+                                                      m_txParams.m_txVector.GetMode (staId),
+                                                      m_txParams.m_txVector.GetNss (staId)});
+      candidateIt++;
+    }
+
+  // remove candidates that will not be served
+  m_candidates.erase (candidateIt, m_candidates.end ());
+
+  AssignRuIndices (dlMuInfo.txParams.m_txVector);
+  m_txParams.Clear ();
+
+  Ptr<const WifiMacQueueItem> mpdu;
+
+  // Compute the TX params (again) by using the stored MPDUs and the final TXVECTOR
+  Time actualAvailableTime = (m_initialFrame ? Time::Min () : m_availableTime);
+
+  for (const auto& candidate : m_candidates)
+    {
+      mpdu = candidate.second;
+      NS_ASSERT (mpdu != nullptr);
+
+      bool ret = m_heFem->TryAddMpdu (mpdu, dlMuInfo.txParams, actualAvailableTime);
+      NS_UNUSED (ret);
+      NS_ASSERT_MSG (ret, "Weird that an MPDU does not meet constraints when "
+                          "transmitted over a larger RU");
+    }
+
+  // We have to complete the PSDUs to send
+  Mac48Address receiver;
+
+  for (const auto& candidate : m_candidates)
+    {
+      // Let us try first A-MSDU aggregation if possible
+      mpdu = candidate.second;
+      NS_ASSERT (mpdu != nullptr);
+      uint8_t tid = mpdu->GetHeader ().GetQosTid ();
+      receiver = mpdu->GetHeader ().GetAddr1 ();
+      NS_ASSERT (receiver == candidate.first->address);
+
+      NS_ASSERT (mpdu->IsQueued ());
+      WifiMacQueueItem::ConstIterator queueIt = mpdu->GetQueueIterator ();
+      Ptr<WifiMacQueueItem> item = *queueIt;
+      queueIt++;
+
+      if (!mpdu->GetHeader ().IsRetry ())
+        {
+          // this MPDU must have been dequeued from the AC queue and we can try
+          // A-MSDU aggregation
+          item = m_heFem->GetMsduAggregator ()->GetNextAmsdu (mpdu, dlMuInfo.txParams, m_availableTime, queueIt);
+
+          if (item == nullptr)
+            {
+              // A-MSDU aggregation failed or disabled
+              item = *mpdu->GetQueueIterator ();
+            }
+          m_apMac->GetQosTxop (QosUtilsMapTidToAc (tid))->AssignSequenceNumber (item);
+        }
+
+      // Now, let's try A-MPDU aggregation if possible
+      std::vector<Ptr<WifiMacQueueItem>> mpduList = m_heFem->GetMpduAggregator ()->GetNextAmpdu (item, dlMuInfo.txParams, m_availableTime, queueIt);
+
+      if (mpduList.size () > 1)
+        {
+          // A-MPDU aggregation succeeded, update psduMap
+          dlMuInfo.psduMap[candidate.first->aid] = Create<WifiPsdu> (std::move (mpduList));
+        }
+      else
+        {
+          dlMuInfo.psduMap[candidate.first->aid] = Create<WifiPsdu> (item, true);
+        }
+    }
+
+  // update the average throughput of the served stations. The average throughput
+  // of the other stations is updated lazily, when their PF metric is computed
+  Time now = Simulator::Now ();
+
+  for (const auto& candidate : m_candidates)
+    {
+      StaInfo* sta = candidate.first;
+      double bits = dlMuInfo.psduMap.at (sta->aid)->GetSize () * 8.0;
+      sta->avgThroughput = GetAvgThroughput (*sta) + bits / m_averagingTime.GetSeconds ();
+      sta->lastUpdate = now;
+    }
+
+  return dlMuInfo;
+}
+
+const std::vector<HeRu::RuSpec>&
+PfMultiUserScheduler::GetRusOfType (uint16_t bw, HeRu::RuType ruType)
+{
+  auto it = m_rus.find ({bw, ruType});
+  if (it == m_rus.end ())
+    {
+      it = m_rus.insert ({{bw, ruType}, HeRu::GetRusOfType (bw, ruType)}).first;
+    }
+  return it->second;
+}
+
+const std::vector<HeRu::RuSpec>&
+PfMultiUserScheduler::GetCentral26TonesRus (uint16_t bw, HeRu::RuType ruType)
+{
+  auto it = m_central26TonesRus.find ({bw, ruType});
+  if (it == m_central26TonesRus.end ())
+    {
+      it = m_central26TonesRus.insert ({{bw, ruType}, HeRu::GetCentral26TonesRus (bw, ruType)}).first;
+    }
+  return it->second;
+}
+
+void
+PfMultiUserScheduler::AssignRuIndices (WifiTxVector& txVector)
+{
+  NS_LOG_FUNCTION (this << txVector);
+
+  uint16_t bw = txVector.GetChannelWidth ();
+
+  // find the RU types allocated in the TXVECTOR
+  std::set<HeRu::RuType> ruTypeSet;
+  for (const auto& userInfo : txVector.GetHeMuUserInfoMap ())
+    {
+      ruTypeSet.insert (userInfo.second.ru.GetRuType ());
+    }
+
+  static const std::vector<HeRu::RuSpec> noRus;
+  const std::vector<HeRu::RuSpec>* central26TonesRus = &noRus;
+
+  // This scheduler allocates equal sized RUs and optionally the remaining 26-tone RUs
+  if (ruTypeSet.size () == 2)
+    {
+      // central 26-tone RUs have been allocated
+      NS_ASSERT (ruTypeSet.find (HeRu::RU_26_TONE) != ruTypeSet.end ());
+      ruTypeSet.erase (HeRu::RU_26_TONE);
+      NS_ASSERT (ruTypeSet.size () == 1);
+      central26TonesRus = &GetCentral26TonesRus (bw, *ruTypeSet.begin ());
+    }
+
+  NS_ASSERT (ruTypeSet.size () == 1);
+  const std::vector<HeRu::RuSpec>& ruSet = GetRusOfType (bw, *ruTypeSet.begin ());
+
+  auto ruSetIt = ruSet.begin ();
+  auto central26TonesRusIt = central26TonesRus->begin ();
+
+  for (const auto& userInfo : txVector.GetHeMuUserInfoMap ())
+    {
+      if (userInfo.second.ru.GetRuType () == *ruTypeSet.begin ())
+        {
+          NS_ASSERT (ruSetIt != ruSet.end ());
+          txVector.SetRu (*ruSetIt, userInfo.first);
+          ruSetIt++;
+        }
+      else
+        {
+          NS_ASSERT (central26TonesRusIt != central26TonesRus->end ());
+          txVector.SetRu (*central26TonesRusIt, userInfo.first);
+          central26TonesRusIt++;
+        }
+    }
+}
+
+MultiUserScheduler::UlMuInfo
+PfMultiUserScheduler::ComputeUlMuInfo (void)
+{
+  NS_LOG_FUNCTION (this);
+  // SelectTxFormat never returns UL_MU_TX, hence this method is not expected
+  // to be called. If it is, the HE Frame Exchange Manager does not transmit
+  // anything because the returned Trigger Frame is null.
+  NS_LOG_DEBUG ("UL OFDMA is not supported by PfMultiUserScheduler");
+  return UlMuInfo ();
+}
+
+} //namespace ns3
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PF_MULTI_USER_SCHEDULER_H
+#define PF_MULTI_USER_SCHEDULER_H
+
+#include "multi-user-scheduler.h"
+#include "he-ru.h"
+#include "ns3/qos-utils.h"
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <map>
+#include <limits>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * PfMultiUserScheduler is a DL OFDMA scheduler designed to scale to a large number
+ * of associated stations. Rather than querying the AC queues of the AP for every
+ * associated station whenever a DL MU PPDU has to be built, it keeps track of the
+ * stations for which frames are queued (per AC) by listening to the Enqueue and
+ * Dequeue trace sources of the AC queues. Hence, the cost of building a DL MU PPDU
+ * depends on the number of backlogged stations only.
+ *
+ * Backlogged stations are served in decreasing order of their proportional fair
+ * metric, i.e., r^a / T^b, where r is the data rate of the TXVECTOR last selected
+ * for the station by the remote station manager, T is the exponentially weighted
+ * moving average of the throughput achieved by the station and a and b are
+ * configurable exponents. Stations for which no data rate is known yet are served
+ * first. As in RrMultiUserScheduler, RUs of equal size are assigned to the selected
+ * stations (plus, optionally, the central 26-tone RUs); the sets of RUs of a given
+ * type are computed once per channel width and then reused.
+ *
+ * This scheduler only builds DL MU PPDUs: it never solicits HE TB PPDUs, hence
+ * UL OFDMA requires a different scheduler (e.g., RrMultiUserScheduler).
+ */
+class PfMultiUserScheduler : public MultiUserScheduler
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  PfMultiUserScheduler ();
+  virtual ~PfMultiUserScheduler ();
+
+  /**
+   * \param ac the given Access Category
+   * \return the number of associated HE stations for which the AP has frames
+   *         of the given AC queued
+   */
+  std::size_t GetNBackloggedStations (AcIndex ac) const;
+
+protected:
+  void DoDispose (void) override;
+  void DoInitialize (void) override;
+
+private:
+  TxFormat SelectTxFormat (void) override;
+  DlMuInfo ComputeDlMuInfo (void) override;
+  UlMuInfo ComputeUlMuInfo (void) override;
+
+  /**
+   * Check if it is possible to send a DL MU PPDU given the current
+   * time limits.
+   *
+   * \return DL_MU_TX if it is possible to send a DL MU PPDU, SU_TX if a SU PPDU
+   *         can be transmitted (e.g., there are no HE stations associated or sending
+   *         a DL MU PPDU is not possible and m_forceDlOfdma is false) or NO_TX otherwise
+   */
+  TxFormat TrySendingDlMuPpdu (void);
+
+  /**
+   * Assign an RU index to all the RUs allocated by the given TXVECTOR. Allocated
+   * RUs must all have the same size, except for allocated central 26-tone RUs.
+   *
+   * \param txVector the given TXVECTOR
+   */
+  void AssignRuIndices (WifiTxVector& txVector);
+
+  /**
+   * Get the set of RUs of the given type that can be allocated in a channel of
+   * the given width. The set is computed the first time it is requested.
+   *
+   * \param bw the channel width in MHz
+   * \param ruType the RU type
+   * \return the set of RUs of the given type
+   */
+  const std::vector<HeRu::RuSpec>& GetRusOfType (uint16_t bw, HeRu::RuType ruType);
+
+  /**
+   * Get the set of central 26-tone RUs that can be allocated in a channel of the
+   * given width along with RUs of the given type. The set is computed the first
+   * time it is requested.
+   *
+   * \param bw the channel width in MHz
+   * \param ruType the type of the RUs allocated along with the central 26-tone RUs
+   * \return the set of central 26-tone RUs
+   */
+  const std::vector<HeRu::RuSpec>& GetCentral26TonesRus (uint16_t bw, HeRu::RuType ruType);
+
+  /**
+   * Notify the scheduler that a station associated with the AP
+   *
+   * \param aid the AID of the station
+   * \param address the MAC address of the station
+   */
+  void NotifyStationAssociated (uint16_t aid, Mac48Address address);
+  /**
+   * Notify the scheduler that a station deassociated with the AP
+   *
+   * \param aid the AID of the station
+   * \param address the MAC address of the station
+   */
+  void NotifyStationDeassociated (uint16_t aid, Mac48Address address);
+
+  /**
+   * Notify the scheduler that an MPDU has been enqueued in an AC queue of the AP
+   *
+   * \param item the enqueued MPDU
+   */
+  void NotifyEnqueue (Ptr<const WifiMacQueueItem> item);
+  /**
+   * Notify the scheduler that an MPDU has been dequeued (or removed) from an AC
+   * queue of the AP
+   *
+   * \param item the dequeued MPDU
+   */
+  void NotifyDequeue (Ptr<const WifiMacQueueItem> item);
+
+  /// Per-station information
+  struct StaInfo
+  {
+    uint16_t aid;                                 //!< station's AID
+    Mac48Address address;                         //!< station's MAC Address
+    std::array<uint32_t, AC_BE_NQOS> nMpdus;      //!< number of queued MPDUs per AC
+    std::array<std::size_t, AC_BE_NQOS> backlogIndex; //!< position in the per-AC backlog
+    double rate;                                  //!< last known data rate (bps), 0 if unknown
+    double avgThroughput;                         //!< average throughput (bps) at lastUpdate
+    Time lastUpdate;                              //!< last time the average throughput was updated
+    uint64_t lastVisit;                           //!< ID of the last scheduling round visiting the station
+  };
+
+  /**
+   * Add the given station to the backlog of the given AC, if not already there.
+   *
+   * \param sta the given station
+   * \param ac the given AC
+   */
+  void AddToBacklog (StaInfo& sta, AcIndex ac);
+  /**
+   * Remove the given station from the backlog of the given AC, if it is there.
+   *
+   * \param sta the given station
+   * \param ac the given AC
+   */
+  void RemoveFromBacklog (StaInfo& sta, AcIndex ac);
+
+  /**
+   * \param sta the given station
+   * \return the average throughput of the given station at the current time
+   */
+  double GetAvgThroughput (const StaInfo& sta) const;
+
+  /**
+   * \param sta the given station
+   * \return the proportional fair metric of the given station
+   */
+  double GetPfMetric (const StaInfo& sta) const;
+
+  /**
+   * Information stored for candidate stations
+   */
+  typedef std::pair<StaInfo*, Ptr<const WifiMacQueueItem>> CandidateInfo;
+
+  /// Key of the cached RU sets (channel width, RU type)
+  typedef std::pair<uint16_t, HeRu::RuType> RuSetKey;
+
+  /// Value indicating that a station is not in the backlog of an AC
+  static constexpr std::size_t NOT_BACKLOGGED = std::numeric_limits<std::size_t>::max ();
+
+  uint8_t m_nStations;                                  //!< Number of stations/slots to fill
+  bool m_enableTxopSharing;                             //!< allow A-MPDUs of different TIDs in a DL MU PPDU
+  bool m_forceDlOfdma;                                  //!< return DL_OFDMA even if no DL MU PPDU was built
+  bool m_useCentral26TonesRus;                          //!< whether to allocate central 26-tone RUs
+  double m_rateExponent;                                //!< exponent of the data rate in the PF metric
+  double m_throughputExponent;                          //!< exponent of the average throughput in the PF metric
+  Time m_averagingTime;                                 //!< time constant of the throughput average
+  std::unordered_map<Mac48Address, StaInfo, WifiAddressHash> m_staInfo; //!< associated HE stations
+  std::array<std::vector<StaInfo*>, AC_BE_NQOS> m_backlog; //!< Per-AC stations with queued frames
+  std::vector<CandidateInfo> m_candidates;              //!< Candidate stations for MU TX
+  std::map<RuSetKey, std::vector<HeRu::RuSpec>> m_rus;  //!< cached sets of RUs of a given type
+  std::map<RuSetKey, std::vector<HeRu::RuSpec>> m_central26TonesRus; //!< cached sets of central 26-tone RUs
+  uint64_t m_round;                                     //!< ID of the current scheduling round
+  WifiTxParameters m_txParams;                          //!< TX parameters
+};
+
+} //namespace ns3
+
+#endif /* PF_MULTI_USER_SCHEDULER_H */
@@ -323,7 +323,7 @@ HtPhy::GetPayloadDuration (uint32_t size, const WifiTxVector& txVector, WifiPhyB
         NS_FATAL_ERROR ("Unknown MPDU type");
     }
 
-  Time payloadDuration = FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+  Time payloadDuration = GetSymbolsDuration (symbolDuration, numSymbols);
   if (mpdutype == NORMAL_MPDU || mpdutype == SINGLE_MPDU || mpdutype == LAST_MPDU_IN_AGGREGATE)
     {
       payloadDuration += GetSignalExtension (band);
@@ -331,6 +331,27 @@ HtPhy::GetPayloadDuration (uint32_t size, const WifiTxVector& txVector, WifiPhyB
   return payloadDuration;
 }
 
+bool
+HtPhy::GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                               TxDurationConstants& constants) const
+{
+  if (txVector.IsUlMu ())
+    {
+      // the duration of HE TB PPDUs is derived from the L-SIG length
+      return false;
+    }
+
+  //same computations as in GetPayloadDuration for the NORMAL_MPDU case
+  constants.preambleAndHeaderDuration = CalculatePhyPreambleAndHeaderDuration (txVector);
+  constants.symbolDuration = GetSymbolDuration (txVector);
+  constants.signalExtension = GetSignalExtension (band);
+  constants.numDataBitsPerSymbol = txVector.GetMode (staId).GetDataRate (txVector, staId)
+                                   * constants.symbolDuration.GetNanoSeconds () / 1e9;
+  constants.numServiceAndTailBits = GetNumberServiceBits () + 6.0 * GetNumberBccEncoders (txVector);
+  constants.stbc = txVector.IsStbc () ? 2 : 1;
+  return true;
+}
+
 uint8_t
 HtPhy::GetNumberBccEncoders (const WifiTxVector& txVector) const
 {
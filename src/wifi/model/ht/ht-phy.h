@@ -72,6 +72,8 @@ public:
   Time GetPayloadDuration (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, MpduType mpdutype,
                            bool incFlag, uint32_t &totalAmpduSize, double &totalAmpduNumSymbols,
                            uint16_t staId) const override;
+  bool GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                               TxDurationConstants& constants) const override;
   Ptr<WifiPpdu> BuildPpdu (const WifiConstPsduMap & psdus, const WifiTxVector& txVector, Time ppduDuration) override;
 
   /**
@@ -24,6 +24,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
+#include "ns3/memory-gauge.h"
 #include "interference-helper.h"
 #include "wifi-phy.h"
 #include "error-rate-model.h"
@@ -34,6 +35,9 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("InterferenceHelper");
 
+/// The memory used by the NiChanges of all the InterferenceHelper
+static MemoryGauge g_niChangesGauge ("wifi", "InterferenceHelper::NiChanges");
+
 /****************************************************************
  *       PHY event class
  ****************************************************************/
@@ -213,6 +217,7 @@ InterferenceHelper::RemoveBands(void)
   NS_LOG_FUNCTION (this);
   for (auto it : m_niChangesPerBand)
     {
+      g_niChangesGauge.Remove (it.second.size () * GetNiChangeBytes (), it.second.size ());
       it.second.clear ();
     }
   m_niChangesPerBand.clear();
@@ -294,6 +299,11 @@ InterferenceHelper::AppendEvent (Ptr<Event> event, bool isStartOfdmaRxing)
         {
           m_firstPowerPerBand.find (band)->second = previousPowerStart;
           // Always leave the first zero power noise event in the list
+          if (MemoryGauge::IsEnabled ())
+            {
+              int64_t erased = std::distance (++(niIt->second.begin ()), std::next (previousPowerPosition));
+              g_niChangesGauge.Remove (erased * GetNiChangeBytes (), erased);
+            }
           niIt->second.erase (++(niIt->second.begin ()), ++previousPowerPosition);
         }
       else if (isStartOfdmaRxing)
@@ -601,6 +611,7 @@ InterferenceHelper::EraseEvents (void)
 {
   for (auto niIt = m_niChangesPerBand.begin(); niIt != m_niChangesPerBand.end(); ++niIt)
     {
+      g_niChangesGauge.Remove (niIt->second.size () * GetNiChangeBytes (), niIt->second.size ());
       niIt->second.clear ();
       // Always have a zero power noise event in the list
       AddNiChangeEvent (Time (0), NiChange (0.0, 0), niIt);
@@ -628,9 +639,17 @@ InterferenceHelper::GetPreviousPosition (Time moment, NiChangesPerBand::iterator
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change, NiChangesPerBand::iterator niIt)
 {
+  g_niChangesGauge.Add (GetNiChangeBytes ());
   return niIt->second.insert (GetNextPosition (moment, niIt), std::make_pair (moment, change));
 }
 
+int64_t
+InterferenceHelper::GetNiChangeBytes (void)
+{
+  // a tree node holds the color and three links besides the value
+  return sizeof (NiChanges::value_type) + 4 * sizeof (void *);
+}
+
 void
 InterferenceHelper::NotifyRxStart ()
 {
@@ -455,6 +455,13 @@ private:
    * \returns the iterator of the new event
    */
   NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change, NiChangesPerBand::iterator niIt);
+  /**
+   * Estimate the memory used by an NiChange in the list, for the
+   * "wifi" MemoryGauge of the NiChanges
+   *
+   * \returns the number of bytes of the NiChange and of its tree node
+   */
+  static int64_t GetNiChangeBytes (void);
 };
 
 } //namespace ns3
@@ -253,7 +253,7 @@ OfdmPhy::GetPayloadDuration (uint32_t size, const WifiTxVector& txVector, WifiPh
   //is used is given in equation 19-32 of the IEEE 802.11-2016 standard.
   double numSymbols = lrint (ceil ((GetNumberServiceBits () + size * 8.0 + 6.0) / (numDataBitsPerSymbol)));
 
-  Time payloadDuration = FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+  Time payloadDuration = GetSymbolsDuration (symbolDuration, numSymbols);
   payloadDuration += GetSignalExtension (band);
   return payloadDuration;
 }
@@ -193,6 +193,13 @@ PhyEntity::CalculatePhyPreambleAndHeaderDuration (const WifiTxVector& txVector)
   return duration;
 }
 
+bool
+PhyEntity::GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                                   TxDurationConstants& constants) const
+{
+  return false;
+}
+
 WifiConstPsduMap
 PhyEntity::GetWifiConstPsduMap (Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector) const
 {
@@ -1067,6 +1074,17 @@ PhyEntity::GetTxMaskRejectionParams (void) const
   return m_wifiPhy->GetTxMaskRejectionParams ();
 }
 
+Time
+PhyEntity::GetSymbolsDuration (Time symbolDuration, double numSymbols)
+{
+  int64_t wholeSymbols = static_cast<int64_t> (numSymbols);
+  if (wholeSymbols == numSymbols)
+    {
+      return symbolDuration * wholeSymbols;
+    }
+  return FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+}
+
 Time
 PhyEntity::CalculateTxDuration (WifiConstPsduMap psduMap, const WifiTxVector& txVector, WifiPhyBand band) const
 {
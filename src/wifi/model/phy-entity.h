@@ -130,6 +130,24 @@ public:
     /* *NS_CHECK_STYLE_ON* */
   };
 
+  /**
+   * Quantities that only depend on the TXVECTOR (and not on the PSDU size)
+   * and that are needed to compute the TX duration of an OFDM-based PPDU.
+   * They allow to compute the duration of PPDUs of increasing size (e.g., while
+   * building an A-MPDU) without deriving them again from the TXVECTOR.
+   */
+  struct TxDurationConstants
+  {
+    /* *NS_CHECK_STYLE_OFF* */
+    Time preambleAndHeaderDuration {0}; //!< duration of the PHY preamble and header
+    Time symbolDuration {0};            //!< duration of a data OFDM symbol (including GI)
+    Time signalExtension {0};           //!< duration of the signal extension
+    double numDataBitsPerSymbol {0.0};  //!< number of data bits per OFDM symbol
+    double numServiceAndTailBits {0.0}; //!< number of SERVICE and tail bits
+    uint8_t stbc {1};                   //!< 2 if STBC is used, 1 otherwise
+    /* *NS_CHECK_STYLE_ON* */
+  };
+
   /**
    * A struct for both SNR and PER
    */
@@ -271,6 +289,36 @@ public:
                                    bool incFlag, uint32_t &totalAmpduSize, double &totalAmpduNumSymbols,
                                    uint16_t staId) const = 0;
 
+  /**
+   * Get the quantities that only depend on the TXVECTOR and that are needed to
+   * compute the TX duration of a PPDU of any size with WifiPhy::CalculateTxDuration.
+   * The default implementation returns false, meaning that the TX duration cannot
+   * be computed from such constants and WifiPhy::CalculateTxDuration (size, txVector,
+   * band, staId) has to be used instead.
+   *
+   * \param txVector the TXVECTOR used for the transmission
+   * \param band the frequency band
+   * \param staId the STA-ID of the PSDU (only used for MU PPDUs)
+   * \param [out] constants the quantities derived from the TXVECTOR
+   *
+   * \return true if the constants have been successfully set, false otherwise
+   */
+  virtual bool GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                                       TxDurationConstants& constants) const;
+
+  /**
+   * Get the duration of a number of OFDM symbols. A whole number of symbols
+   * is converted with integer arithmetic on the Time value, whereas a fractional
+   * one (e.g., for an MPDU that is not the last one in an A-MPDU) is truncated
+   * to the femtosecond.
+   *
+   * \param symbolDuration the duration of an OFDM symbol
+   * \param numSymbols the number of OFDM symbols
+   *
+   * \return the duration of the given number of OFDM symbols
+   */
+  static Time GetSymbolsDuration (Time symbolDuration, double numSymbols);
+
   /**
    * Get a WifiConstPsduMap from a PSDU and the TXVECTOR to use to send the PSDU.
    * The STA-ID value is properly determined based on whether the given PSDU has
@@ -35,6 +35,8 @@
  */
 
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -65,11 +67,30 @@ struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
   uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
 
   McsGroupData m_groupsTable;  //!< Table of groups with stats.
+  MinstrelHtRateStats m_rateStats; //!< Statistics of all the rates, indexed by global rate index.
   bool m_isHt;                 //!< If the station is HT capable.
 
   std::ofstream m_statsFile;   //!< File where statistics table is written.
 };
 
+void
+MinstrelHtRateStats::Reset (std::size_t nRates)
+{
+  supported.assign (nRates, 0);
+  txTimeSeconds.assign (nRates, 0);
+  numRateAttempt.assign (nRates, 0);
+  numRateSuccess.assign (nRates, 0);
+  prob.assign (nRates, 0);
+  ewmaProb.assign (nRates, 0);
+  ewmsdProb.assign (nRates, 0);
+  prevNumRateAttempt.assign (nRates, 0);
+  prevNumRateSuccess.assign (nRates, 0);
+  numSamplesSkipped.assign (nRates, 0);
+  successHist.assign (nRates, 0);
+  attemptHist.assign (nRates, 0);
+  throughput.assign (nRates, 0);
+}
+
 NS_OBJECT_ENSURE_REGISTERED (MinstrelHtWifiManager);
 
 TypeId
@@ -119,6 +140,13 @@ MinstrelHtWifiManager::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&MinstrelHtWifiManager::m_printStats),
                    MakeBooleanChecker ())
+    .AddAttribute ("StaggerStatisticsUpdates",
+                   "If true, the statistics updates of the remote stations are spread over the "
+                   "update interval (based on the station ID) instead of occurring at the same "
+                   "time for all the stations initialized at the same time",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&MinstrelHtWifiManager::m_staggerStatsUpdates),
+                   MakeBooleanChecker ())
     .AddTraceSource ("Rate",
                      "Traced value for rate changes (b/s)",
                      MakeTraceSourceAccessor (&MinstrelHtWifiManager::m_currentRate),
@@ -495,6 +523,13 @@ MinstrelHtWifiManager::CheckInit (MinstrelHtWifiRemoteStation *station)
           station->m_sampleTable = SampleRate (m_numRates, std::vector<uint8_t> (m_nSampleCol));
           InitSampleTable (station);
           RateInit (station);
+          if (m_staggerStatsUpdates)
+            {
+              // Spread the first statistics update of the stations over the update interval
+              // by using the fractional part of the golden ratio multiples of the station ID
+              double phase = std::fmod (station->m_state->m_staId * 0.6180339887498949, 1.0);
+              station->m_nextStatsUpdate = Simulator::Now () + m_updateStats * phase;
+            }
           station->m_initialized = true;
         }
     }
@@ -561,9 +596,7 @@ MinstrelHtWifiManager::DoReportDataFailed (WifiRemoteStation *st)
     }
   else if (station->m_longRetry < CountRetries (station))
     {
-      uint8_t rateId = GetRateId (station->m_txrate);
-      uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++; // Increment the attempts counter for the rate used.
+      station->m_rateStats.numRateAttempt[station->m_txrate]++; // Increment the attempts counter for the rate used.
       UpdateRate (station);
     }
 }
@@ -602,10 +635,8 @@ MinstrelHtWifiManager::DoReportDataOk (WifiRemoteStation *st, double ackSnr, Wif
     }
   else
     {
-      uint8_t rateId = GetRateId (station->m_txrate);
-      uint8_t groupId = GetGroupId (station->m_txrate);
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-      station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+      station->m_rateStats.numRateSuccess[station->m_txrate]++;
+      station->m_rateStats.numRateAttempt[station->m_txrate]++;
 
       UpdatePacketCounters (station, 1, 0);
 
@@ -699,10 +730,8 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus (WifiRemoteStation *st, uint16_t nS
 
   UpdatePacketCounters (station, nSuccessfulMpdus, nFailedMpdus);
 
-  uint8_t rateId = GetRateId (station->m_txrate);
-  uint8_t groupId = GetGroupId (station->m_txrate);
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt += nSuccessfulMpdus + nFailedMpdus;
+  station->m_rateStats.numRateSuccess[station->m_txrate] += nSuccessfulMpdus;
+  station->m_rateStats.numRateAttempt[station->m_txrate] += nSuccessfulMpdus + nFailedMpdus;
 
   if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries (station))
     {
@@ -1122,7 +1151,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
       uint8_t sampleRateId = GetRateId (sampleIdx);
 
       // If the rate selected is not supported, then don't sample.
-      if (station->m_groupsTable[sampleGroupId].m_supported && station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId].supported)
+      if (station->m_groupsTable[sampleGroupId].m_supported && station->m_rateStats.supported[sampleIdx])
         {
           /**
            * Sampling might add some overhead to the frame.
@@ -1131,13 +1160,13 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
            * Also do not sample if the probability is already higher than 95%
            * to avoid wasting airtime.
            */
-          MinstrelHtRateInfo sampleRateInfo = station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+          double sampleProb = station->m_rateStats.ewmaProb[sampleIdx];
 
           NS_LOG_DEBUG ("Use sample rate? MaxTpRate= " << station->m_maxTpRate << " CurrentRate= " << station->m_txrate <<
-                        " SampleRate= " << sampleIdx << " SampleProb= " << sampleRateInfo.ewmaProb);
+                        " SampleRate= " << sampleIdx << " SampleProb= " << sampleProb);
 
           if (sampleIdx != station->m_maxTpRate && sampleIdx != station->m_maxTpRate2
-              && sampleIdx != station->m_maxProbRate && sampleRateInfo.ewmaProb <= 95)
+              && sampleIdx != station->m_maxProbRate && sampleProb <= 95)
             {
 
               /**
@@ -1154,7 +1183,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               uint8_t maxTpStreams = m_minstrelGroups[maxTpGroupId].streams;
               uint8_t sampleStreams = m_minstrelGroups[sampleGroupId].streams;
 
-              Time sampleDuration = sampleRateInfo.perfectTxTime;
+              Time sampleDuration = station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId].perfectTxTime;
               Time maxTp2Duration = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].perfectTxTime;
               Time maxProbDuration = station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].perfectTxTime;
 
@@ -1176,7 +1205,7 @@ MinstrelHtWifiManager::FindRate (MinstrelHtWifiRemoteStation *station)
               else
                 {
                   station->m_numSamplesSlow++;
-                  if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                  if (station->m_rateStats.numSamplesSkipped[sampleIdx] >= 20 && station->m_numSamplesSlow <= 2)
                     {
                       /// Set flag that we are currently sampling.
                       station->m_isSampling = true;
@@ -1212,8 +1241,6 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   station->m_numSamplesSlow = 0;
   station->m_sampleCount = 0;
 
-  double tempProb;
-
   if (station->m_ampduPacketCount > 0)
     {
       uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1227,7 +1254,57 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
   station->m_maxTpRate2 = GetLowestIndex (station);
   station->m_maxProbRate = GetLowestIndex (station);
 
-  /// Update throughput and EWMA for each rate inside each group.
+  /**
+   * Update the probability, EWMA, EWMSD and throughput of all the rates. This
+   * is a single branch-free pass over the arrays of statistics, where only the
+   * entries of supported rates that have been attempted are actually updated.
+   */
+  MinstrelHtRateStats &stats = station->m_rateStats;
+  const double ewmaLevel = m_ewmaLevel;
+  const std::size_t nRates = stats.supported.size ();
+  for (std::size_t k = 0; k < nRates; k++)
+    {
+      const bool supported = stats.supported[k];
+      const uint32_t attempts = stats.numRateAttempt[k];
+      const uint32_t successes = stats.numRateSuccess[k];
+      const bool update = supported && attempts > 0;
+
+      /**
+       * Calculate the probability of success.
+       * Assume probability scales from 0 to 100. The (integer) quotient is
+       * obtained through a floating point division, which is exact in this range.
+       */
+      const double currProb = std::floor (static_cast<double> (100 * successes) / (attempts > 0 ? attempts : 1));
+      const bool firstUpdate = stats.successHist[k] == 0;
+      const double oldEwma = stats.ewmaProb[k];
+      const double newEwma = firstUpdate ? currProb : (currProb * (100 - ewmaLevel) + oldEwma * ewmaLevel) / 100;
+      const double newEwmsd = firstUpdate ? stats.ewmsdProb[k] : CalculateEwmsd (stats.ewmsdProb[k], currProb, oldEwma, ewmaLevel);
+      /**
+       * Do not account throughput if probability of success is below 10% and limit the
+       * probability value to 90% (see CalculateThroughput). Unsupported rates have a
+       * null TX time, but their throughput is not updated.
+       */
+      const double newThroughput = newEwma < 10 ? 0 : std::min (newEwma, 90.0) / stats.txTimeSeconds[k];
+
+      stats.prob[k] = update ? currProb : stats.prob[k];
+      stats.ewmaProb[k] = update ? newEwma : oldEwma;
+      stats.ewmsdProb[k] = update ? newEwmsd : stats.ewmsdProb[k];
+      stats.throughput[k] = update ? newThroughput : stats.throughput[k];
+      stats.successHist[k] += update ? successes : 0;
+      stats.attemptHist[k] += update ? attempts : 0;
+      stats.numSamplesSkipped[k] = update ? 0 : stats.numSamplesSkipped[k] + (supported ? 1 : 0);
+
+      /// Bookkeeping.
+      stats.prevNumRateSuccess[k] = supported ? successes : stats.prevNumRateSuccess[k];
+      stats.prevNumRateAttempt[k] = supported ? attempts : stats.prevNumRateAttempt[k];
+      stats.numRateSuccess[k] = 0;
+      stats.numRateAttempt[k] = 0;
+    }
+
+  /**
+   * Select the best rates. Rates are visited in increasing order of index, hence
+   * the best rates found so far always refer to rates whose statistics are up to date.
+   */
   for (uint8_t j = 0; j < m_numGroups; j++)
     {
       if (station->m_groupsTable[j].m_supported)
@@ -1241,63 +1318,20 @@ MinstrelHtWifiManager::UpdateStats (MinstrelHtWifiRemoteStation *station)
 
           for (uint8_t i = 0; i < m_numRates; i++)
             {
-              if (station->m_groupsTable[j].m_ratesTable[i].supported)
+              uint16_t index = GetIndex (j, i);
+              if (stats.supported[index])
                 {
                   station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
 
                   NS_LOG_DEBUG (+i << " " << GetMcsSupported (station, station->m_groupsTable[j].m_ratesTable[i].mcsIndex) <<
-                                "\t attempt=" << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt <<
-                                "\t success=" << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                  /// If we've attempted something.
-                  if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                      /**
-                       * Calculate the probability of success.
-                       * Assume probability scales from 0 to 100.
-                       */
-                      tempProb = (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) / station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                      /// Bookkeeping.
-                      station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                      if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                      else
-                        {
-                          station->m_groupsTable[j].m_ratesTable[i].ewmsdProb = CalculateEwmsd (station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                                                                                tempProb, station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                                                                                m_ewmaLevel);
-                          /// EWMA probability
-                          tempProb = (tempProb * (100 - m_ewmaLevel) + station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel)  / 100;
-                          station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-
-                      station->m_groupsTable[j].m_ratesTable[i].throughput = CalculateThroughput (station, j, i, tempProb);
-
-                      station->m_groupsTable[j].m_ratesTable[i].successHist += station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                      station->m_groupsTable[j].m_ratesTable[i].attemptHist += station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                  else
-                    {
-                      station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
-
-                  /// Bookkeeping.
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess = station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                  station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt = station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                  station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
+                                "\t attempt=" << stats.prevNumRateAttempt[index] <<
+                                "\t success=" << stats.prevNumRateSuccess[index]);
 
-                  if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
+                  if (stats.throughput[index] != 0)
                     {
-                      SetBestStationThRates (station, GetIndex (j, i));
-                      SetBestProbabilityRate (station, GetIndex (j, i));
+                      SetBestStationThRates (station, index);
+                      SetBestProbabilityRate (station, index);
                     }
-
                 }
             }
         }
@@ -1351,51 +1385,29 @@ MinstrelHtWifiManager::CalculateThroughput (MinstrelHtWifiRemoteStation *station
 void
 MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *station, uint16_t index)
 {
-  GroupInfo *group;
-  MinstrelHtRateInfo rate;
-  uint8_t tmpGroupId, tmpRateId;
-  double tmpTh, tmpProb;
-  uint8_t groupId, rateId;
-  double currentTh;
-  // maximum group probability (GP) variables
-  uint8_t maxGPGroupId, maxGPRateId;
-  double maxGPTh;
-
-  groupId = GetGroupId (index);
-  rateId = GetRateId (index);
-  group = &station->m_groupsTable[groupId];
-  rate = group->m_ratesTable[rateId];
-
-  tmpGroupId = GetGroupId (station->m_maxProbRate);
-  tmpRateId = GetRateId (station->m_maxProbRate);
-  tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].ewmaProb;
-  tmpTh =  station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].throughput;
-
-  if (rate.ewmaProb > 75)
-    {
-      currentTh = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
-      if (currentTh > tmpTh)
+  const MinstrelHtRateStats &stats = station->m_rateStats;
+  GroupInfo *group = &station->m_groupsTable[GetGroupId (index)];
+  double prob = stats.ewmaProb[index];
+
+  if (prob > 75)
+    {
+      double currentTh = stats.throughput[index];
+      if (currentTh > stats.throughput[station->m_maxProbRate])
         {
           station->m_maxProbRate = index;
         }
-
-      maxGPGroupId = GetGroupId (group->m_maxProbRate);
-      maxGPRateId = GetRateId (group->m_maxProbRate);
-      maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable[maxGPRateId].throughput;
-
-      if (currentTh > maxGPTh)
+      if (currentTh > stats.throughput[group->m_maxProbRate])
         {
           group->m_maxProbRate = index;
         }
     }
   else
     {
-      if (rate.ewmaProb > tmpProb)
+      if (prob > stats.ewmaProb[station->m_maxProbRate])
         {
           station->m_maxProbRate = index;
         }
-      maxGPRateId = GetRateId (group->m_maxProbRate);
-      if (rate.ewmaProb > group->m_ratesTable[maxGPRateId].ewmaProb)
+      if (prob > stats.ewmaProb[group->m_maxProbRate])
         {
           group->m_maxProbRate = index;
         }
@@ -1412,57 +1424,33 @@ MinstrelHtWifiManager::SetBestProbabilityRate (MinstrelHtWifiRemoteStation *stat
 void
 MinstrelHtWifiManager::SetBestStationThRates (MinstrelHtWifiRemoteStation *station, uint16_t index)
 {
-  uint8_t groupId, rateId;
-  double th, prob;
-  uint8_t maxTpGroupId, maxTpRateId;
-  uint8_t maxTp2GroupId, maxTp2RateId;
-  double maxTpTh, maxTpProb;
-  double maxTp2Th, maxTp2Prob;
-
-  groupId = GetGroupId (index);
-  rateId = GetRateId (index);
-  prob = station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb;
-  th = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
-
-  maxTpGroupId = GetGroupId (station->m_maxTpRate);
-  maxTpRateId = GetRateId (station->m_maxTpRate);
-  maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].ewmaProb;
-  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
-
-  maxTp2GroupId = GetGroupId (station->m_maxTpRate2);
-  maxTp2RateId = GetRateId (station->m_maxTpRate2);
-  maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].ewmaProb;
-  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
-
-  if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
+  const MinstrelHtRateStats &stats = station->m_rateStats;
+  double th = stats.throughput[index];
+  double prob = stats.ewmaProb[index];
+
+  if (th > stats.throughput[station->m_maxTpRate]
+      || (th == stats.throughput[station->m_maxTpRate] && prob > stats.ewmaProb[station->m_maxTpRate]))
     {
       station->m_maxTpRate2 = station->m_maxTpRate;
       station->m_maxTpRate = index;
     }
-  else if (th > maxTp2Th || (th == maxTp2Th && prob > maxTp2Prob))
+  else if (th > stats.throughput[station->m_maxTpRate2]
+           || (th == stats.throughput[station->m_maxTpRate2] && prob > stats.ewmaProb[station->m_maxTpRate2]))
     {
       station->m_maxTpRate2 = index;
     }
 
   //Find best rates per group
 
-  GroupInfo *group = &station->m_groupsTable[groupId];
-  maxTpGroupId = GetGroupId (group->m_maxTpRate);
-  maxTpRateId = GetRateId (group->m_maxTpRate);
-  maxTpProb = group->m_ratesTable[maxTpRateId].ewmaProb;
-  maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
-
-  maxTp2GroupId = GetGroupId (group->m_maxTpRate2);
-  maxTp2RateId = GetRateId (group->m_maxTpRate2);
-  maxTp2Prob = group->m_ratesTable[maxTp2RateId].ewmaProb;
-  maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
-
-  if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
+  GroupInfo *group = &station->m_groupsTable[GetGroupId (index)];
+  if (th > stats.throughput[group->m_maxTpRate]
+      || (th == stats.throughput[group->m_maxTpRate] && prob > stats.ewmaProb[group->m_maxTpRate]))
     {
       group->m_maxTpRate2 = group->m_maxTpRate;
       group->m_maxTpRate = index;
     }
-  else if (th > maxTp2Th || (th == maxTp2Th && prob > maxTp2Prob))
+  else if (th > stats.throughput[group->m_maxTpRate2]
+           || (th == stats.throughput[group->m_maxTpRate2] && prob > stats.ewmaProb[group->m_maxTpRate2]))
     {
       group->m_maxTpRate2 = index;
     }
@@ -1474,6 +1462,7 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
   NS_LOG_FUNCTION (this << station);
 
   station->m_groupsTable = McsGroupData (m_numGroups);
+  station->m_rateStats.Reset (m_numGroups * m_numRates);
 
   /**
   * Initialize groups supported by the receiver.
@@ -1540,10 +1529,6 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
           station->m_groupsTable[groupId].m_index = 0;
 
           station->m_groupsTable[groupId].m_ratesTable = MinstrelHtRate (m_numRates); ///Create the rate list for the group.
-          for (uint8_t i = 0; i < m_numRates; i++)
-            {
-              station->m_groupsTable[groupId].m_ratesTable[i].supported = false;
-            }
 
           // Initialize all modes supported by the remote station that belong to the current group.
           for (uint8_t i = 0; i < station->m_nModes; i++)
@@ -1571,19 +1556,11 @@ MinstrelHtWifiManager::RateInit (MinstrelHtWifiRemoteStation *station)
                 {
                   NS_LOG_DEBUG ("Mode " << +i << ": " << mode);
 
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].supported = true;
                   station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex = i; ///Mapping between rateId and operationalMcsSet
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].prob = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
-                  station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
                   station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime = GetFirstMpduTxTime (groupId, GetMcsSupported (station, i));
+                  station->m_rateStats.supported[GetIndex (groupId, rateId)] = true;
+                  station->m_rateStats.txTimeSeconds[GetIndex (groupId, rateId)] =
+                    station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime.GetSeconds ();
                   station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
                   station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
                   CalculateRetransmits (station, groupId, rateId);
@@ -1624,7 +1601,7 @@ MinstrelHtWifiManager::CalculateRetransmits (MinstrelHtWifiRemoteStation *statio
   Time slotTime = GetPhy ()->GetSlot ();
   Time ackTime = GetPhy ()->GetSifs () + GetPhy ()->GetBlockAckTxTime ();
 
-  if (station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb < 1)
+  if (station->m_rateStats.ewmaProb[GetIndex (groupId, rateId)] < 1)
     {
       station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 1;
     }
@@ -1738,7 +1715,7 @@ MinstrelHtWifiManager::StatsDump (MinstrelHtWifiRemoteStation *station, uint8_t
   Time txTime;
   for (uint8_t i = 0; i < numRates; i++)
     {
-      if (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[i].supported)
+      if (station->m_groupsTable[groupId].m_supported && station->m_rateStats.supported[GetIndex (groupId, i)])
         {
           of << group.type << " " << group.chWidth << "   " << group.gi << "  " << +group.streams << "   ";
 
@@ -1788,15 +1765,15 @@ MinstrelHtWifiManager::StatsDump (MinstrelHtWifiRemoteStation *station, uint8_t
           of << std::setw (6) << txTime.GetMicroSeconds () << "  ";
 
           of << std::setw (7) << CalculateThroughput (station, groupId, i, 100) / 100 << "   " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].throughput / 100 << "   " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmaProb << "  " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb << "  " <<
-            std::setw (7) << station->m_groupsTable[groupId].m_ratesTable[i].prob << "  " <<
+            std::setw (7) << station->m_rateStats.throughput[GetIndex (groupId, i)] / 100 << "   " <<
+            std::setw (7) << station->m_rateStats.ewmaProb[GetIndex (groupId, i)] << "  " <<
+            std::setw (7) << station->m_rateStats.ewmsdProb[GetIndex (groupId, i)] << "  " <<
+            std::setw (7) << station->m_rateStats.prob[GetIndex (groupId, i)] << "  " <<
             std::setw (2) << station->m_groupsTable[groupId].m_ratesTable[i].retryCount << "   " <<
-            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateSuccess << "  " <<
-            std::setw (3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateAttempt << "   " <<
-            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable[i].successHist << "   " <<
-            std::setw (9) << station->m_groupsTable[groupId].m_ratesTable[i].attemptHist << "\n";
+            std::setw (3) << station->m_rateStats.prevNumRateSuccess[GetIndex (groupId, i)] << "  " <<
+            std::setw (3) << station->m_rateStats.prevNumRateAttempt[GetIndex (groupId, i)] << "   " <<
+            std::setw (9) << station->m_rateStats.successHist[GetIndex (groupId, i)] << "   " <<
+            std::setw (9) << station->m_rateStats.attemptHist[GetIndex (groupId, i)] << "\n";
         }
     }
 }
@@ -1915,11 +1892,11 @@ MinstrelHtWifiManager::GetLowestIndex (MinstrelHtWifiRemoteStation *station)
     {
       groupId++;
     }
-  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+  while (rateId < m_numRates && !station->m_rateStats.supported[GetIndex (groupId, rateId)])
     {
       rateId++;
     }
-  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_rateStats.supported[GetIndex (groupId, rateId)]);
   return GetIndex (groupId, rateId);
 }
 
@@ -1929,11 +1906,11 @@ MinstrelHtWifiManager::GetLowestIndex (MinstrelHtWifiRemoteStation *station, uin
   NS_LOG_FUNCTION (this << station << +groupId);
 
   uint8_t rateId = 0;
-  while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+  while (rateId < m_numRates && !station->m_rateStats.supported[GetIndex (groupId, rateId)])
     {
       rateId++;
     }
-  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+  NS_ASSERT (station->m_groupsTable[groupId].m_supported && station->m_rateStats.supported[GetIndex (groupId, rateId)]);
   return GetIndex (groupId, rateId);
 }
 
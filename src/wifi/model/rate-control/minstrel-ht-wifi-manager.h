@@ -97,7 +97,8 @@ typedef std::vector<McsGroup> MinstrelMcsGroups;
 
 struct MinstrelHtWifiRemoteStation;
 /**
- * A struct to contain all statistics information related to a data rate.
+ * A struct to contain the information related to a data rate that is not
+ * updated at every statistics update (see MinstrelHtRateStats).
  */
 struct MinstrelHtRateInfo
 {
@@ -106,27 +107,46 @@ struct MinstrelHtRateInfo
    * Given a bit rate and a packet length n bytes.
    */
   Time perfectTxTime;
-  bool supported;               //!< If the rate is supported.
   uint8_t mcsIndex;             //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
   uint32_t retryCount;          //!< Retry limit.
   uint32_t adjustedRetryCount;  //!< Adjust the retry limit for this rate.
-  uint32_t numRateAttempt;      //!< Number of transmission attempts so far.
-  uint32_t numRateSuccess;      //!< Number of successful frames transmitted so far.
-  double prob;                  //!< Current probability within last time interval. (# frame success )/(# total frames)
   bool retryUpdated;            //!< If number of retries was updated already.
+};
+
+/**
+ * A struct to contain all statistics information related to the data rates
+ * of a station. Statistics are stored as a structure of arrays, each indexed
+ * by the global index of a rate (see MinstrelHtWifiManager::GetIndex), so that
+ * the periodic update of the statistics of all the rates is a single pass
+ * over contiguous arrays. Entries of unsupported rates are left untouched.
+ */
+struct MinstrelHtRateStats
+{
+  /**
+   * Resize all the arrays to the given number of rates and reset all the statistics.
+   *
+   * \param nRates the total number of rates (groups times rates per group)
+   */
+  void Reset (std::size_t nRates);
+
+  std::vector<uint8_t> supported;           //!< If the rate is supported (and belongs to a supported group).
+  std::vector<double> txTimeSeconds;        //!< Perfect transmission time (in seconds) of the rate.
+  std::vector<uint32_t> numRateAttempt;     //!< Number of transmission attempts so far.
+  std::vector<uint32_t> numRateSuccess;     //!< Number of successful frames transmitted so far.
+  std::vector<double> prob;                 //!< Current probability within last time interval. (# frame success )/(# total frames)
   /**
    * Exponential weighted moving average of probability.
    * EWMA calculation:
    * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
    */
-  double ewmaProb;
-  double ewmsdProb;             //!< Exponential weighted moving standard deviation of probability.
-  uint32_t prevNumRateAttempt;  //!< Number of transmission attempts with previous rate.
-  uint32_t prevNumRateSuccess;  //!< Number of successful frames transmitted with previous rate.
-  uint32_t numSamplesSkipped;   //!< Number of times this rate statistics were not updated because no attempts have been made.
-  uint64_t successHist;         //!< Aggregate of all transmission successes.
-  uint64_t attemptHist;         //!< Aggregate of all transmission attempts.
-  double throughput;            //!< Throughput of this rate (in packets per second).
+  std::vector<double> ewmaProb;
+  std::vector<double> ewmsdProb;            //!< Exponential weighted moving standard deviation of probability.
+  std::vector<uint32_t> prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
+  std::vector<uint32_t> prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
+  std::vector<uint32_t> numSamplesSkipped;  //!< Number of times this rate statistics were not updated because no attempts have been made.
+  std::vector<uint64_t> successHist;        //!< Aggregate of all transmission successes.
+  std::vector<uint64_t> attemptHist;        //!< Aggregate of all transmission attempts.
+  std::vector<double> throughput;           //!< Throughput of this rate (in packets per second).
 };
 
 /**
@@ -609,6 +629,7 @@ private:
   uint8_t m_numRates;            //!< Number of rates per group Minstrel should consider.
   bool m_useLatestAmendmentOnly; //!< Flag if only the latest supported amendment by both peers should be used.
   bool m_printStats;             //!< If statistics table should be printed.
+  bool m_staggerStatsUpdates;    //!< If the statistics updates of the stations should be spread over the update interval.
 
   MinstrelMcsGroups m_minstrelGroups;                 //!< Global array for groups information.
 
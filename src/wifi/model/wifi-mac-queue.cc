@@ -22,6 +22,7 @@
  */
 
 #include "ns3/simulator.h"
+#include "ns3/memory-gauge.h"
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
 #include <functional>
@@ -33,6 +34,12 @@ NS_LOG_COMPONENT_DEFINE ("WifiMacQueue");
 NS_OBJECT_ENSURE_REGISTERED (WifiMacQueue);
 NS_OBJECT_TEMPLATE_CLASS_DEFINE (Queue, WifiMacQueueItem);
 
+/// The memory used by the MPDUs queued in all the WifiMacQueue
+static MemoryGauge g_wifiMacQueueGauge ("wifi", "WifiMacQueue");
+
+/// The memory used by a queued item besides its frame: the item and its list node
+static const int64_t g_queueItemOverhead = sizeof (WifiMacQueueItem) + 3 * sizeof (void *);
+
 TypeId
 WifiMacQueue::GetTypeId (void)
 {
@@ -71,6 +78,8 @@ WifiMacQueue::WifiMacQueue (AcIndex ac)
 WifiMacQueue::~WifiMacQueue ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  // the items are released without going through DoRemove
+  g_wifiMacQueueGauge.Remove (GetNBytes () + GetNPackets () * g_queueItemOverhead, GetNPackets ());
   m_nQueuedPackets.clear ();
   m_nQueuedBytes.clear ();
 }
@@ -515,6 +524,7 @@ WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
           m_nQueuedPackets[addressTidPair]++;
           m_nQueuedBytes[addressTidPair] += item->GetSize ();
         }
+      g_wifiMacQueueGauge.Add (item->GetSize () + g_queueItemOverhead);
       // set item's information about its position in the queue
       item->m_queueAc = m_ac;
       item->m_queueIt = ret;
@@ -551,6 +561,7 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
     {
       NS_ASSERT (item->IsQueued ());
       item->m_queueAc = AC_UNDEF;
+      g_wifiMacQueueGauge.Remove (item->GetSize () + g_queueItemOverhead);
     }
 
   return item;
@@ -576,6 +587,7 @@ WifiMacQueue::DoRemove (ConstIterator pos)
     {
       NS_ASSERT (item->IsQueued ());
       item->m_queueAc = AC_UNDEF;
+      g_wifiMacQueueGauge.Remove (item->GetSize () + g_queueItemOverhead);
     }
 
   return item;
@@ -293,6 +293,8 @@ const std::set<FrequencyChannelInfo> WifiPhy::m_frequencyChannels =
 
 std::map<WifiModulationClass, Ptr<PhyEntity> > WifiPhy::m_staticPhyEntities; //will be filled by g_constructor_XXX
 
+thread_local WifiTxDurationCache WifiPhy::m_txDurationCache (1024);
+
 TypeId
 WifiPhy::GetTypeId (void)
 {
@@ -1609,9 +1611,15 @@ WifiPhy::CalculatePhyPreambleAndHeaderDuration (const WifiTxVector& txVector)
 Time
 WifiPhy::CalculateTxDuration (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId)
 {
-  Time duration = CalculatePhyPreambleAndHeaderDuration (txVector)
+  Time duration;
+  if (m_txDurationCache.Lookup (size, txVector, band, duration))
+    {
+      return duration;
+    }
+  duration = CalculatePhyPreambleAndHeaderDuration (txVector)
     + GetPayloadDuration (size, txVector, band, NORMAL_MPDU, staId);
   NS_ASSERT (duration.IsStrictlyPositive ());
+  m_txDurationCache.Insert (size, txVector, band, duration);
   return duration;
 }
 
@@ -1627,6 +1635,32 @@ WifiPhy::CalculateTxDuration (WifiConstPsduMap psduMap, const WifiTxVector& txVe
   return GetStaticPhyEntity (txVector.GetModulationClass ())->CalculateTxDuration (psduMap, txVector, band);
 }
 
+Time
+WifiPhy::CalculateTxDuration (uint32_t size, const PhyEntity::TxDurationConstants& constants)
+{
+  //same computations as in HtPhy::GetPayloadDuration for the NORMAL_MPDU case
+  double numSymbols = lrint (constants.stbc * ceil ((size * 8.0 + constants.numServiceAndTailBits)
+                                                    / (constants.stbc * constants.numDataBitsPerSymbol)));
+  Time duration = constants.preambleAndHeaderDuration
+    + PhyEntity::GetSymbolsDuration (constants.symbolDuration, numSymbols)
+    + constants.signalExtension;
+  NS_ASSERT (duration.IsStrictlyPositive ());
+  return duration;
+}
+
+WifiTxDurationCache&
+WifiPhy::GetTxDurationCache (void)
+{
+  return m_txDurationCache;
+}
+
+bool
+WifiPhy::GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                                 PhyEntity::TxDurationConstants& constants)
+{
+  return GetStaticPhyEntity (txVector.GetModulationClass ())->GetTxDurationConstants (txVector, band, staId, constants);
+}
+
 uint32_t
 WifiPhy::GetMaxPsduSize (WifiModulationClass modulation)
 {
@@ -1634,7 +1668,7 @@ WifiPhy::GetMaxPsduSize (WifiModulationClass modulation)
 }
 
 void
-WifiPhy::NotifyTxBegin (WifiConstPsduMap psdus, double txPowerW)
+WifiPhy::NotifyTxBegin (const WifiConstPsduMap& psdus, double txPowerW)
 {
   if (!m_phyTxBeginTrace.IsEmpty ())
     {
@@ -1712,8 +1746,8 @@ WifiPhy::NotifyRxDrop (Ptr<const WifiPsdu> psdu, WifiPhyRxfailureReason reason)
 }
 
 void
-WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector,
-                               SignalNoiseDbm signalNoise, std::vector<bool> statusPerMpdu, uint16_t staId)
+WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, const WifiTxVector& txVector,
+                               const SignalNoiseDbm& signalNoise, const std::vector<bool>& statusPerMpdu, uint16_t staId)
 {
   MpduInfo aMpdu;
   if (psdu->IsAggregate ())
@@ -1749,7 +1783,7 @@ WifiPhy::NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz
 }
 
 void
-WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, WifiTxVector txVector, uint16_t staId)
+WifiPhy::NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu, uint16_t channelFreqMhz, const WifiTxVector& txVector, uint16_t staId)
 {
   MpduInfo aMpdu;
   if (psdu->IsAggregate ())
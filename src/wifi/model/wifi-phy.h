@@ -28,6 +28,7 @@
 #include "wifi-phy-state-helper.h"
 #include "phy-entity.h"
 #include "wifi-phy-operating-channel.h"
+#include "wifi-tx-duration-cache.h"
 
 namespace ns3 {
 
@@ -256,6 +257,42 @@ public:
    * \return the total amount of time this PHY will stay busy for the transmission of the PPDU
    */
   static Time CalculateTxDuration (WifiConstPsduMap psduMap, const WifiTxVector& txVector, WifiPhyBand band);
+  /**
+   * This function returns the same value as CalculateTxDuration (size, txVector,
+   * band, staId), where the quantities that only depend on txVector, band and
+   * staId are provided by the given constants, which must have been obtained
+   * by calling GetTxDurationConstants. This allows to avoid deriving such
+   * quantities again when computing the TX duration of PPDUs of increasing size
+   * that are transmitted with the same TXVECTOR (e.g., while building an A-MPDU).
+   *
+   * \param size the number of bytes in the packet to send
+   * \param constants the quantities derived from the TXVECTOR
+   *
+   * \return the total amount of time this PHY will stay busy for the transmission of these bytes.
+   */
+  static Time CalculateTxDuration (uint32_t size, const PhyEntity::TxDurationConstants& constants);
+  /**
+   * \param txVector the TXVECTOR used for the transmission
+   * \param band the frequency band being used
+   * \param staId the STA-ID of the recipient (only used for MU)
+   * \param [out] constants the quantities derived from the TXVECTOR
+   *
+   * \return true if the TX duration of PPDUs transmitted with the given TXVECTOR
+   *         can be computed by passing the returned constants to CalculateTxDuration
+   */
+  static bool GetTxDurationConstants (const WifiTxVector& txVector, WifiPhyBand band, uint16_t staId,
+                                      PhyEntity::TxDurationConstants& constants);
+  /**
+   * Get the cache storing the TX durations computed by CalculateTxDuration.
+   * The cache is shared by all the PHYs running on the calling thread (each
+   * thread of the parallel simulators has its own cache). The cached values
+   * never become stale, because the key (PSDU size, TXVECTOR and band) fully
+   * determines the TX duration. The cache can be resized (or disabled, by
+   * setting a null capacity) through the returned reference.
+   *
+   * \return a reference to the TX duration cache
+   */
+  static WifiTxDurationCache& GetTxDurationCache (void);
 
   /**
    * \param txVector the transmission parameters used for this packet
@@ -548,7 +585,7 @@ public:
    * \param psdus the PSDUs being transmitted (only one unless DL MU transmission)
    * \param txPowerW the transmit power in Watts
    */
-  void NotifyTxBegin (WifiConstPsduMap psdus, double txPowerW);
+  void NotifyTxBegin (const WifiConstPsduMap& psdus, double txPowerW);
   /**
    * Public method used to fire a PhyTxEnd trace.
    * Implemented for encapsulation purposes.
@@ -609,9 +646,9 @@ public:
    */
   void NotifyMonitorSniffRx (Ptr<const WifiPsdu> psdu,
                              uint16_t channelFreqMhz,
-                             WifiTxVector txVector,
-                             SignalNoiseDbm signalNoise,
-                             std::vector<bool> statusPerMpdu,
+                             const WifiTxVector& txVector,
+                             const SignalNoiseDbm& signalNoise,
+                             const std::vector<bool>& statusPerMpdu,
                              uint16_t staId = SU_STA_ID);
 
   /**
@@ -656,7 +693,7 @@ public:
    */
   void NotifyMonitorSniffTx (Ptr<const WifiPsdu> psdu,
                              uint16_t channelFreqMhz,
-                             WifiTxVector txVector,
+                             const WifiTxVector& txVector,
                              uint16_t staId = SU_STA_ID);
 
   /**
@@ -1383,6 +1420,8 @@ private:
    */
   static std::map<WifiModulationClass, Ptr<PhyEntity> > m_staticPhyEntities;
 
+  static thread_local WifiTxDurationCache m_txDurationCache; //!< TX durations computed by CalculateTxDuration, per thread
+
   WifiPhyStandard m_standard;               //!< WifiPhyStandard
   WifiPhyBand m_band;                       //!< WifiPhyBand
   uint16_t m_initialFrequency;              //!< Store frequency until initialization (MHz)
@@ -124,6 +124,7 @@ WifiRemoteStationManager::WifiRemoteStationManager ()
     m_shortSlotTimeEnabled (false)
 {
   NS_LOG_FUNCTION (this);
+  m_stationIdCache.fill ({Mac48Address (), INVALID_STA_ID});
 }
 
 WifiRemoteStationManager::~WifiRemoteStationManager ()
@@ -1218,30 +1219,65 @@ WifiRemoteStationManager::GetInfo (Mac48Address address)
 double
 WifiRemoteStationManager::GetMostRecentRssi (Mac48Address address) const
 {
-  auto stationIt = m_stations.find (address);
-  NS_ASSERT_MSG (stationIt != m_stations.end(), "Address: " << address << " not found");
-  auto station = stationIt->second;
+  auto idIt = m_stationIds.find (address);
+  NS_ASSERT_MSG (idIt != m_stationIds.end () && m_stations[idIt->second] != nullptr,
+                 "Address: " << address << " not found");
+  auto station = m_stations[idIt->second];
   auto rssi = station->m_rssiAndUpdateTimePair.first;
   auto ts = station->m_rssiAndUpdateTimePair.second;
   NS_ASSERT_MSG (ts.IsStrictlyPositive(), "address: " << address << " ts:" << ts);
   return rssi;
 }
 
+uint32_t
+WifiRemoteStationManager::GetStationId (Mac48Address address) const
+{
+  uint8_t buffer[6];
+  address.CopyTo (buffer);
+  StationIdCacheEntry& entry = m_stationIdCache[buffer[4] ^ buffer[5]];
+
+  if (entry.staId != INVALID_STA_ID && entry.address == address)
+    {
+      return entry.staId;
+    }
+
+  auto idIt = m_stationIds.find (address);
+  uint32_t staId;
+
+  if (idIt != m_stationIds.end ())
+    {
+      staId = idIt->second;
+    }
+  else
+    {
+      staId = static_cast<uint32_t> (m_states.size ());
+      NS_ASSERT (staId != INVALID_STA_ID);
+      WifiRemoteStationManager* self = const_cast<WifiRemoteStationManager *> (this);
+      self->m_stationIds.insert ({address, staId});
+      self->m_states.push_back (nullptr);
+      self->m_stations.push_back (nullptr);
+    }
+
+  entry = {address, staId};
+  return staId;
+}
+
 WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  auto stateIt = m_states.find (address);
+  uint32_t staId = GetStationId (address);
 
-  if (stateIt != m_states.end ())
+  if (m_states[staId] != nullptr)
     {
       NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
-      return stateIt->second;
+      return m_states[staId];
     }
 
   WifiRemoteStationState *state = new WifiRemoteStationState ();
   state->m_state = WifiRemoteStationState::BRAND_NEW;
   state->m_address = address;
+  state->m_staId = staId;
   state->m_aid = 0;
   state->m_operationalRateSet.push_back (GetDefaultMode ());
   state->m_operationalMcsSet.push_back (GetDefaultMcs ());
@@ -1256,7 +1292,7 @@ WifiRemoteStationManager::LookupState (Mac48Address address) const
   state->m_ness = 0;
   state->m_aggregation = false;
   state->m_qosSupported = false;
-  const_cast<WifiRemoteStationManager *> (this)->m_states.insert ({address, state});
+  const_cast<WifiRemoteStationManager *> (this)->m_states[staId] = state;
   NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning new state");
   return state;
 }
@@ -1265,19 +1301,17 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  auto stationIt = m_stations.find (address);
+  WifiRemoteStationState *state = LookupState (address);
 
-  if (stationIt != m_stations.end ())
+  if (m_stations[state->m_staId] != nullptr)
     {
-      return stationIt->second;
+      return m_stations[state->m_staId];
     }
 
-  WifiRemoteStationState *state = LookupState (address);
-
   WifiRemoteStation *station = DoCreateStation ();
   station->m_state = state;
   station->m_rssiAndUpdateTimePair = std::make_pair (0, Seconds (0));
-  const_cast<WifiRemoteStationManager *> (this)->m_stations.insert ({address, station});
+  const_cast<WifiRemoteStationManager *> (this)->m_stations[state->m_staId] = station;
   return station;
 }
 
@@ -1472,14 +1506,16 @@ WifiRemoteStationManager::Reset (void)
   NS_LOG_FUNCTION (this);
   for (auto& state : m_states)
     {
-      delete (state.second);
+      delete state;
     }
   m_states.clear ();
-  for (auto& state: m_stations)
+  for (auto& station : m_stations)
     {
-      delete (state.second);
+      delete station;
     }
   m_stations.clear ();
+  m_stationIds.clear ();
+  m_stationIdCache.fill ({Mac48Address (), INVALID_STA_ID});
   m_bssBasicRateSet.clear ();
   m_bssBasicMcsSet.clear ();
   m_ssrc.fill (0);
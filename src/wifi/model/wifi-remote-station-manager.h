@@ -23,6 +23,8 @@
 
 #include <array>
 #include <unordered_map>
+#include <vector>
+#include <limits>
 #include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/data-rate.h"
@@ -93,6 +95,7 @@ struct WifiRemoteStationState
   WifiModeList m_operationalRateSet; //!< operational rate set
   WifiModeList m_operationalMcsSet;  //!< operational MCS set
   Mac48Address m_address;            //!< Mac48Address of the remote station
+  uint32_t m_staId;                  //!< ID of the remote station (see WifiRemoteStationManager::GetStationId)
   uint16_t m_aid;                    /**< AID of the remote station (unused if this object
                                           is installed on a non-AP station) */
   WifiRemoteStationInfo m_info;      //!< remote station info
@@ -137,13 +140,17 @@ public:
   };
 
   /**
-   * A map of WifiRemoteStations with Mac48Address as key
+   * A vector of WifiRemoteStations with the station ID as index
    */
-  using Stations = std::unordered_map <Mac48Address, WifiRemoteStation *, WifiAddressHash>;
+  using Stations = std::vector<WifiRemoteStation *>;
   /**
-   * A map of WifiRemoteStationStates with Mac48Address as key
+   * A vector of WifiRemoteStationStates with the station ID as index
    */
-  using StationStates = std::unordered_map <Mac48Address, WifiRemoteStationState *, WifiAddressHash>;
+  using StationStates = std::vector<WifiRemoteStationState *>;
+  /**
+   * A map of station IDs with Mac48Address as key
+   */
+  using StationIds = std::unordered_map <Mac48Address, uint32_t, WifiAddressHash>;
 
   /**
    * Set up PHY associated with this device since it is the object that
@@ -1242,6 +1249,15 @@ private:
    * \return WifiRemoteStationState corresponding to the address
    */
   WifiRemoteStationState* LookupState (Mac48Address address) const;
+  /**
+   * Return the ID of the station associated with the given address. IDs are
+   * assigned in increasing order, starting at zero, the first time an address
+   * is looked up and are valid until the next call to Reset.
+   *
+   * \param address the address of the station
+   * \return the ID of the station
+   */
+  uint32_t GetStationId (Mac48Address address) const;
   /**
    * Return the station associated with the given address.
    *
@@ -1303,7 +1319,25 @@ private:
   WifiModeList m_bssBasicMcsSet;  //!< basic MCS set
 
   StationStates m_states;  //!< States of known stations
-  Stations m_stations;     //!< Information for each known stations
+  Stations m_stations;     //!< Information for each known stations (null if not created yet)
+  StationIds m_stationIds; //!< IDs of known stations
+
+  /// Entry of the cache of the station IDs
+  struct StationIdCacheEntry
+  {
+    Mac48Address address;  //!< the MAC address of the station
+    uint32_t staId;        //!< the ID of the station
+  };
+
+  /// Value of the station ID of the entries of the station ID cache that are not valid
+  static constexpr uint32_t INVALID_STA_ID = std::numeric_limits<uint32_t>::max ();
+
+  /**
+   * Direct-mapped cache of the station IDs, indexed by the two least significant
+   * bytes of the MAC address xor'ed together. It avoids hashing the MAC address
+   * on most lookups.
+   */
+  mutable std::array<StationIdCacheEntry, 256> m_stationIdCache;
 
   WifiMode m_defaultTxMode; //!< The default transmission mode
   WifiMode m_defaultTxMcs;  //!< The default transmission modulation-coding scheme (MCS)
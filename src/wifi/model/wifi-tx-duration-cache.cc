@@ -0,0 +1,163 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "wifi-tx-duration-cache.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiTxDurationCache");
+
+bool
+WifiTxDurationCache::Key::operator== (const Key& other) const
+{
+  return size == other.size && txVector == other.txVector && band == other.band;
+}
+
+std::size_t
+WifiTxDurationCache::KeyHash::operator() (const Key& key) const
+{
+  uint64_t h = key.txVector ^ (static_cast<uint64_t> (key.band) << 62);
+  h ^= key.size + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  return std::hash<uint64_t> () (h);
+}
+
+WifiTxDurationCache::WifiTxDurationCache (std::size_t capacity)
+  : m_capacity (capacity),
+    m_hits (0),
+    m_misses (0)
+{
+}
+
+bool
+WifiTxDurationCache::IsCacheable (const WifiTxVector& txVector)
+{
+  return !txVector.IsMu ();
+}
+
+uint64_t
+WifiTxDurationCache::Encode (const WifiTxVector& txVector)
+{
+  uint32_t modeUid = txVector.GetMode ().GetUid ();
+  uint16_t guardInterval = txVector.GetGuardInterval ();
+  NS_ASSERT (modeUid < (1 << 16) && guardInterval < (1 << 12));
+  NS_ASSERT (txVector.GetNss () < (1 << 4) && txVector.GetNess () < (1 << 4));
+
+  return static_cast<uint64_t> (modeUid)
+         | (static_cast<uint64_t> (txVector.GetPreambleType ()) << 16)
+         | (static_cast<uint64_t> (txVector.GetChannelWidth ()) << 24)
+         | (static_cast<uint64_t> (guardInterval) << 40)
+         | (static_cast<uint64_t> (txVector.GetNss ()) << 52)
+         | (static_cast<uint64_t> (txVector.GetNess ()) << 56)
+         | (static_cast<uint64_t> (txVector.IsStbc ()) << 60)
+         | (static_cast<uint64_t> (txVector.IsLdpc ()) << 61);
+}
+
+bool
+WifiTxDurationCache::Lookup (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, Time& duration)
+{
+  if (m_capacity == 0 || !IsCacheable (txVector))
+    {
+      return false;
+    }
+
+  auto indexIt = m_index.find ({size, Encode (txVector), band});
+  if (indexIt == m_index.end ())
+    {
+      m_misses++;
+      return false;
+    }
+
+  m_hits++;
+  // make the entry the most recently used one
+  m_entries.splice (m_entries.begin (), m_entries, indexIt->second);
+  duration = indexIt->second->second;
+  return true;
+}
+
+void
+WifiTxDurationCache::Insert (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, Time duration)
+{
+  if (m_capacity == 0 || !IsCacheable (txVector))
+    {
+      return;
+    }
+
+  Key key {size, Encode (txVector), band};
+  auto indexIt = m_index.find (key);
+  if (indexIt != m_index.end ())
+    {
+      indexIt->second->second = duration;
+      m_entries.splice (m_entries.begin (), m_entries, indexIt->second);
+      return;
+    }
+
+  if (m_entries.size () == m_capacity)
+    {
+      NS_LOG_DEBUG ("Evicting the least recently used entry");
+      m_index.erase (m_entries.back ().first);
+      m_entries.pop_back ();
+    }
+
+  m_entries.emplace_front (key, duration);
+  m_index.emplace (key, m_entries.begin ());
+}
+
+void
+WifiTxDurationCache::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_entries.clear ();
+  m_index.clear ();
+}
+
+void
+WifiTxDurationCache::SetCapacity (std::size_t capacity)
+{
+  NS_LOG_FUNCTION (this << capacity);
+  m_capacity = capacity;
+  while (m_entries.size () > m_capacity)
+    {
+      m_index.erase (m_entries.back ().first);
+      m_entries.pop_back ();
+    }
+}
+
+std::size_t
+WifiTxDurationCache::GetCapacity (void) const
+{
+  return m_capacity;
+}
+
+std::size_t
+WifiTxDurationCache::GetSize (void) const
+{
+  return m_entries.size ();
+}
+
+uint64_t
+WifiTxDurationCache::GetHits (void) const
+{
+  return m_hits;
+}
+
+uint64_t
+WifiTxDurationCache::GetMisses (void) const
+{
+  return m_misses;
+}
+
+} //namespace ns3
@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_TX_DURATION_CACHE_H
+#define WIFI_TX_DURATION_CACHE_H
+
+#include "wifi-tx-vector.h"
+#include "wifi-phy-band.h"
+#include "ns3/nstime.h"
+#include <list>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * This class memoizes the TX durations computed by WifiPhy::CalculateTxDuration.
+ * Entries are indexed by the PSDU size, a compact encoding of the fields of the
+ * TXVECTOR that affect the TX duration and the band. When the cache is full,
+ * the least recently used entry is evicted.
+ *
+ * Only SU TXVECTORs are cached, because the TX duration of MU PPDUs depends on
+ * the whole RU allocation.
+ */
+class WifiTxDurationCache
+{
+public:
+  /**
+   * Create a cache that can hold the given number of entries.
+   *
+   * \param capacity the maximum number of entries (0 disables the cache)
+   */
+  WifiTxDurationCache (std::size_t capacity = 0);
+
+  /**
+   * Look up the TX duration of a PSDU of the given size sent with the given
+   * TXVECTOR in the given band. If found, the entry becomes the most recently
+   * used one.
+   *
+   * \param size the size in bytes of the PSDU
+   * \param txVector the TXVECTOR used for the transmission
+   * \param band the frequency band
+   * \param [out] duration the cached TX duration, if found
+   * \return true if the TX duration was found in the cache
+   */
+  bool Lookup (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, Time& duration);
+
+  /**
+   * Store the TX duration of a PSDU of the given size sent with the given
+   * TXVECTOR in the given band, evicting the least recently used entry if
+   * the cache is full. Nothing is stored if the TXVECTOR cannot be cached.
+   *
+   * \param size the size in bytes of the PSDU
+   * \param txVector the TXVECTOR used for the transmission
+   * \param band the frequency band
+   * \param duration the TX duration to store
+   */
+  void Insert (uint32_t size, const WifiTxVector& txVector, WifiPhyBand band, Time duration);
+
+  /**
+   * Remove all the entries.
+   */
+  void Clear (void);
+
+  /**
+   * Set the maximum number of entries. Least recently used entries are evicted
+   * if the cache holds more entries than the new capacity.
+   *
+   * \param capacity the maximum number of entries (0 disables the cache)
+   */
+  void SetCapacity (std::size_t capacity);
+
+  /**
+   * \return the maximum number of entries
+   */
+  std::size_t GetCapacity (void) const;
+
+  /**
+   * \return the number of entries currently stored
+   */
+  std::size_t GetSize (void) const;
+
+  /**
+   * \return the number of lookups that found the requested entry
+   */
+  uint64_t GetHits (void) const;
+
+  /**
+   * \return the number of lookups that did not find the requested entry
+   */
+  uint64_t GetMisses (void) const;
+
+  /**
+   * \param txVector the given TXVECTOR
+   * \return whether TX durations for the given TXVECTOR can be cached
+   */
+  static bool IsCacheable (const WifiTxVector& txVector);
+
+private:
+  /// Key of the cache entries
+  struct Key
+  {
+    uint32_t size;     //!< PSDU size in bytes
+    uint64_t txVector; //!< compact encoding of the TXVECTOR
+    WifiPhyBand band;  //!< frequency band
+
+    /**
+     * \param other the key to compare with
+     * \return true if the two keys are equal
+     */
+    bool operator== (const Key& other) const;
+  };
+
+  /// Hash function for the keys of the cache entries
+  struct KeyHash
+  {
+    /**
+     * \param key the key to hash
+     * \return the hash value
+     */
+    std::size_t operator() (const Key& key) const;
+  };
+
+  /**
+   * Encode the fields of the given TXVECTOR that affect the TX duration
+   * of a SU PPDU into a 64-bit value. The encoding is lossless, hence
+   * two TXVECTORs have the same encoding only if they result in the same
+   * TX durations.
+   *
+   * \param txVector the given (SU) TXVECTOR
+   * \return the compact encoding of the TXVECTOR
+   */
+  static uint64_t Encode (const WifiTxVector& txVector);
+
+  /// List of entries, ordered from the most recently used to the least recently used
+  typedef std::list<std::pair<Key, Time>> EntryList;
+
+  std::size_t m_capacity;                                        //!< maximum number of entries
+  EntryList m_entries;                                           //!< cached entries
+  std::unordered_map<Key, EntryList::iterator, KeyHash> m_index; //!< index of the cached entries
+  uint64_t m_hits;                                               //!< number of lookup hits
+  uint64_t m_misses;                                             //!< number of lookup misses
+};
+
+} //namespace ns3
+
+#endif /* WIFI_TX_DURATION_CACHE_H */
@@ -25,6 +25,7 @@
 #include "mpdu-aggregator.h"
 #include "wifi-protection.h"
 #include "wifi-acknowledgment.h"
+#include "wifi-phy.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
 
@@ -245,6 +246,52 @@ WifiTxParameters::GetSize (Mac48Address receiver) const
   return newMpduSize;  
 }
 
+Time
+WifiTxParameters::CalculateTxDuration (uint32_t size, WifiPhyBand band) const
+{
+  NS_LOG_FUNCTION (this << size << band);
+
+  if (m_txVector.IsMu ())
+    {
+      // the duration of MU PPDUs depends on the STA-ID and the RU allocation
+      return WifiPhy::CalculateTxDuration (size, m_txVector, band);
+    }
+
+  if (!IsTxDurationCacheValid (band))
+    {
+      m_txDurationCache.txVector = m_txVector;
+      m_txDurationCache.band = band;
+      m_txDurationCache.valid = WifiPhy::GetTxDurationConstants (m_txVector, band, SU_STA_ID,
+                                                                 m_txDurationCache.constants);
+      if (!m_txDurationCache.valid)
+        {
+          return WifiPhy::CalculateTxDuration (size, m_txVector, band);
+        }
+    }
+
+  return WifiPhy::CalculateTxDuration (size, m_txDurationCache.constants);
+}
+
+bool
+WifiTxParameters::IsTxDurationCacheValid (WifiPhyBand band) const
+{
+  if (!m_txDurationCache.valid || m_txDurationCache.band != band)
+    {
+      return false;
+    }
+
+  const WifiTxVector& cached = m_txDurationCache.txVector;
+
+  return (cached.GetMode () == m_txVector.GetMode ()
+          && cached.GetPreambleType () == m_txVector.GetPreambleType ()
+          && cached.GetChannelWidth () == m_txVector.GetChannelWidth ()
+          && cached.GetGuardInterval () == m_txVector.GetGuardInterval ()
+          && cached.GetNss () == m_txVector.GetNss ()
+          && cached.GetNess () == m_txVector.GetNess ()
+          && cached.IsStbc () == m_txVector.IsStbc ()
+          && cached.IsLdpc () == m_txVector.IsLdpc ());
+}
+
 void
 WifiTxParameters::Print (std::ostream& os) const
 {
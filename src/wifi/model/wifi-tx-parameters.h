@@ -23,6 +23,7 @@
 
 #include "wifi-tx-vector.h"
 #include "wifi-mac-header.h"
+#include "phy-entity.h"
 #include "ns3/nstime.h"
 #include <map>
 #include <set>
@@ -110,6 +111,19 @@ public:
    */
   uint32_t GetSize (Mac48Address receiver) const;
 
+  /**
+   * Get the TX duration of a PPDU carrying a PSDU of the given size and sent with
+   * the TXVECTOR stored in this object. The quantities that only depend on the
+   * TXVECTOR are derived once and reused until the TXVECTOR or the band change,
+   * so that checking the TX duration of an A-MPDU every time an MPDU is added
+   * only requires to update the number of data symbols.
+   *
+   * \param size the size in bytes of the PSDU
+   * \param band the frequency band being used
+   * \return the TX duration of the PPDU
+   */
+  Time CalculateTxDuration (uint32_t size, WifiPhyBand band) const;
+
   /// information about the frame being prepared for a specific receiver
   struct PsduInfo
     {
@@ -148,8 +162,27 @@ public:
   void Print (std::ostream &os) const;
 
 private:
+  /**
+   * Check whether the cached TX duration constants have been derived from a
+   * TXVECTOR that results in the same TX durations as the current TXVECTOR.
+   *
+   * \param band the frequency band being used
+   * \return true if the cached TX duration constants can be used
+   */
+  bool IsTxDurationCacheValid (WifiPhyBand band) const;
+
+  /// TX duration constants derived from a TXVECTOR
+  struct TxDurationCache
+    {
+      bool valid {false};                        //!< whether the constants have been set
+      WifiTxVector txVector;                     //!< the TXVECTOR the constants are derived from
+      WifiPhyBand band {WIFI_PHY_BAND_UNSPECIFIED}; //!< the band the constants are derived for
+      PhyEntity::TxDurationConstants constants;  //!< the TX duration constants
+    };
+
   PsduInfoMap m_info;                  //!< information about the frame being prepared. Handles
                                        //!< multi-TID A-MPDUs, MU PPDUs, etc.
+  mutable TxDurationCache m_txDurationCache; //!< cached TX duration constants
 };
 
 /**
@@ -25,6 +25,9 @@
 #include "ns3/yans-wifi-phy.h"
 #include "ns3/he-ru.h"
 #include "ns3/wifi-psdu.h"
+#include "ns3/wifi-tx-parameters.h"
+#include "ns3/wifi-protection.h"
+#include "ns3/wifi-acknowledgment.h"
 #include "ns3/packet.h"
 #include "ns3/dsss-phy.h"
 #include "ns3/erp-ofdm-phy.h"
@@ -112,6 +115,20 @@ private:
    */
   static Time CalculateTxDurationUsingList (std::list<uint32_t> sizes, std::list<uint16_t> staIds,
                                             WifiTxVector txVector, WifiPhyBand band);
+
+  /**
+   * Calculate the overall Tx duration by means of the TX duration constants
+   * cached by WifiTxParameters. The TX duration of a PSDU of a different size
+   * is computed first, so that the TX duration of the given size is computed
+   * by reusing the constants derived from the TXVECTOR.
+   *
+   * @param size size of payload in octets (includes everything after the PHY header)
+   * @param txVector the TXVECTOR used for the transmission of the PPDU
+   * @param band the selected wifi PHY band
+   *
+   * @return the overall Tx duration for the given size
+   */
+  static Time CalculateTxDurationUsingConstants (uint32_t size, WifiTxVector txVector, WifiPhyBand band);
 };
 
 TxDurationTest::TxDurationTest ()
@@ -201,7 +218,9 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
   Time calculatedDuration = phy->CalculateTxDuration (size, txVector, band);
   Time calculatedDurationUsingList = CalculateTxDurationUsingList (std::list<uint32_t> {size}, std::list<uint16_t> {SU_STA_ID},
                                                                    txVector, band);
-  if (calculatedDuration != knownDuration || calculatedDuration != calculatedDurationUsingList)
+  Time calculatedDurationUsingConstants = CalculateTxDurationUsingConstants (size, txVector, band);
+  if (calculatedDuration != knownDuration || calculatedDuration != calculatedDurationUsingList
+      || calculatedDuration != calculatedDurationUsingConstants)
     {
       std::cerr << "size=" << size
                 << " mode=" << payloadMode
@@ -212,6 +231,7 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
                 << " known=" << knownDuration
                 << " calculated=" << calculatedDuration
                 << " calculatedUsingList=" << calculatedDurationUsingList
+                << " calculatedUsingConstants=" << calculatedDurationUsingConstants
                 << std::endl;
       return false;
     }
@@ -222,8 +242,10 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
       calculatedDuration = phy->CalculateTxDuration (size, txVector, band);
       calculatedDurationUsingList = CalculateTxDurationUsingList (std::list<uint32_t> {size}, std::list<uint16_t> {SU_STA_ID},
                                                                   txVector, band);
+      calculatedDurationUsingConstants = CalculateTxDurationUsingConstants (size, txVector, band);
       knownDuration += MicroSeconds (6);
-      if (calculatedDuration != knownDuration || calculatedDuration != calculatedDurationUsingList)
+      if (calculatedDuration != knownDuration || calculatedDuration != calculatedDurationUsingList
+          || calculatedDuration != calculatedDurationUsingConstants)
         {
           std::cerr << "size=" << size
                     << " mode=" << payloadMode
@@ -234,6 +256,7 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, uint16_t c
                     << " known=" << knownDuration
                     << " calculated=" << calculatedDuration
                     << " calculatedUsingList=" << calculatedDurationUsingList
+                    << " calculatedUsingConstants=" << calculatedDurationUsingConstants
                     << std::endl;
           return false;
         }
@@ -324,6 +347,15 @@ TxDurationTest::CalculateTxDurationUsingList (std::list<uint32_t> sizes, std::li
   return WifiPhy::CalculateTxDuration (psduMap, txVector, band);
 }
 
+Time
+TxDurationTest::CalculateTxDurationUsingConstants (uint32_t size, WifiTxVector txVector, WifiPhyBand band)
+{
+  WifiTxParameters txParams;
+  txParams.m_txVector = txVector;
+  txParams.CalculateTxDuration (size + 1, band);
+  return txParams.CalculateTxDuration (size, band);
+}
+
 void
 TxDurationTest::DoRun (void)
 {
@@ -967,6 +999,81 @@ PhyHeaderSectionsTest::DoRun (void)
   CheckPhyHeaderSections (phyEntity->GetPhyHeaderSections (txVector, ppduStart), sections);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the TX duration cache
+ */
+class TxDurationCacheTest : public TestCase
+{
+public:
+  TxDurationCacheTest ();
+
+private:
+  void DoRun (void) override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TestCase ("Check the LRU cache of TX durations")
+{
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  WifiTxVector txVector;
+  txVector.SetMode (HePhy::GetHeMcs (7));
+  txVector.SetPreambleType (WIFI_PREAMBLE_HE_SU);
+  txVector.SetChannelWidth (80);
+  txVector.SetGuardInterval (800);
+  txVector.SetNss (1);
+
+  WifiTxDurationCache cache (2);
+  Time duration;
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (100, txVector, WIFI_PHY_BAND_5GHZ, duration), false,
+                         "Cache should be empty");
+
+  cache.Insert (100, txVector, WIFI_PHY_BAND_5GHZ, MicroSeconds (100));
+  cache.Insert (200, txVector, WIFI_PHY_BAND_5GHZ, MicroSeconds (200));
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (100, txVector, WIFI_PHY_BAND_5GHZ, duration), true,
+                         "Entry for size 100 should be cached");
+  NS_TEST_EXPECT_MSG_EQ (duration, MicroSeconds (100), "Unexpected cached duration");
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (100, txVector, WIFI_PHY_BAND_2_4GHZ, duration), false,
+                         "Entries for distinct bands must be distinct");
+
+  // the entry for size 200 is now the least recently used one
+  cache.Insert (300, txVector, WIFI_PHY_BAND_5GHZ, MicroSeconds (300));
+  NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), 2, "Unexpected number of entries");
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (200, txVector, WIFI_PHY_BAND_5GHZ, duration), false,
+                         "Entry for size 200 should have been evicted");
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (100, txVector, WIFI_PHY_BAND_5GHZ, duration), true,
+                         "Entry for size 100 should be cached");
+
+  WifiTxVector otherTxVector = txVector;
+  otherTxVector.SetGuardInterval (1600);
+  NS_TEST_EXPECT_MSG_EQ (cache.Lookup (100, otherTxVector, WIFI_PHY_BAND_5GHZ, duration), false,
+                         "Entries for distinct TXVECTORs must be distinct");
+
+  otherTxVector.SetPreambleType (WIFI_PREAMBLE_HE_MU);
+  cache.Insert (100, otherTxVector, WIFI_PHY_BAND_5GHZ, MicroSeconds (100));
+  NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), 2, "MU TXVECTORs should not be cached");
+
+  cache.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (cache.GetSize (), 0, "Cache should be empty");
+
+  // the durations returned by WifiPhy do not depend on whether they are cached
+  WifiTxDurationCache& phyCache = WifiPhy::GetTxDurationCache ();
+  std::size_t capacity = phyCache.GetCapacity ();
+  phyCache.SetCapacity (0);
+  Time uncached = WifiPhy::CalculateTxDuration (1500, txVector, WIFI_PHY_BAND_5GHZ);
+  phyCache.SetCapacity (16);
+  WifiPhy::CalculateTxDuration (1500, txVector, WIFI_PHY_BAND_5GHZ);
+  NS_TEST_EXPECT_MSG_EQ (WifiPhy::CalculateTxDuration (1500, txVector, WIFI_PHY_BAND_5GHZ), uncached,
+                         "Cached TX duration differs from computed TX duration");
+  phyCache.SetCapacity (capacity);
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -985,6 +1092,7 @@ TxDurationTestSuite::TxDurationTestSuite ()
   AddTestCase (new HeSigBDurationTest, TestCase::QUICK);
   AddTestCase (new TxDurationTest, TestCase::QUICK);
   AddTestCase (new PhyHeaderSectionsTest, TestCase::QUICK);
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
 }
 
 static TxDurationTestSuite g_txDurationTestSuite; ///< the test suite
@@ -40,6 +40,10 @@
 #include "ns3/wifi-psdu.h"
 #include "ns3/multi-user-scheduler.h"
 #include "ns3/he-phy.h"
+#include "ns3/pf-multi-user-scheduler.h"
+#include "ns3/qos-txop.h"
+#include "ns3/wifi-mac-queue.h"
+#include <set>
 
 using namespace ns3;
 
@@ -1304,6 +1308,261 @@ OfdmaAckSequenceTest::DoRun (void)
 }
 
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the station selection and the backlog tracking of PfMultiUserScheduler
+ *
+ * An AP sends the same amount of traffic to each of four HE stations located at
+ * the same distance, while the scheduler can serve at most two stations per DL MU
+ * PPDU. Since all the stations have the same data rate, the proportional fair
+ * metric makes the scheduler serve two disjoint pairs of stations in alternate
+ * DL MU PPDUs. The number of backlogged stations reported by the scheduler is
+ * checked against the content of the AP queue every time the AP transmits.
+ */
+class PfMultiUserSchedulerTest : public TestCase
+{
+public:
+  PfMultiUserSchedulerTest ();
+  virtual ~PfMultiUserSchedulerTest ();
+
+  /**
+   * Callback invoked when FrameExchangeManager passes PSDUs to the PHY
+   * \param context the context
+   * \param psduMap the PSDU map
+   * \param txVector the TX vector
+   * \param txPowerW the tx power in Watts
+   */
+  void Transmit (std::string context, WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+  /**
+   * Check that the number of backlogged stations reported by the scheduler
+   * matches the content of the BE queue of the AP
+   */
+  void CheckBacklog (void);
+  /**
+   * Check that all the stations are backlogged
+   */
+  void CheckAllBacklogged (void);
+
+private:
+  void DoRun (void) override;
+
+  uint16_t m_nStations;                      ///< number of stations
+  uint16_t m_nPktsPerSta;                    ///< number of packets to send to each station
+  NetDeviceContainer m_staDevices;           ///< stations' devices
+  Ptr<WifiNetDevice> m_apDevice;             ///< AP's device
+  Ptr<WifiMacQueue> m_apBeQueue;            ///< BE queue of the AP
+  Ptr<PfMultiUserScheduler> m_scheduler;     ///< the scheduler under test
+  std::vector<std::set<uint16_t>> m_dlMuStaIds; ///< STA-IDs addressed by each DL MU PPDU
+};
+
+PfMultiUserSchedulerTest::PfMultiUserSchedulerTest ()
+  : TestCase ("Check station selection and backlog tracking of PfMultiUserScheduler"),
+    m_nStations (4),
+    m_nPktsPerSta (20)
+{
+}
+
+PfMultiUserSchedulerTest::~PfMultiUserSchedulerTest ()
+{
+}
+
+void
+PfMultiUserSchedulerTest::Transmit (std::string context, WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+  if (txVector.GetPreambleType () != WIFI_PREAMBLE_HE_MU)
+    {
+      return;
+    }
+  std::set<uint16_t> staIds;
+  for (const auto& psdu : psduMap)
+    {
+      staIds.insert (psdu.first);
+    }
+  m_dlMuStaIds.push_back (staIds);
+  CheckBacklog ();
+}
+
+void
+PfMultiUserSchedulerTest::CheckBacklog (void)
+{
+  std::size_t nBacklogged = 0;
+  for (uint32_t i = 0; i < m_staDevices.GetN (); i++)
+    {
+      Mac48Address address = Mac48Address::ConvertFrom (m_staDevices.Get (i)->GetAddress ());
+      if (m_apBeQueue->GetNPackets (0, address) + m_apBeQueue->GetNPackets (3, address) > 0)
+        {
+          nBacklogged++;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_scheduler->GetNBackloggedStations (AC_BE), nBacklogged,
+                         "Unexpected number of backlogged stations at " << Simulator::Now ());
+}
+
+void
+PfMultiUserSchedulerTest::CheckAllBacklogged (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_scheduler->GetNBackloggedStations (AC_BE), m_nStations,
+                         "Expected all the stations to be backlogged");
+  CheckBacklog ();
+}
+
+void
+PfMultiUserSchedulerTest::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (2);
+  int64_t streamNumber = 100;
+
+  NodeContainer wifiApNode;
+  wifiApNode.Create (1);
+
+  NodeContainer wifiStaNodes;
+  wifiStaNodes.Create (m_nStations);
+
+  Ptr<MultiModelSpectrumChannel> spectrumChannel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<FriisPropagationLossModel> lossModel = CreateObject<FriisPropagationLossModel> ();
+  spectrumChannel->AddPropagationLossModel (lossModel);
+  Ptr<ConstantSpeedPropagationDelayModel> delayModel = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  spectrumChannel->SetPropagationDelayModel (delayModel);
+
+  SpectrumWifiPhyHelper phy;
+  phy.SetErrorRateModel ("ns3::NistErrorRateModel");
+  phy.SetChannel (spectrumChannel);
+  phy.Set ("ChannelNumber", UintegerValue (36));
+  phy.Set ("ChannelWidth", UintegerValue (20));
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211ax_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::IdealWifiManager");
+
+  WifiMacHelper mac;
+  Ssid ssid = Ssid ("ns-3-ssid");
+  mac.SetType ("ns3::StaWifiMac",
+               "Ssid", SsidValue (ssid),
+               "ActiveProbing", BooleanValue (false));
+
+  m_staDevices = wifi.Install (phy, mac, wifiStaNodes);
+
+  mac.SetType ("ns3::ApWifiMac",
+               "BE_MaxAmsduSize", UintegerValue (0),
+               "BE_MaxAmpduSize", UintegerValue (10000),
+               "Ssid", SsidValue (ssid),
+               "BeaconGeneration", BooleanValue (true));
+  mac.SetMultiUserScheduler ("ns3::PfMultiUserScheduler",
+                             "NStations", UintegerValue (2));
+
+  m_apDevice = DynamicCast<WifiNetDevice> (wifi.Install (phy, mac, wifiApNode).Get (0));
+  m_scheduler = m_apDevice->GetMac ()->GetObject<PfMultiUserScheduler> ();
+  NS_TEST_ASSERT_MSG_NE (m_scheduler, nullptr, "The AP has no PfMultiUserScheduler");
+
+  PointerValue ptr;
+  m_apDevice->GetMac ()->GetAttribute ("BE_Txop", ptr);
+  m_apBeQueue = ptr.Get<QosTxop> ()->GetWifiMacQueue ();
+
+  // Assign fixed streams to random variables in use
+  streamNumber += wifi.AssignStreams (NetDeviceContainer (m_apDevice), streamNumber);
+  streamNumber += wifi.AssignStreams (m_staDevices, streamNumber);
+
+  // all the stations are at the same distance from the AP
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, 1.0, 0.0));
+  positionAlloc->Add (Vector (-1.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (0.0, -1.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (wifiApNode);
+  mobility.Install (wifiStaNodes);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (wifiApNode);
+  packetSocket.Install (wifiStaNodes);
+
+  for (uint16_t i = 0; i < m_nStations; i++)
+    {
+      PacketSocketAddress socket;
+      socket.SetSingleDevice (m_apDevice->GetIfIndex ());
+      socket.SetPhysicalAddress (m_staDevices.Get (i)->GetAddress ());
+      socket.SetProtocol (1);
+
+      // the first client application generates two packets in order
+      // to trigger the establishment of a Block Ack agreement
+      Ptr<PacketSocketClient> client1 = CreateObject<PacketSocketClient> ();
+      client1->SetAttribute ("PacketSize", UintegerValue (1400));
+      client1->SetAttribute ("MaxPackets", UintegerValue (2));
+      client1->SetAttribute ("Interval", TimeValue (MicroSeconds (0)));
+      client1->SetRemote (socket);
+      wifiApNode.Get (0)->AddApplication (client1);
+      client1->SetStartTime (Seconds (1) + i * MilliSeconds (1));
+      client1->SetStopTime (Seconds (2.0));
+
+      // the second client application generates the same number of packets
+      // for every station, which are sent in DL MU PPDUs
+      Ptr<PacketSocketClient> client2 = CreateObject<PacketSocketClient> ();
+      client2->SetAttribute ("PacketSize", UintegerValue (1400));
+      client2->SetAttribute ("MaxPackets", UintegerValue (m_nPktsPerSta));
+      client2->SetAttribute ("Interval", TimeValue (MicroSeconds (0)));
+      client2->SetRemote (socket);
+      wifiApNode.Get (0)->AddApplication (client2);
+      client2->SetStartTime (Seconds (1.5));
+      client2->SetStopTime (Seconds (2.5));
+
+      Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+      server->SetLocal (socket);
+      wifiStaNodes.Get (i)->AddApplication (server);
+      server->SetStartTime (Seconds (0.0));
+      server->SetStopTime (Seconds (3.0));
+    }
+
+  Config::Connect ("/NodeList/0/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxPsduBegin",
+                   MakeCallback (&PfMultiUserSchedulerTest::Transmit, this));
+
+  // right after the second client applications start, all the stations are backlogged
+  Simulator::Schedule (Seconds (1.5) + NanoSeconds (1), &PfMultiUserSchedulerTest::CheckAllBacklogged, this);
+
+  Simulator::Stop (Seconds (3));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_scheduler->GetNBackloggedStations (AC_BE), 0,
+                         "Expected no backlogged station at the end of the simulation");
+  NS_TEST_EXPECT_MSG_GT (m_dlMuStaIds.size (), 2, "Too few DL MU PPDUs transmitted");
+
+  // while all the stations are backlogged, every DL MU PPDU is addressed to two
+  // stations that were not served by the previous DL MU PPDU
+  std::vector<uint32_t> nServed (m_nStations + 1, 0);
+  for (std::size_t i = 0; i < m_dlMuStaIds.size (); i++)
+    {
+      for (uint16_t staId : m_dlMuStaIds[i])
+        {
+          NS_TEST_ASSERT_MSG_EQ ((staId >= 1 && staId <= m_nStations), true, "Unexpected STA-ID " << staId);
+          nServed[staId]++;
+        }
+      if (i > 0 && m_dlMuStaIds[i].size () == 2 && m_dlMuStaIds[i - 1].size () == 2)
+        {
+          for (uint16_t staId : m_dlMuStaIds[i])
+            {
+              NS_TEST_EXPECT_MSG_EQ (m_dlMuStaIds[i - 1].count (staId), 0,
+                                     "Station " << staId << " served by two consecutive DL MU PPDUs");
+            }
+        }
+    }
+  // stations with equal rates and traffic are served (almost) the same number of times
+  for (uint16_t staId = 1; staId <= m_nStations; staId++)
+    {
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (nServed[staId] + 1, nServed[1], "Station " << staId << " under-served");
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (nServed[staId], nServed[1] + 1, "Station " << staId << " over-served");
+    }
+
+  Simulator::Destroy ();
+}
+
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1332,6 +1591,7 @@ WifiMacOfdmaTestSuite::WifiMacOfdmaTestSuite ()
       AddTestCase (new OfdmaAckSequenceTest (40, WifiAcknowledgment::DL_MU_AGGREGATE_TF, 10000, 0, 15, muEdcaParameterSet), TestCase::QUICK);
       AddTestCase (new OfdmaAckSequenceTest (40, WifiAcknowledgment::DL_MU_TF_MU_BAR, 10000, 0, 15, muEdcaParameterSet), TestCase::QUICK);
     }
+  AddTestCase (new PfMultiUserSchedulerTest, TestCase::QUICK);
 }
 
 static WifiMacOfdmaTestSuite g_wifiMacOfdmaTestSuite; ///< the test suite
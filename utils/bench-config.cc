@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the time taken to connect the
+// trace sinks of a simulation script with Config::Connect, with
+// compiled Config::Path objects, and with a Config::BulkConnector.
+// Sample usage:  ./waf --run 'bench-config --nodes=1000'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-phy-state.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of trace sink invocations, unused
+static uint64_t g_count = 0;
+
+static void
+PacketSink (std::string context, Ptr<const Packet> packet)
+{
+  g_count++;
+}
+
+static void
+PhyTxBeginSink (std::string context, Ptr<const Packet> packet, double txPowerW)
+{
+  g_count++;
+}
+
+static void
+StateSink (std::string context, Time start, Time duration, WifiPhyState state)
+{
+  g_count++;
+}
+
+static void
+CourseChangeSink (std::string context, Ptr<const MobilityModel> model)
+{
+  g_count++;
+}
+
+static void
+Ipv4TxSink (std::string context, Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  g_count++;
+}
+
+/// The paths and sinks connected by a typical Wi-Fi simulation script
+struct TracePath
+{
+  std::string path;   //!< The Config path of the trace source
+  CallbackBase sink;  //!< The trace sink
+};
+
+static std::vector<TracePath>
+GetTracePaths (void)
+{
+  std::string device = "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice";
+  std::vector<TracePath> paths;
+  paths.push_back ({device + "/Phy/PhyTxBegin", MakeCallback (&PhyTxBeginSink)});
+  paths.push_back ({device + "/Phy/PhyTxEnd", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Phy/PhyTxDrop", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Phy/PhyRxEnd", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Phy/State/State", MakeCallback (&StateSink)});
+  paths.push_back ({device + "/Mac/MacTx", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Mac/MacTxDrop", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Mac/MacRx", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Mac/MacRxDrop", MakeCallback (&PacketSink)});
+  paths.push_back ({device + "/Mac/MacPromiscRx", MakeCallback (&PacketSink)});
+  paths.push_back ({"/NodeList/*/$ns3::MobilityModel/CourseChange", MakeCallback (&CourseChangeSink)});
+  paths.push_back ({"/NodeList/*/$ns3::Ipv4L3Protocol/Tx", MakeCallback (&Ipv4TxSink)});
+  return paths;
+}
+
+static void
+benchConnect (const std::vector<TracePath> &paths)
+{
+  for (std::vector<TracePath>::const_iterator i = paths.begin (); i != paths.end (); i++)
+    {
+      Config::Connect (i->path, i->sink);
+    }
+}
+
+static void
+benchCompiledPath (const std::vector<TracePath> &paths)
+{
+  std::vector<Config::Path> compiled;
+  for (std::vector<TracePath>::const_iterator i = paths.begin (); i != paths.end (); i++)
+    {
+      compiled.push_back (Config::Path (i->path));
+    }
+  for (uint32_t i = 0; i < paths.size (); i++)
+    {
+      compiled[i].Connect (paths[i].sink);
+    }
+}
+
+static void
+benchBulkConnector (const std::vector<TracePath> &paths)
+{
+  Config::BulkConnector connector;
+  for (std::vector<TracePath>::const_iterator i = paths.begin (); i != paths.end (); i++)
+    {
+      connector.Add (i->path, i->sink);
+    }
+  connector.Connect ();
+}
+
+static void
+runBench (void (*bench) (const std::vector<TracePath> &), const std::vector<TracePath> &paths,
+          uint32_t nodes, uint32_t minIterations, char const *name)
+{
+  // every iteration connects the sinks again, on top of the previous ones
+  uint64_t deltaMs = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (paths);
+      deltaMs = std::min (deltaMs, static_cast<uint64_t> (time.End ()));
+    }
+  double us = deltaMs;
+  us *= 1e3;
+  us /= nodes;
+  std::cout << "  " << deltaMs << " ms"
+            << " (" << us << " us/node)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nodes = 1000;
+  uint32_t minIterations = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the connection of trace sinks with the Config paths");
+  cmd.AddValue ("nodes", "number of Wi-Fi nodes", nodes);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  SystemWallClockMs time;
+  time.Start ();
+
+  NodeContainer c;
+  c.Create (nodes);
+
+  WifiHelper wifi;
+  YansWifiPhyHelper wifiPhy;
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiMacHelper wifiMac;
+  wifiMac.SetType ("ns3::AdhocWifiMac");
+  wifi.Install (wifiPhy, wifiMac, c);
+
+  MobilityHelper mobility;
+  mobility.Install (c);
+
+  InternetStackHelper internet;
+  internet.Install (c);
+
+  std::cout << "Running bench-config with " << nodes << " nodes (topology built in "
+            << time.End () << " ms)" << std::endl;
+
+  std::vector<TracePath> paths = GetTracePaths ();
+  runBench (&benchConnect, paths, nodes, minIterations, "Config::Connect");
+  runBench (&benchCompiledPath, paths, nodes, minIterations, "Config::Path::Connect");
+  runBench (&benchBulkConnector, paths, nodes, minIterations, "Config::BulkConnector");
+
+  std::cerr << g_count << std::endl;
+  return 0;
+}
@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark Object::GetObject on a node
+// with the objects aggregated by the Internet stack, the mobility
+// model and an energy source, and on its Wi-Fi device.
+// Sample usage:  ./waf --run 'bench-object --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv6-l3-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/basic-energy-source-helper.h"
+#include "ns3/wifi-radio-energy-model-helper.h"
+#include "ns3/energy-source-container.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/// Sink for the results, so that the compiler cannot drop the loops
+static uint64_t g_sink = 0;
+
+template <typename T>
+static void
+benchGetObject (Ptr<Object> object, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += (object->GetObject<T> () != 0);
+    }
+}
+
+static void
+benchMixed (Ptr<Object> object, uint32_t n)
+{
+  // the lookups of a packet going down the stack and of a trace sink
+  for (uint32_t i = 0; i < n; i += 4)
+    {
+      g_sink += (object->GetObject<TrafficControlLayer> () != 0);
+      g_sink += (object->GetObject<Ipv4> () != 0);
+      g_sink += (object->GetObject<MobilityModel> () != 0);
+      g_sink += (object->GetObject<EnergySourceContainer> () != 0);
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (Ptr<Object>, uint32_t), Ptr<Object> object, uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (object, n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (Ptr<Object>, uint32_t), Ptr<Object> object, uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, object, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ns = minDelay;
+  ns *= 1e6;
+  ns /= n;
+  std::cout << "  " << ns << " ns/op"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 1000000;
+  uint32_t minIterations = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark Object::GetObject");
+  cmd.AddValue ("n", "number of lookups per benchmark", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  WifiHelper wifi;
+  YansWifiPhyHelper wifiPhy;
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+  WifiMacHelper wifiMac;
+  wifiMac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (wifiPhy, wifiMac, nodes);
+
+  MobilityHelper mobility;
+  mobility.Install (nodes);
+
+  BasicEnergySourceHelper basicSourceHelper;
+  EnergySourceContainer sources = basicSourceHelper.Install (nodes);
+  WifiRadioEnergyModelHelper radioEnergyHelper;
+  radioEnergyHelper.Install (devices, sources);
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ptr<Object> node = nodes.Get (0);
+  Ptr<Object> device = devices.Get (0);
+  uint32_t aggregates = 0;
+  for (Object::AggregateIterator i = node->GetAggregateIterator (); i.HasNext (); i.Next ())
+    {
+      aggregates++;
+    }
+
+  std::cout << "Running bench-object with n=" << n << std::endl;
+  std::cout << "Node with " << aggregates << " aggregated objects" << std::endl;
+  runBench (&benchGetObject<MobilityModel>, node, n, minIterations, "GetObject<MobilityModel>");
+  runBench (&benchGetObject<Ipv4>, node, n, minIterations, "GetObject<Ipv4>");
+  runBench (&benchGetObject<Ipv4L3Protocol>, node, n, minIterations, "GetObject<Ipv4L3Protocol>");
+  runBench (&benchGetObject<Ipv6L3Protocol>, node, n, minIterations, "GetObject<Ipv6L3Protocol>");
+  runBench (&benchGetObject<UdpL4Protocol>, node, n, minIterations, "GetObject<UdpL4Protocol>");
+  runBench (&benchGetObject<TcpL4Protocol>, node, n, minIterations, "GetObject<TcpL4Protocol>");
+  runBench (&benchGetObject<TrafficControlLayer>, node, n, minIterations, "GetObject<TrafficControlLayer>");
+  runBench (&benchGetObject<EnergySourceContainer>, node, n, minIterations, "GetObject<EnergySourceContainer>");
+  runBench (&benchGetObject<Node>, node, n, minIterations, "GetObject<Node>");
+  runBench (&benchGetObject<WifiNetDevice>, node, n, minIterations, "GetObject<WifiNetDevice> (missing)");
+  runBench (&benchMixed, node, n, minIterations, "mixed lookups");
+  std::cout << "Wi-Fi device" << std::endl;
+  runBench (&benchGetObject<WifiNetDevice>, device, n, minIterations, "GetObject<WifiNetDevice>");
+  runBench (&benchGetObject<NetDevice>, device, n, minIterations, "GetObject<NetDevice>");
+
+  std::cerr << g_sink << std::endl;
+  return 0;
+}
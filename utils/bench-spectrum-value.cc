@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the SpectrumValue arithmetic
+// over the spectrum models of 25, 50 and 100 LTE RBs and of a 160 MHz
+// Wi-Fi channel, comparing the operators (which create temporaries)
+// with the in-place and fused kernels.
+// Sample usage:  ./waf --run 'bench-spectrum-value --n=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/// Sink for the results, so that the compiler cannot drop the loops
+static double g_sink = 0;
+
+/**
+ * Create a spectrum model made of contiguous LTE RBs
+ * \param nRbs the number of RBs
+ * \return the spectrum model
+ */
+static Ptr<SpectrumModel>
+CreateRbSpectrumModel (uint32_t nRbs)
+{
+  std::vector<double> centerFrequencies;
+  for (uint32_t i = 0; i < nRbs; i++)
+    {
+      centerFrequencies.push_back (2.12e9 + i * 180e3);
+    }
+  return Create<SpectrumModel> (centerFrequencies);
+}
+
+/**
+ * Create a SpectrumValue with non-zero values
+ * \param model the spectrum model
+ * \param seed the value of the first component
+ * \return the SpectrumValue
+ */
+static SpectrumValue
+CreateValue (Ptr<SpectrumModel> model, double seed)
+{
+  SpectrumValue v (model);
+  for (uint32_t i = 0; i < v.GetValuesN (); i++)
+    {
+      v[i] = seed + 1e-3 * i;
+    }
+  return v;
+}
+
+/// Operands shared by the benchmarks
+struct Operands
+{
+  SpectrumValue signal;     ///< the signal of interest
+  SpectrumValue allSignals; ///< all the signals
+  SpectrumValue noise;      ///< the noise
+  SpectrumValue result;     ///< storage for the in-place kernels
+};
+
+static void
+benchSinrOperators (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sinr = o.signal / (o.allSignals - o.signal + o.noise);
+      g_sink += sinr[0];
+    }
+}
+
+static void
+benchSinrFused (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      o.result.AssignSinr (o.signal, o.allSignals, o.noise);
+      g_sink += o.result[0];
+    }
+}
+
+static void
+benchAddOperator (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sum = o.allSignals + o.signal;
+      g_sink += sum[0];
+    }
+}
+
+static void
+benchAddInPlace (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      o.result += o.signal;
+      g_sink += o.result[0];
+    }
+}
+
+static void
+benchScaleInPlace (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      o.result *= 1.0000001;
+      g_sink += o.result[0];
+    }
+}
+
+static void
+benchIntegral (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += Integral (o.signal);
+    }
+}
+
+static void
+benchSum (Operands &o, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += Sum (o.signal);
+    }
+}
+
+static uint64_t
+runBenchOneIteration (void (*bench) (Operands &, uint32_t), Operands &o, uint32_t n)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  (*bench) (o, n);
+  uint64_t deltaMs = time.End ();
+  return deltaMs;
+}
+
+static void
+runBench (void (*bench) (Operands &, uint32_t), Operands &o, uint32_t n, uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      uint64_t delay = runBenchOneIteration (bench, o, n);
+      minDelay = std::min (minDelay, delay);
+    }
+  double ns = minDelay;
+  ns *= 1e6;
+  ns /= n;
+  std::cout << "  " << ns << " ns/op"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+static void
+runModel (Ptr<SpectrumModel> model, char const *name, uint32_t n, uint32_t minIterations)
+{
+  Operands o = {CreateValue (model, 1e-12), CreateValue (model, 3e-12),
+                CreateValue (model, 1e-13), CreateValue (model, 0)};
+  std::cout << name << " (" << model->GetNumBands () << " bands)" << std::endl;
+  runBench (&benchSinrOperators, o, n, minIterations, "SINR with operators");
+  runBench (&benchSinrFused, o, n, minIterations, "SINR with AssignSinr");
+  runBench (&benchAddOperator, o, n, minIterations, "a + b");
+  runBench (&benchAddInPlace, o, n, minIterations, "a += b");
+  runBench (&benchScaleInPlace, o, n, minIterations, "a *= s");
+  runBench (&benchIntegral, o, n, minIterations, "Integral (a)");
+  runBench (&benchSum, o, n, minIterations, "Sum (a)");
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t minIterations = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark SpectrumValue arithmetic");
+  cmd.AddValue ("n", "number of operations per benchmark", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-spectrum-value with n=" << n << std::endl;
+  runModel (CreateRbSpectrumModel (25), "LTE 25 RBs", n, minIterations);
+  runModel (CreateRbSpectrumModel (50), "LTE 50 RBs", n, minIterations);
+  runModel (CreateRbSpectrumModel (100), "LTE 100 RBs", n, minIterations);
+  // 160 MHz channel at 5570 MHz with 78.125 kHz bands and 16 MHz of guard
+  runModel (WifiSpectrumValueHelper::GetSpectrumModel (5570, 160, 78125, 16), "Wi-Fi 160 MHz", n / 10, minIterations);
+
+  std::cerr << g_sink << std::endl;
+  return 0;
+}
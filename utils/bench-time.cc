@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the Time unit conversions used
+// on the hot paths of the PHY models.  Compare a build configured with
+// --time-resolution=ns (or -DNS3_TIME_RESOLUTION=NS) with the default
+// one, which goes through the run-time tables and int64x64_t.
+// Sample usage:  ./waf --run 'bench-time --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/int64x64.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Sum of the results, printed so that the loops are not optimized out
+static double g_sum = 0;
+
+static void
+benchGetSeconds (const std::vector<Time> &times)
+{
+  double sum = 0;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      sum += i->GetSeconds ();
+    }
+  g_sum += sum;
+}
+
+static void
+benchGetMicroSeconds (const std::vector<Time> &times)
+{
+  int64_t sum = 0;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      sum += i->GetMicroSeconds ();
+    }
+  g_sum += sum;
+}
+
+static void
+benchSeconds (const std::vector<Time> &times)
+{
+  Time sum;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      sum += Seconds (i->GetTimeStep () * 1e-12);
+    }
+  g_sum += sum.GetTimeStep ();
+}
+
+static void
+benchMicroSeconds (const std::vector<Time> &times)
+{
+  Time sum;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      sum += MicroSeconds (i->GetTimeStep () & 0xffff);
+    }
+  g_sum += sum.GetTimeStep ();
+}
+
+static void
+benchMultiplyDouble (const std::vector<Time> &times)
+{
+  Time sum;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      sum += *i * 0.75;
+    }
+  g_sum += sum.GetTimeStep ();
+}
+
+static void
+benchSymbolsFemtoSeconds (const std::vector<Time> &times)
+{
+  // the duration of a number of OFDM symbols, as computed by the Wi-Fi PHYs
+  Time symbolDuration = NanoSeconds (13600);
+  Time sum;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      double numSymbols = static_cast<double> (i->GetTimeStep () & 0xff);
+      sum += FemtoSeconds (static_cast<uint64_t> (numSymbols * symbolDuration.GetFemtoSeconds ()));
+    }
+  g_sum += sum.GetTimeStep ();
+}
+
+static void
+benchSymbolsInteger (const std::vector<Time> &times)
+{
+  Time symbolDuration = NanoSeconds (13600);
+  Time sum;
+  for (std::vector<Time>::const_iterator i = times.begin (); i != times.end (); i++)
+    {
+      int64_t numSymbols = i->GetTimeStep () & 0xff;
+      sum += symbolDuration * numSymbols;
+    }
+  g_sum += sum.GetTimeStep ();
+}
+
+static void
+runBench (void (*bench) (const std::vector<Time> &), const std::vector<Time> &times,
+          uint32_t minIterations, char const *name)
+{
+  uint64_t deltaMs = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (times);
+      deltaMs = std::min (deltaMs, static_cast<uint64_t> (time.End ()));
+    }
+  double ns = deltaMs;
+  ns *= 1e6;
+  ns /= times.size ();
+  std::cout << "  " << deltaMs << " ms"
+            << " (" << ns << " ns/op)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 10000000;
+  uint32_t minIterations = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the Time unit conversions");
+  cmd.AddValue ("n", "number of conversions per iteration", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  // Until the simulation starts, every Time is recorded in case the
+  // resolution changes: run it to measure the conversions alone
+  Simulator::Run ();
+
+  std::vector<Time> times;
+  times.reserve (n);
+  uint64_t x = 88172645463325252ULL;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // xorshift, to keep the values out of the branch predictor
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      times.push_back (TimeStep (x % 100000000000ULL));
+    }
+
+  std::string impl;
+  switch (int64x64_t::implementation)
+    {
+    case int64x64_t::int128_impl:
+      impl = "int128";
+      break;
+    case int64x64_t::cairo_impl:
+      impl = "cairo";
+      break;
+    case int64x64_t::ld_impl:
+      impl = "long double";
+      break;
+    }
+  std::cout << "Running bench-time with " << n << " conversions, int64x64 "
+            << impl << ", resolution "
+#ifdef NS3_TIME_RESOLUTION
+            << "fixed at build time"
+#else
+            << "set at run time"
+#endif
+            << std::endl;
+
+  runBench (&benchGetSeconds, times, minIterations, "Time::GetSeconds");
+  runBench (&benchGetMicroSeconds, times, minIterations, "Time::GetMicroSeconds");
+  runBench (&benchSeconds, times, minIterations, "Seconds (double)");
+  runBench (&benchMicroSeconds, times, minIterations, "MicroSeconds (uint64_t)");
+  runBench (&benchMultiplyDouble, times, minIterations, "Time * double");
+  runBench (&benchSymbolsFemtoSeconds, times, minIterations, "symbols as FemtoSeconds");
+  runBench (&benchSymbolsInteger, times, minIterations, "symbols as Time * int64_t");
+
+  Simulator::Destroy ();
+  std::cerr << g_sum << std::endl;
+  return 0;
+}